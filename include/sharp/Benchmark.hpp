@@ -3,23 +3,28 @@
 
 #include <sharp/global>
 
+#include <sharp/BenchmarkSession.hpp>
+
 #include <iostream>
 #include <string>
-#include <mutex>
 
 namespace sharp
 {
 	class SHARP_API Benchmark
 	{
 	public:
+		// the process-wide session behind registerTimestamp() and
+		// printBenchmarks(), used by solvers without a session of their own
+		static BenchmarkSession &session();
+
 		static void registerTimestamp(const std::string &name);
+		// prints and clears the process-wide session
 		static void printBenchmarks(std::ostream &out, bool csv);
 		static void interrupt() { exit = true; }
 		static bool isInterrupt() { return exit; }
 	private:
 		Benchmark();
 		static bool exit;
-		static std::mutex lock;
 	};
 
 } // namespace sharp
@@ -0,0 +1,191 @@
+#ifndef SHARP_SHARP_BENCHMARKSESSION_H_
+#define SHARP_SHARP_BENCHMARKSESSION_H_
+
+#include <sharp/global>
+
+#include <sharp/HashStatistics.hpp>
+#include <sharp/NodeProfiler.hpp>
+#include <sharp/PerfCounters.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sharp
+{
+	// Timing of a single solve. Every thread records into its own event
+	// buffer, so registering timestamps and running timers never waits on
+	// another thread; only the first event of a thread in a session takes
+	// a lock to set up its buffer. All times are taken from monotonic
+	// nanosecond clocks.
+	//
+	// The session also owns the opt-in hash statistics, node profile and
+	// hardware counters of the solve, so that concurrent solves with
+	// their own sessions never mix their figures.
+	//
+	// events(), print(), printTrace() and clear() must not run while any
+	// thread is still recording into the session.
+	class SHARP_API BenchmarkSession
+	{
+	public:
+		enum EventType
+		{
+			TIMESTAMP,
+			TIMER
+		};
+
+		// node of events that do not belong to a single node
+		static const std::int64_t NO_NODE = -1;
+
+		struct Event
+		{
+			EventType type;
+			std::string name;
+			// static string grouping the event in traces, e.g. "join"
+			const char *category;
+			// decomposition node the event belongs to, or NO_NODE
+			std::int64_t node;
+			// number of timers of the thread enclosing the event
+			unsigned int depth;
+			// nanoseconds since the start of the session; equal for
+			// timestamps
+			std::int64_t begin;
+			std::int64_t end;
+			// CPU time of the recording thread: at the timestamp resp.
+			// spent within the timer
+			std::int64_t threadCpu;
+			// user and system CPU time of the whole process, for timestamps
+			std::int64_t user;
+			std::int64_t system;
+		};
+
+		struct ThreadEvents
+		{
+			// dense per-session thread number, in order of first event
+			unsigned int thread;
+			std::vector<Event> events;
+		};
+
+		// Measures the lifetime of the object on the calling thread.
+		// Timers of the same thread nest; print() reports them by their
+		// path of enclosing timer names.
+		class SHARP_API ScopedTimer
+		{
+		public:
+			ScopedTimer(BenchmarkSession &session, const std::string &name);
+
+			// records nothing if session is nullptr; category has to be a
+			// static string
+			ScopedTimer(
+					BenchmarkSession *session,
+					const char *category,
+					const std::string &name,
+					std::int64_t node);
+
+			~ScopedTimer();
+
+		private:
+			ScopedTimer(const ScopedTimer &) = delete;
+			ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+			void start(
+					const char *category,
+					const std::string &name,
+					std::int64_t node);
+
+			BenchmarkSession *session_;
+			std::size_t index_;
+
+		}; // class ScopedTimer
+
+		// Makes session the current session of the calling thread for the
+		// lifetime of the object, so that code without access to the
+		// solver (e.g. joins inside an algorithm) can record into it.
+		class SHARP_API Activation
+		{
+		public:
+			Activation(BenchmarkSession &session);
+			~Activation();
+
+		private:
+			Activation(const Activation &) = delete;
+			Activation &operator=(const Activation &) = delete;
+
+			BenchmarkSession *previous_;
+
+		}; // class Activation
+
+		// the current session of the calling thread, or nullptr
+		static BenchmarkSession *current();
+
+		// the current session of the calling thread if it has node timing
+		// enabled, or nullptr
+		static BenchmarkSession *currentDetailed();
+
+		BenchmarkSession();
+		~BenchmarkSession();
+
+		void registerTimestamp(const std::string &name);
+
+		// If enabled, the solvers time the evaluation of every node, with
+		// one timer per node named after its pass, and the joins time
+		// themselves. Off by default.
+		void setNodeTiming(bool enabled);
+		bool nodeTiming() const { return nodeTiming_; }
+
+		// off until enabled, like node timing
+		HashStatistics &hashStatistics() { return hashStatistics_; }
+		const HashStatistics &hashStatistics() const
+		{ return hashStatistics_; }
+		NodeProfiler &nodeProfiler() { return nodeProfiler_; }
+		const NodeProfiler &nodeProfiler() const { return nodeProfiler_; }
+		PerfCounters &perfCounters() { return perfCounters_; }
+		const PerfCounters &perfCounters() const { return perfCounters_; }
+
+		// nanoseconds since the start of the session
+		std::int64_t now() const;
+
+		std::vector<ThreadEvents> events() const;
+
+		// Prints the timestamps in the format of
+		// Benchmark::printBenchmarks(), followed by the timers and the
+		// reports of the enabled statistics.
+		void print(std::ostream &out, bool csv) const;
+
+		// Writes all events in the trace event JSON format read by
+		// Perfetto and chrome://tracing: timers as complete events with
+		// their node as argument, timestamps as instant events, and one
+		// track per thread.
+		void printTrace(std::ostream &out) const;
+
+		// drops all events and recorded statistics; settings are kept
+		void clear();
+
+	private:
+		BenchmarkSession(const BenchmarkSession &) = delete;
+		BenchmarkSession &operator=(const BenchmarkSession &) = delete;
+
+		struct Buffer;
+
+		// the event buffer of the calling thread
+		Buffer &buffer();
+
+		std::uint64_t id_;
+		std::chrono::steady_clock::time_point start_;
+		bool nodeTiming_;
+		HashStatistics hashStatistics_;
+		NodeProfiler nodeProfiler_;
+		PerfCounters perfCounters_;
+		mutable std::mutex lock_;
+		std::deque<std::unique_ptr<Buffer> > buffers_;
+
+	}; // class BenchmarkSession
+
+} // namespace sharp
+
+#endif // SHARP_SHARP_BENCHMARKSESSION_H_
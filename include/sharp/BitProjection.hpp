@@ -0,0 +1,99 @@
+#ifndef SHARP_SHARP_BITPROJECTION_H_
+#define SHARP_SHARP_BITPROJECTION_H_
+
+#include <sharp/global>
+
+#include <htd/main.hpp>
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace sharp
+{
+	// Batch kernel that maps whole tables of bit rows (as stored by BitTuple
+	// and WideBitTuple) from a source bag to a target bag. Rows are stored
+	// contiguously, sourceWordCount() resp. targetWordCount() words each.
+	//
+	// Target bit i is taken from source bit positions[i]; target bits mapped
+	// to NONE are introduced vertices. The mapping is compiled into runs of
+	// consecutive bits, so forgetting or introducing a vertex costs a handful
+	// of shift/mask operations per row that the compiler can vectorize.
+	class SHARP_API BitProjection
+	{
+	public:
+		static const std::size_t NONE = static_cast<std::size_t>(-1);
+
+		BitProjection(
+				const std::vector<std::size_t> &positions,
+				std::size_t sourceWidth);
+
+		~BitProjection();
+
+		// positions of the vertices of targetBag inside sourceBag
+		static std::vector<std::size_t> positionMap(
+				const std::vector<htd::vertex_t> &sourceBag,
+				const std::vector<htd::vertex_t> &targetBag);
+
+		std::size_t sourceWidth() const { return sourceWidth_; }
+		std::size_t targetWidth() const { return targetWidth_; }
+		std::size_t sourceWordCount() const { return sourceWords_; }
+		std::size_t targetWordCount() const { return targetWords_; }
+
+		// number of target rows that extend() produces per source row;
+		// only meaningful if extend() accepts the projection
+		std::size_t extensionFactor() const
+		{
+			return std::size_t(1) << freePositions_.size();
+		}
+
+		// forget/reorder: target bits mapped to NONE are cleared
+		void project(
+				const std::uint64_t *source,
+				std::size_t rowCount,
+				std::uint64_t *target) const;
+
+		// introduce: writes rowCount * extensionFactor() rows, block c
+		// (of rowCount rows each) assigns the bits of c to the introduced
+		// positions in increasing order; throws std::invalid_argument if
+		// there are 32 or more introduced positions
+		void extend(
+				const std::uint64_t *source,
+				std::size_t rowCount,
+				std::uint64_t *target) const;
+
+	private:
+		struct Run
+		{
+			std::size_t sourceWord;
+			std::size_t targetWord;
+			unsigned int sourceShift;
+			unsigned int targetShift;
+			std::uint64_t mask;
+		};
+
+		void projectSingleWord(
+				const std::uint64_t *source,
+				std::size_t rowCount,
+				std::uint64_t *target) const;
+
+		void projectMultiWord(
+				const std::uint64_t *source,
+				std::size_t rowCount,
+				std::uint64_t *target) const;
+
+		std::size_t sourceWidth_;
+		std::size_t targetWidth_;
+		std::size_t sourceWords_;
+		std::size_t targetWords_;
+		std::vector<Run> runs_;
+		std::vector<std::size_t> freePositions_;
+		bool monotone_;
+		std::uint64_t sourceMask_;
+		std::uint64_t targetMask_;
+
+	}; // class BitProjection
+
+} // namespace sharp
+
+#endif // SHARP_SHARP_BITPROJECTION_H_
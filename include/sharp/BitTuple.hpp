@@ -0,0 +1,65 @@
+#ifndef SHARP_SHARP_BITTUPLE_H_
+#define SHARP_SHARP_BITTUPLE_H_
+
+#include <sharp/global>
+
+#include <sharp/ITuple.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace sharp
+{
+	// Truth assignment over a bag of at most MAX_WIDTH vertices, where bit i
+	// holds the value of the i-th vertex of the bag.
+	class SHARP_API BitTuple : public ITuple
+	{
+	public:
+		static const std::size_t MAX_WIDTH = 64;
+
+		BitTuple();
+		explicit BitTuple(std::uint64_t bits);
+
+		virtual ~BitTuple() override;
+
+		std::uint64_t bits() const { return bits_; }
+
+		bool get(std::size_t position) const
+		{
+			assert(position < MAX_WIDTH);
+			return (bits_ >> position) & 1u;
+		}
+
+		void set(std::size_t position, bool value)
+		{
+			assert(position < MAX_WIDTH);
+			bits_ = (bits_ & ~(std::uint64_t(1) << position))
+				| (std::uint64_t(value) << position);
+		}
+
+		// introduce: shifts all bits at or above position up by one; the
+		// highest bit is dropped
+		void insert(std::size_t position, bool value);
+
+		// forget: shifts all bits above position down by one
+		void erase(std::size_t position);
+
+		// copies the bits of count BitTuples into a flat row array, e.g. a
+		// chunk from ITupleSet::forEachChunk() as input for BitProjection
+		static void gather(
+				const ITuple * const *tuples,
+				std::size_t count,
+				std::uint64_t *bits);
+
+		virtual std::size_t hash() const override;
+		virtual bool operator==(const ITuple &other) const override;
+
+	private:
+		std::uint64_t bits_;
+
+	}; // class BitTuple
+
+} // namespace sharp
+
+#endif // SHARP_SHARP_BITTUPLE_H_
@@ -0,0 +1,36 @@
+#ifndef SHARP_SHARP_CACHEDHASHTUPLE_H_
+#define SHARP_SHARP_CACHEDHASHTUPLE_H_
+
+#include <sharp/global>
+
+#include <sharp/ITuple.hpp>
+
+#include <cstddef>
+
+namespace sharp
+{
+	// Base class for tuples that store their hash value. Subclasses keep
+	// it up to date through setHash() whenever they change, typically by
+	// updating a ZobristHash taken over from the child tuple, so hash()
+	// is a plain load that is safe to call from several threads.
+	class SHARP_API CachedHashTuple : public ITuple
+	{
+	public:
+		virtual ~CachedHashTuple() override;
+
+		virtual std::size_t hash() const override;
+
+	protected:
+		CachedHashTuple();
+		explicit CachedHashTuple(std::size_t hash);
+
+		void setHash(std::size_t hash) { hash_ = hash; }
+
+	private:
+		std::size_t hash_;
+
+	}; // class CachedHashTuple
+
+} // namespace sharp
+
+#endif // SHARP_SHARP_CACHEDHASHTUPLE_H_
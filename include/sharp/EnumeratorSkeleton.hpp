@@ -4,11 +4,13 @@
 #if defined(SHARP_ENUM_CONST)
 	#define SHARP_ENUM_IFACE IConstEnumerator
 	#define SHARP_ENUM_NAME ConstEnumerator
+	#define SHARP_ENUM_CONCAT ConcatConstEnumerator
 	#define SHARP_ENUM_REFTYPE const T &
 	#define SHARP_ENUM_PTRTYPE const T *
 #elif defined(SHARP_ENUM_NOCONST)
 	#define SHARP_ENUM_IFACE IEnumerator
 	#define SHARP_ENUM_NAME Enumerator
+	#define SHARP_ENUM_CONCAT ConcatEnumerator
 	#define SHARP_ENUM_REFTYPE T &
 	#define SHARP_ENUM_PTRTYPE T *
 #else
@@ -20,6 +22,7 @@
 #include <iterator>
 #include <stdexcept>
 #include <typeinfo>
+#include <vector>
 #include <cstddef>
 
 namespace sharp
@@ -61,9 +64,18 @@ namespace sharp
 			}
 
 			Iterator(const Iterator &other)
-				: enumerator_(other.enumerator_->clone())
+				: enumerator_(other.enumerator_
+						? other.enumerator_->clone()
+						: nullptr)
 			{ }
 
+			// moving hands over the enumerator instead of cloning it
+			Iterator(Iterator &&other)
+				: enumerator_(other.enumerator_)
+			{
+				other.enumerator_ = nullptr;
+			}
+
 			~Iterator()
 			{
 				if(enumerator_) delete enumerator_;
@@ -71,8 +83,21 @@ namespace sharp
 
 			Iterator &operator=(const Iterator &other)
 			{
+				if(this == &other) return *this;
+				if(enumerator_) delete enumerator_;
+				enumerator_ = other.enumerator_
+					? other.enumerator_->clone()
+					: nullptr;
+				return *this;
+			}
+
+			Iterator &operator=(Iterator &&other)
+			{
+				if(this == &other) return *this;
 				if(enumerator_) delete enumerator_;
-				enumerator_ = other.enumerator_->clone();
+				enumerator_ = other.enumerator_;
+				other.enumerator_ = nullptr;
+				return *this;
 			}
 
 			bool operator==(const Iterator &other) const
@@ -130,11 +155,19 @@ namespace sharp
 
 		virtual ~SHARP_ENUM_NAME() { }
 
+		SHARP_ENUM_NAME(const SHARP_ENUM_NAME &other)
+			: SHARP_ENUM_IFACE<T>(),
+			  current_(other.current_),
+			  end_(other.end_),
+			  ended_(other.ended_)
+		{ }
+
 		SHARP_ENUM_NAME &operator=(const SHARP_ENUM_NAME &other)
 		{
 			current_ = other.current_;
 			end_ = other.end_;
 			ended_ = other.ended_;
+			return *this;
 		}
 		
 		virtual void next()
@@ -181,13 +214,100 @@ namespace sharp
 		bool ended_;
 
 		template<typename U>
-		struct retref { U &operator()(Iter i) { return *i; } };
+		struct retref
+		{
+			SHARP_ENUM_REFTYPE operator()(Iter i) { return *i; }
+		};
 
 		template<typename U>
 		struct retref<U *> { U &operator()(Iter i) { return **i; } };
 
 	}; // class SHARP_ENUM_NAME
 	
+	// Enumerates the elements of several enumerators one after the other,
+	// skipping those that are already exhausted.
+	template<typename T>
+	class SHARP_API SHARP_ENUM_CONCAT : public SHARP_ENUM_IFACE<T>
+	{
+	public:
+		SHARP_ENUM_CONCAT() : current_(0) { }
+
+		// takes ownership of the given enumerators
+		explicit SHARP_ENUM_CONCAT(
+				const std::vector<SHARP_ENUM_IFACE<T> *> &parts)
+			: parts_(parts), current_(0)
+		{
+			skip();
+		}
+
+		SHARP_ENUM_CONCAT(const SHARP_ENUM_CONCAT &other)
+			: SHARP_ENUM_IFACE<T>(), current_(other.current_)
+		{
+			parts_.reserve(other.parts_.size());
+			for(SHARP_ENUM_IFACE<T> *part : other.parts_)
+				parts_.push_back(part->clone());
+		}
+
+		virtual ~SHARP_ENUM_CONCAT()
+		{
+			for(SHARP_ENUM_IFACE<T> *part : parts_)
+				delete part;
+		}
+
+		SHARP_ENUM_CONCAT &operator=(const SHARP_ENUM_CONCAT &other)
+		{
+			if(this == &other) return *this;
+			SHARP_ENUM_CONCAT copy(other);
+			parts_.swap(copy.parts_);
+			current_ = copy.current_;
+			return *this;
+		}
+
+		virtual void next()
+		{
+			parts_[current_]->next();
+			skip();
+		}
+
+		virtual SHARP_ENUM_REFTYPE get() const
+		{
+			return parts_[current_]->get();
+		}
+
+		virtual bool valid() const
+		{
+			return current_ < parts_.size();
+		}
+
+		virtual SHARP_ENUM_IFACE<T> *clone() const
+		{
+			return new SHARP_ENUM_CONCAT<T>(*this);
+		}
+
+		virtual bool operator==(const SHARP_ENUM_IFACE<T> &other) const
+		{
+			if(typeid(other) != typeid(*this)) return false;
+
+			const SHARP_ENUM_CONCAT<T> &tmpother =
+				static_cast<const SHARP_ENUM_CONCAT<T> &>(other);
+			if(!this->valid() || !tmpother.valid())
+				return this->valid() == tmpother.valid();
+			return current_ == tmpother.current_
+				&& *parts_[current_] == *tmpother.parts_[current_];
+		}
+
+	private:
+		std::vector<SHARP_ENUM_IFACE<T> *> parts_;
+		std::size_t current_;
+
+		void skip()
+		{
+			while(current_ < parts_.size() && !parts_[current_]->valid())
+				++current_;
+		}
+
+	}; // class SHARP_ENUM_CONCAT
+
 	template<typename T>
 	inline SHARP_ENUM_IFACE<T>::~SHARP_ENUM_IFACE() { }
 
@@ -195,6 +315,7 @@ namespace sharp
 
 #undef SHARP_ENUM_IFACE
 #undef SHARP_ENUM_NAME
+#undef SHARP_ENUM_CONCAT
 #undef SHARP_ENUM_REFTYPE
 #undef SHARP_ENUM_PTRTYPE
 
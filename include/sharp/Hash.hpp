@@ -3,35 +3,95 @@
 
 #include <sharp/global>
 
+#include <sharp/MultisetHash.hpp>
+
 #include <cstddef>
 #include <cstdint>
 
 namespace sharp
 {
+	// Incremental hash. Words are mixed in one multiply per add() (FxHash
+	// style), single bytes use FNV-1a; get() applies a final avalanche so
+	// that all bits of the result depend on all input bits.
 	class SHARP_API Hash
 	{
 	public:
 		Hash();
 		~Hash();
 
-		void add(std::uint_least32_t data);
-		void add(size_t data);
-		void add(unsigned char data);
+		void add(std::uint_least32_t data)
+		{
+			state_ = mix(state_, data);
+		}
+
+		void add(size_t data)
+		{
+			state_ = mix(state_, data);
+		}
+
+		void add(unsigned char data)
+		{
+			state_ = (state_ ^ data) * FNV_PRIME;
+		}
+
+		// adds size bytes, eight at a time, followed by the byte count
+		void add(const void *data, std::size_t size);
+
 		void reset();
 
-		void addUnordered(std::uint_least32_t data);
-		void addUnordered(size_t data);
-		void addUnordered(unsigned char data);
+		// unordered elements are collected in a MultisetHash until
+		// incorporateUnordered() adds its value to this hash
+		void addUnordered(std::uint_least32_t data) { unordered_.add(data); }
+		void addUnordered(size_t data) { unordered_.add(data); }
+		void addUnordered(unsigned char data) { unordered_.add(data); }
+		void addUnordered(const MultisetHash &set) { unordered_ += set; }
 		void incorporateUnordered();
 		void resetUnordered();
 
-		size_t get() const;
-		size_t getUnordered(); //const;
+		size_t get() const
+		{
+			return static_cast<size_t>(finalize(state_));
+		}
+
+		size_t getUnordered() const
+		{
+			return unordered_.get();
+		}
+
+		// Hashes rowCount rows of wordCount words each, stored contiguously
+		// (as in BitProjection), into hashes. Row r gets the same value as
+		// add(rows + r * wordCount, wordCount * 8) on a fresh Hash. Rows are
+		// processed in independent lanes, so the loop vectorizes.
+		static void hashRows(
+				const std::uint64_t *rows,
+				std::size_t wordCount,
+				std::size_t rowCount,
+				std::size_t *hashes);
+
+		static std::uint64_t mix(std::uint64_t state, std::uint64_t word)
+		{
+			return (((state << 5) | (state >> 59)) ^ word) * MIX_FACTOR;
+		}
+
+		static std::uint64_t finalize(std::uint64_t state)
+		{
+			state ^= state >> 33;
+			state *= UINT64_C(0xFF51AFD7ED558CCD);
+			state ^= state >> 33;
+			state *= UINT64_C(0xC4CEB9FE1A85EC53);
+			state ^= state >> 33;
+			return state;
+		}
 
 	private:
-		size_t hash_;
-		size_t unorderedXor_;
-		size_t unorderedSum_;
+		static const std::uint64_t FNV_OFFSET =
+			UINT64_C(14695981039346656037);
+		static const std::uint64_t FNV_PRIME = UINT64_C(1099511628211);
+		static const std::uint64_t MIX_FACTOR =
+			UINT64_C(0x9E3779B97F4A7C15);
+
+		std::uint64_t state_;
+		MultisetHash unordered_;
 
 	}; // class Hash
 
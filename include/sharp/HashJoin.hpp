@@ -0,0 +1,61 @@
+#ifndef SHARP_SHARP_HASHJOIN_H_
+#define SHARP_SHARP_HASHJOIN_H_
+
+#include <sharp/global>
+
+#include <sharp/ITuple.hpp>
+#include <sharp/ITupleSet.hpp>
+
+#include <functional>
+#include <vector>
+#include <cstddef>
+
+namespace sharp
+{
+	// Join operator for the child tuple sets of a join node. Tuples match if
+	// their projections onto the join node's bag are equal; KeyHash and
+	// KeyEqual have to hash resp. compare exactly this projection.
+	//
+	// The smaller input is indexed by hash and the larger one probes the
+	// index. With more than one thread, both inputs are radix-partitioned by
+	// hash and the partitions are joined concurrently, in which case the
+	// combine callback must be safe to call from several threads at once.
+	class SHARP_API HashJoin
+	{
+	public:
+		typedef std::function<std::size_t(const ITuple &)> KeyHash;
+		typedef std::function<bool(const ITuple &, const ITuple &)> KeyEqual;
+		typedef std::function<void(const ITuple &, const ITuple &)>
+			PairCallback;
+		typedef std::function<void(const std::vector<const ITuple *> &)>
+			TupleCallback;
+
+		HashJoin(const KeyHash &hash, const KeyEqual &equal);
+		~HashJoin();
+
+		void setThreadCount(unsigned int threadCount);
+		unsigned int threadCount() const;
+
+		// calls combine(l, r) for every matching l in left and r in right
+		void join(
+				const ITupleSet &left,
+				const ITupleSet &right,
+				const PairCallback &combine) const;
+
+		// calls combine once for every combination of matching tuples, one
+		// from each child, passed in the order of the children (joined by
+		// a MultiwayJoin)
+		void join(
+				const std::vector<const ITupleSet *> &children,
+				const TupleCallback &combine) const;
+
+	private:
+		KeyHash hash_;
+		KeyEqual equal_;
+		unsigned int threadCount_;
+
+	}; // class HashJoin
+
+} // namespace sharp
+
+#endif // SHARP_SHARP_HASHJOIN_H_
@@ -0,0 +1,86 @@
+#ifndef SHARP_SHARP_HASHSTATISTICS_H_
+#define SHARP_SHARP_HASHSTATISTICS_H_
+
+#include <sharp/global>
+
+#include <sharp/ITupleSet.hpp>
+
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace sharp
+{
+	// Opt-in collection of hash quality figures for sharp's hashed
+	// containers, owned by a BenchmarkSession. When enabled, the solvers
+	// record the tuple set of every node and their node table map, and the
+	// hash join records its index into the current session;
+	// BenchmarkSession::print() appends the report.
+	class SHARP_API HashStatistics
+	{
+	public:
+		struct Entry
+		{
+			std::string name;
+			std::size_t elements;
+			// number of different hash values among the elements
+			std::size_t distinctHashes;
+			// unequal elements sharing their full hash value with an
+			// earlier element
+			std::size_t collisions;
+			std::size_t buckets;
+			std::size_t occupiedBuckets;
+			std::size_t maxProbeLength;
+			// expected chain entries inspected by a successful lookup
+			double meanProbeLength;
+
+			double loadFactor() const;
+			double distinctRatio() const;
+		};
+
+		HashStatistics();
+
+		void enable(bool enabled);
+		bool enabled() const { return enabled_; }
+
+		void record(const Entry &entry);
+
+		// Analyzes a set as if it was stored in a chained hash table with
+		// bucketCount buckets (0 picks the next power of two >= size).
+		static Entry analyze(
+				const std::string &name,
+				const ITupleSet &tuples,
+				std::size_t bucketCount = 0);
+
+		// Same for bare hash values, e.g. computed with Hash::hashRows().
+		// Equal values are counted as collisions.
+		static Entry analyze(
+				const std::string &name,
+				const std::vector<std::size_t> &hashes,
+				std::size_t bucketCount = 0);
+
+		// Fills in the bucket figures of entry from the chain lengths.
+		static void analyzeBuckets(
+				Entry &entry,
+				const std::vector<std::size_t> &bucketSizes);
+
+		std::vector<Entry> entries() const;
+		void print(std::ostream &out, bool csv) const;
+		void clear();
+
+	private:
+		HashStatistics(const HashStatistics &) = delete;
+		HashStatistics &operator=(const HashStatistics &) = delete;
+
+		std::atomic<bool> enabled_;
+		mutable std::mutex lock_;
+		std::vector<Entry> entries_;
+
+	}; // class HashStatistics
+
+} // namespace sharp
+
+#endif // SHARP_SHARP_HASHSTATISTICS_H_
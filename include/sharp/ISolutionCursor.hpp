@@ -0,0 +1,34 @@
+#ifndef SHARP_SHARP_ISOLUTIONCURSOR_H_
+#define SHARP_SHARP_ISOLUTIONCURSOR_H_
+
+#include <sharp/global>
+
+#include <sharp/ISolution.hpp>
+
+#include <cstddef>
+
+namespace sharp
+{
+	// Yields solutions one at a time (see ITreeSolver::enumerate).
+	// Enumeration can be stopped at any point by deleting the cursor.
+	class SHARP_API ISolutionCursor
+	{
+	protected:
+		ISolutionCursor &operator=(ISolutionCursor &) { return *this; };
+
+	public:
+		virtual ~ISolutionCursor() = 0;
+
+		// the next solution, owned by the caller, or nullptr at the end
+		virtual ISolution *next() = 0;
+
+		// passes over at most count solutions without constructing them,
+		// returns the number actually skipped
+		virtual std::size_t skip(std::size_t count) = 0;
+
+	}; // class ISolutionCursor
+
+	inline ISolutionCursor::~ISolutionCursor() { }
+} // namespace sharp
+
+#endif // SHARP_SHARP_ISOLUTIONCURSOR_H_
@@ -0,0 +1,40 @@
+#ifndef SHARP_SHARP_ITABLECOMBINER_H_
+#define SHARP_SHARP_ITABLECOMBINER_H_
+
+#include <sharp/global>
+
+#include <sharp/ITable.hpp>
+#include <sharp/INodeTableMap.hpp>
+#include <sharp/IInstance.hpp>
+
+#include <htd/main.hpp>
+
+#include <vector>
+
+namespace sharp
+{
+	// Merges the tables that independent algorithms computed concurrently
+	// for the same node (see create::treeAlgorithm) into the node's table.
+	class SHARP_API ITableCombiner
+	{
+	protected:
+		ITableCombiner &operator=(ITableCombiner &) { return *this; };
+
+	public:
+		virtual ~ITableCombiner() = 0;
+
+		// outputs holds one table per algorithm, in the order of the
+		// algorithms; the combiner takes ownership of all of them
+		virtual ITable *combine(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				const INodeTableMap &tables,
+				const IInstance &instance,
+				const std::vector<ITable *> &outputs) const = 0;
+
+	}; // class ITableCombiner
+
+	inline ITableCombiner::~ITableCombiner() { }
+} // namespace sharp
+
+#endif // SHARP_SHARP_ITABLECOMBINER_H_
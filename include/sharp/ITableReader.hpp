@@ -0,0 +1,36 @@
+#ifndef SHARP_SHARP_ITABLEREADER_H_
+#define SHARP_SHARP_ITABLEREADER_H_
+
+#include <sharp/global>
+
+#include <htd/main.hpp>
+
+namespace sharp
+{
+	// Optional interface for tree (tuple) algorithms and solution
+	// extractors that declares which node tables they read, so that the
+	// solver can free every table right after its last consumer instead
+	// of keeping all of them (needAllTables()).
+	//
+	// A table is always available while its parent is being evaluated;
+	// readsTable() only has to report reads beyond that, i.e. reads of the
+	// table of node by the evaluation of any node other than its parent,
+	// by any later pass, or by the extractor.
+	class SHARP_API ITableReader
+	{
+	protected:
+		ITableReader &operator=(ITableReader &) { return *this; };
+
+	public:
+		virtual ~ITableReader() = 0;
+
+		virtual bool readsTable(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition) const = 0;
+
+	}; // class ITableReader
+
+	inline ITableReader::~ITableReader() { }
+} // namespace sharp
+
+#endif // SHARP_SHARP_ITABLEREADER_H_
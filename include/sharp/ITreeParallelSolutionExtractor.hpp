@@ -0,0 +1,59 @@
+#ifndef SHARP_SHARP_ITREEPARALLELSOLUTIONEXTRACTOR_H_
+#define SHARP_SHARP_ITREEPARALLELSOLUTIONEXTRACTOR_H_
+
+#include <sharp/global>
+
+#include <sharp/ISolution.hpp>
+#include <sharp/INodeTableMap.hpp>
+#include <sharp/IInstance.hpp>
+
+#include <htd/main.hpp>
+
+#include <vector>
+
+namespace sharp
+{
+	// Optional interface for tree solution extractors that reconstruct
+	// solutions node by node. The solver calls it instead of
+	// extractSolution: extractNode runs from the root to the leaves, then
+	// combine merges the parts from the leaves back to the root. A node is
+	// extracted as soon as its parent is, and combined as soon as all its
+	// children are, so both functions must be safe to call from several
+	// threads at once, for any nodes in any subtrees.
+	class SHARP_API ITreeParallelSolutionExtractor
+	{
+	protected:
+		ITreeParallelSolutionExtractor &operator=(
+				ITreeParallelSolutionExtractor &)
+		{ return *this; };
+
+	public:
+		virtual ~ITreeParallelSolutionExtractor() = 0;
+
+		// the part of the solution at node, given the part chosen at its
+		// parent (nullptr at the root)
+		virtual ISolution *extractNode(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				const INodeTableMap &tables,
+				const ISolution *parentPart,
+				const IInstance &instance) const = 0;
+
+		// merges the part of node with the merged results of its children,
+		// in the order of the children; takes ownership of all of them once
+		// it returns, and must not delete any of them if it throws
+		virtual ISolution *combine(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				const INodeTableMap &tables,
+				ISolution *nodePart,
+				const std::vector<ISolution *> &childResults,
+				const IInstance &instance) const = 0;
+
+	}; // class ITreeParallelSolutionExtractor
+
+	inline ITreeParallelSolutionExtractor::~ITreeParallelSolutionExtractor()
+	{ }
+} // namespace sharp
+
+#endif // SHARP_SHARP_ITREEPARALLELSOLUTIONEXTRACTOR_H_
@@ -0,0 +1,43 @@
+#ifndef SHARP_SHARP_ITREESOLUTIONENUMERATOR_H_
+#define SHARP_SHARP_ITREESOLUTIONENUMERATOR_H_
+
+#include <sharp/global>
+
+#include <sharp/ISolutionCursor.hpp>
+#include <sharp/INodeTableMap.hpp>
+#include <sharp/IInstance.hpp>
+
+#include <htd/main.hpp>
+
+namespace sharp
+{
+	// Optional interface for tree solution extractors that can produce
+	// their solutions one at a time. Extractors without it are enumerated
+	// as the single solution returned by extractSolution.
+	//
+	// Enumerators only see the tables of the bottom-up pass, never those
+	// of a top-down pass. An extractor that needs the top-down tables
+	// (ITreeTopDownSolutionExtractor) must not implement this interface;
+	// it is then enumerated as its single top-down solution.
+	class SHARP_API ITreeSolutionEnumerator
+	{
+	protected:
+		ITreeSolutionEnumerator &operator=(ITreeSolutionEnumerator &)
+		{ return *this; };
+
+	public:
+		virtual ~ITreeSolutionEnumerator() = 0;
+
+		// tables stay valid until the returned cursor is deleted
+		virtual ISolutionCursor *enumerateSolutions(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				const INodeTableMap &tables,
+				const IInstance &instance) const = 0;
+
+	}; // class ITreeSolutionEnumerator
+
+	inline ITreeSolutionEnumerator::~ITreeSolutionEnumerator() { }
+} // namespace sharp
+
+#endif // SHARP_SHARP_ITREESOLUTIONENUMERATOR_H_
@@ -3,7 +3,9 @@
 
 #include <sharp/global>
 
+#include <sharp/BenchmarkSession.hpp>
 #include <sharp/ISolver.hpp>
+#include <sharp/ISolutionCursor.hpp>
 
 #include <htd/main.hpp>
 
@@ -20,10 +22,35 @@ namespace sharp
 		virtual htd::ITreeDecomposition *decompose(
 				const IInstance &instance, bool weak, unsigned int maxChild, bool optimizeTD) const = 0;
 
+		using ISolver::solve;
+
 		virtual ISolution *solve(
 				const IInstance &instance,
 				const htd::ITreeDecomposition &decomposition) const = 0;
 
+		// Yields the solutions one at a time. The cursor keeps the node
+		// tables alive until it is deleted; decomposition has to outlive it.
+		// If the evaluation fails or is interrupted, the cursor yields the
+		// single empty solution that solve() returns in that case. By
+		// default, the cursor yields the result of solve() as its only
+		// solution.
+		virtual ISolutionCursor *enumerate(
+				const IInstance &instance,
+				const htd::ITreeDecomposition &decomposition) const;
+
+		virtual ISolutionCursor *enumerate(
+				const IInstance &instance) const;
+
+		// Upper bound for the threads used by a single pass. Solvers that
+		// evaluate sequentially ignore it.
+		virtual void setThreadCount(unsigned int) { }
+
+		// Records the timing of later solves into session instead of
+		// Benchmark::session(); nullptr restores the default. The session
+		// has to outlive every solve and cursor started while it is set.
+		// Solvers that do not time their work ignore it.
+		virtual void setBenchmarkSession(BenchmarkSession *) { }
+
 	}; // class ITreeSolver
 
 	inline ITreeSolver::~ITreeSolver() { }
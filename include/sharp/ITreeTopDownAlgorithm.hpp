@@ -0,0 +1,54 @@
+#ifndef SHARP_SHARP_ITREETOPDOWNALGORITHM_H_
+#define SHARP_SHARP_ITREETOPDOWNALGORITHM_H_
+
+#include <sharp/global>
+
+#include <sharp/ITable.hpp>
+#include <sharp/INodeTableMap.hpp>
+#include <sharp/IInstance.hpp>
+
+#include <htd/main.hpp>
+
+#include <vector>
+
+namespace sharp
+{
+	class ITreeTopDownAlgorithm;
+
+	typedef std::vector<const ITreeTopDownAlgorithm *>
+		TreeTopDownAlgorithmVector;
+
+	// Pass that runs from the root to the leaves after all bottom-up
+	// passes. A node is evaluated as soon as its parent is, concurrently
+	// with any other ready node, so evaluateNode must be safe to call from
+	// several threads at once.
+	class SHARP_API ITreeTopDownAlgorithm
+	{
+	protected:
+		ITreeTopDownAlgorithm &operator=(ITreeTopDownAlgorithm &)
+		{ return *this; };
+
+	public:
+		virtual ~ITreeTopDownAlgorithm() = 0;
+
+		// bottomUpTables holds the tables the bottom-up passes retained,
+		// topDownTables the top-down table of the parent of node (of every
+		// ancestor if needAllTables()); tables of other nodes of the pass
+		// are not visible
+		virtual ITable *evaluateNode(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				const INodeTableMap &bottomUpTables,
+				const INodeTableMap &topDownTables,
+				const IInstance &instance) const = 0;
+
+		// if false, the top-down table of a node is dropped as soon as its
+		// children have been evaluated; tables of leaves are kept
+		virtual bool needAllTables() const = 0;
+
+	}; // class ITreeTopDownAlgorithm
+
+	inline ITreeTopDownAlgorithm::~ITreeTopDownAlgorithm() { }
+} // namespace sharp
+
+#endif // SHARP_SHARP_ITREETOPDOWNALGORITHM_H_
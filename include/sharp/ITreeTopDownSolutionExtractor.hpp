@@ -0,0 +1,39 @@
+#ifndef SHARP_SHARP_ITREETOPDOWNSOLUTIONEXTRACTOR_H_
+#define SHARP_SHARP_ITREETOPDOWNSOLUTIONEXTRACTOR_H_
+
+#include <sharp/global>
+
+#include <sharp/ISolution.hpp>
+#include <sharp/INodeTableMap.hpp>
+#include <sharp/IInstance.hpp>
+
+#include <htd/main.hpp>
+
+namespace sharp
+{
+	// Optional interface for tree solution extractors. If the solver ran
+	// top-down passes, it calls this overload instead of
+	// ITreeSolutionExtractor::extractSolution.
+	class SHARP_API ITreeTopDownSolutionExtractor
+	{
+	protected:
+		ITreeTopDownSolutionExtractor &operator=(
+				ITreeTopDownSolutionExtractor &)
+		{ return *this; };
+
+	public:
+		virtual ~ITreeTopDownSolutionExtractor() = 0;
+
+		virtual ISolution *extractSolution(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				const INodeTableMap &bottomUpTables,
+				const INodeTableMap &topDownTables,
+				const IInstance &instance) const = 0;
+
+	}; // class ITreeTopDownSolutionExtractor
+
+	inline ITreeTopDownSolutionExtractor::~ITreeTopDownSolutionExtractor() { }
+} // namespace sharp
+
+#endif // SHARP_SHARP_ITREETOPDOWNSOLUTIONEXTRACTOR_H_
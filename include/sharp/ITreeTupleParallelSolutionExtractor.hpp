@@ -0,0 +1,48 @@
+#ifndef SHARP_SHARP_ITREETUPLEPARALLELSOLUTIONEXTRACTOR_H_
+#define SHARP_SHARP_ITREETUPLEPARALLELSOLUTIONEXTRACTOR_H_
+
+#include <sharp/global>
+
+#include <sharp/ISolution.hpp>
+#include <sharp/INodeTupleSetMap.hpp>
+#include <sharp/IInstance.hpp>
+
+#include <htd/main.hpp>
+
+#include <vector>
+
+namespace sharp
+{
+	// Tuple set version of ITreeParallelSolutionExtractor.
+	class SHARP_API ITreeTupleParallelSolutionExtractor
+	{
+	protected:
+		ITreeTupleParallelSolutionExtractor &operator=(
+				ITreeTupleParallelSolutionExtractor &)
+		{ return *this; };
+
+	public:
+		virtual ~ITreeTupleParallelSolutionExtractor() = 0;
+
+		virtual ISolution *extractNode(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				const INodeTupleSetMap &tuples,
+				const ISolution *parentPart,
+				const IInstance &instance) const = 0;
+
+		virtual ISolution *combine(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				const INodeTupleSetMap &tuples,
+				ISolution *nodePart,
+				const std::vector<ISolution *> &childResults,
+				const IInstance &instance) const = 0;
+
+	}; // class ITreeTupleParallelSolutionExtractor
+
+	inline ITreeTupleParallelSolutionExtractor::
+		~ITreeTupleParallelSolutionExtractor() { }
+} // namespace sharp
+
+#endif // SHARP_SHARP_ITREETUPLEPARALLELSOLUTIONEXTRACTOR_H_
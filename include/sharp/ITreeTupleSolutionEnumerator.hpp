@@ -0,0 +1,36 @@
+#ifndef SHARP_SHARP_ITREETUPLESOLUTIONENUMERATOR_H_
+#define SHARP_SHARP_ITREETUPLESOLUTIONENUMERATOR_H_
+
+#include <sharp/global>
+
+#include <sharp/ISolutionCursor.hpp>
+#include <sharp/INodeTupleSetMap.hpp>
+#include <sharp/IInstance.hpp>
+
+#include <htd/main.hpp>
+
+namespace sharp
+{
+	// Tuple set version of ITreeSolutionEnumerator; like it, it only sees
+	// the tuples of the bottom-up pass.
+	class SHARP_API ITreeTupleSolutionEnumerator
+	{
+	protected:
+		ITreeTupleSolutionEnumerator &operator=(ITreeTupleSolutionEnumerator &)
+		{ return *this; };
+
+	public:
+		virtual ~ITreeTupleSolutionEnumerator() = 0;
+
+		virtual ISolutionCursor *enumerateSolutions(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				const INodeTupleSetMap &tuples,
+				const IInstance &instance) const = 0;
+
+	}; // class ITreeTupleSolutionEnumerator
+
+	inline ITreeTupleSolutionEnumerator::~ITreeTupleSolutionEnumerator() { }
+} // namespace sharp
+
+#endif // SHARP_SHARP_ITREETUPLESOLUTIONENUMERATOR_H_
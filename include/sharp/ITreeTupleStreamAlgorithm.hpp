@@ -0,0 +1,54 @@
+#ifndef SHARP_SHARP_ITREETUPLESTREAMALGORITHM_H_
+#define SHARP_SHARP_ITREETUPLESTREAMALGORITHM_H_
+
+#include <sharp/global>
+
+#include <sharp/ITuple.hpp>
+#include <sharp/ITupleSet.hpp>
+#include <sharp/INodeTupleSetMap.hpp>
+#include <sharp/IInstance.hpp>
+
+#include <htd/main.hpp>
+
+namespace sharp
+{
+	// Second stage of a streaming interleaved algorithm (see
+	// create::treeTupleAlgorithm). Instead of reading the complete output
+	// of the first algorithm from the tuple set map, it receives each
+	// tuple as soon as the first algorithm emits it, so the intermediate
+	// table of a node is never materialized.
+	class SHARP_API ITreeTupleStreamAlgorithm
+	{
+	protected:
+		ITreeTupleStreamAlgorithm &operator=(ITreeTupleStreamAlgorithm &)
+		{ return *this; };
+
+	public:
+		virtual ~ITreeTupleStreamAlgorithm() = 0;
+
+		// Takes ownership of tuple: it must either be inserted into
+		// outputTuples or deleted.
+		virtual void evaluateTuple(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				INodeTupleSetMap &tuples,
+				const IInstance &instance,
+				ITuple *tuple,
+				ITupleSet &outputTuples) const = 0;
+
+		// called after the first algorithm has emitted all tuples of node
+		virtual void finishNode(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				INodeTupleSetMap &tuples,
+				const IInstance &instance,
+				ITupleSet &outputTuples) const = 0;
+
+		virtual bool needAllTupleSets() const = 0;
+
+	}; // class ITreeTupleStreamAlgorithm
+
+	inline ITreeTupleStreamAlgorithm::~ITreeTupleStreamAlgorithm() { }
+} // namespace sharp
+
+#endif // SHARP_SHARP_ITREETUPLESTREAMALGORITHM_H_
@@ -0,0 +1,46 @@
+#ifndef SHARP_SHARP_ITREETUPLETOPDOWNALGORITHM_H_
+#define SHARP_SHARP_ITREETUPLETOPDOWNALGORITHM_H_
+
+#include <sharp/global>
+
+#include <sharp/ITupleSet.hpp>
+#include <sharp/INodeTupleSetMap.hpp>
+#include <sharp/IInstance.hpp>
+
+#include <htd/main.hpp>
+
+#include <vector>
+
+namespace sharp
+{
+	class ITreeTupleTopDownAlgorithm;
+
+	typedef std::vector<const ITreeTupleTopDownAlgorithm *>
+		TreeTupleTopDownAlgorithmVector;
+
+	// Tuple set version of ITreeTopDownAlgorithm.
+	class SHARP_API ITreeTupleTopDownAlgorithm
+	{
+	protected:
+		ITreeTupleTopDownAlgorithm &operator=(ITreeTupleTopDownAlgorithm &)
+		{ return *this; };
+
+	public:
+		virtual ~ITreeTupleTopDownAlgorithm() = 0;
+
+		virtual void evaluateNode(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				const INodeTupleSetMap &bottomUpTuples,
+				const INodeTupleSetMap &topDownTuples,
+				const IInstance &instance,
+				ITupleSet &outputTuples) const = 0;
+
+		virtual bool needAllTupleSets() const = 0;
+
+	}; // class ITreeTupleTopDownAlgorithm
+
+	inline ITreeTupleTopDownAlgorithm::~ITreeTupleTopDownAlgorithm() { }
+} // namespace sharp
+
+#endif // SHARP_SHARP_ITREETUPLETOPDOWNALGORITHM_H_
@@ -0,0 +1,38 @@
+#ifndef SHARP_SHARP_ITREETUPLETOPDOWNSOLUTIONEXTRACTOR_H_
+#define SHARP_SHARP_ITREETUPLETOPDOWNSOLUTIONEXTRACTOR_H_
+
+#include <sharp/global>
+
+#include <sharp/ISolution.hpp>
+#include <sharp/INodeTupleSetMap.hpp>
+#include <sharp/IInstance.hpp>
+
+#include <htd/main.hpp>
+
+namespace sharp
+{
+	// Tuple set version of ITreeTopDownSolutionExtractor.
+	class SHARP_API ITreeTupleTopDownSolutionExtractor
+	{
+	protected:
+		ITreeTupleTopDownSolutionExtractor &operator=(
+				ITreeTupleTopDownSolutionExtractor &)
+		{ return *this; };
+
+	public:
+		virtual ~ITreeTupleTopDownSolutionExtractor() = 0;
+
+		virtual ISolution *extractSolution(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				const INodeTupleSetMap &bottomUpTuples,
+				const INodeTupleSetMap &topDownTuples,
+				const IInstance &instance) const = 0;
+
+	}; // class ITreeTupleTopDownSolutionExtractor
+
+	inline ITreeTupleTopDownSolutionExtractor::
+		~ITreeTupleTopDownSolutionExtractor() { }
+} // namespace sharp
+
+#endif // SHARP_SHARP_ITREETUPLETOPDOWNSOLUTIONEXTRACTOR_H_
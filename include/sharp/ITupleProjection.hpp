@@ -0,0 +1,51 @@
+#ifndef SHARP_SHARP_ITUPLEPROJECTION_H_
+#define SHARP_SHARP_ITUPLEPROJECTION_H_
+
+#include <sharp/global>
+
+#include <sharp/ITuple.hpp>
+
+#include <htd/main.hpp>
+
+#include <cstddef>
+
+namespace sharp
+{
+	// Optional interface for tuple solution extractors. If the extractor
+	// implements it, the solver runs a semi-join reduction after the last
+	// bottom-up pass: from the root downwards, every tuple without a
+	// matching tuple in its parent node is removed, so that extraction only
+	// visits tuples that extend to a tuple at the root.
+	//
+	// A tuple of node and a tuple of a neighbouring node match iff their
+	// projections onto the vertices both bags have in common are equal.
+	class SHARP_API ITupleProjection
+	{
+	protected:
+		ITupleProjection &operator=(ITupleProjection &) { return *this; };
+
+	public:
+		virtual ~ITupleProjection() = 0;
+
+		// hash of the projection of tuple (a tuple of node) onto the
+		// vertices node shares with neighbour; matching tuples of node and
+		// neighbour must get the same hash
+		virtual std::size_t projectionHash(
+				htd::vertex_t node,
+				htd::vertex_t neighbour,
+				const ITuple &tuple,
+				const htd::ITreeDecomposition &decomposition) const = 0;
+
+		virtual bool projectionsEqual(
+				htd::vertex_t node1,
+				const ITuple &tuple1,
+				htd::vertex_t node2,
+				const ITuple &tuple2,
+				const htd::ITreeDecomposition &decomposition) const = 0;
+
+	}; // class ITupleProjection
+
+	inline ITupleProjection::~ITupleProjection() { }
+} // namespace sharp
+
+#endif // SHARP_SHARP_ITUPLEPROJECTION_H_
@@ -7,9 +7,15 @@
 #include <sharp/ITuple.hpp>
 #include <sharp/Enumerator.hpp>
 #include <sharp/ConstEnumerator.hpp>
+#include <sharp/TupleRange.hpp>
 
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
 #include <utility>
+#include <vector>
 #include <cstddef>
+#include <cstdint>
 
 namespace sharp
 {
@@ -32,6 +38,12 @@ namespace sharp
  		virtual ITuple* operator[](int pos)=0;
 
 		virtual std::pair<iterator, bool> insert(ITuple *tuple) = 0;
+
+		// Both overloads move other tuples: erasing a position shifts the
+		// later tuples down, erasing a tuple moves the last tuple into its
+		// place. Provenance links of a parent that point into this set do
+		// not follow, so do not erase from a set once a parent links into
+		// it; compact it with retain() and remap the parent instead.
 		virtual size_type erase(const ITuple &tuple) = 0;
 		virtual void erase(const size_t pos) = 0;
 		virtual IEnumerator<ITuple> *enumerate() = 0;
@@ -46,6 +58,180 @@ namespace sharp
 		virtual const_iterator end() const = 0;
 		virtual const_iterator find(const ITuple &tuple) const = 0;
 
+		// Keeps the tuple at position i (in enumeration order) iff keep[i]
+		// and deletes all others. The remaining tuples keep their order.
+		// Throws std::logic_error unless the implementation supports it.
+		virtual void retain(const std::vector<bool> &)
+		{
+			throw std::logic_error("Tuple set does not support retain.");
+		}
+
+		// Provenance links: for the tuple at position pos, the position of
+		// the tuple of the child at childPosition it was derived from.
+		// Links are kept in side arrays next to the tuples and follow them
+		// through erase and retain; unset links read as NO_ORIGIN.
+		// Implementations without links read every link as NO_ORIGIN and
+		// throw std::logic_error when one is set or remapped.
+		static const std::uint32_t NO_ORIGIN = 0xFFFFFFFFu;
+
+		virtual void setOrigin(size_type, size_type, std::uint32_t)
+		{
+			throw std::logic_error("Tuple set does not support origins.");
+		}
+
+		virtual std::uint32_t origin(size_type, size_type) const
+		{
+			return NO_ORIGIN;
+		}
+
+		virtual bool hasOrigins() const { return false; }
+
+		// Rewrites the links into the child at childPosition after that
+		// child has been compacted: link i becomes newPositions[i], e.g.
+		// retainedPositions() of the keep flags passed to the child.
+		virtual void remapOrigins(
+				size_type,
+				const std::vector<std::uint32_t> &)
+		{
+			throw std::logic_error("Tuple set does not support origins.");
+		}
+
+		// New position of every tuple after retain(keep), or NO_ORIGIN for
+		// the tuples it deletes.
+		static std::vector<std::uint32_t> retainedPositions(
+				const std::vector<bool> &keep)
+		{
+			std::vector<std::uint32_t> positions(keep.size());
+			std::uint32_t next = 0;
+			for(size_type i = 0; i < keep.size(); ++i)
+				positions[i] = keep[i] ? next++ : NO_ORIGIN;
+			return positions;
+		}
+
+		// Contiguous storage of the size() tuple pointers, or nullptr if the
+		// implementation does not keep them in a single array.
+		virtual ITuple * const *data() { return nullptr; }
+		virtual const ITuple * const *data() const { return nullptr; }
+
+		// Calls f(tuple) for every tuple. Over contiguous storage this is a
+		// plain loop that neither allocates enumerators nor makes virtual
+		// calls, and f is inlined.
+		template<typename F>
+		void forEach(F f)
+		{
+			if(ITuple * const *tuples = this->data())
+			{
+				for(size_type i = 0, n = this->size(); i < n; ++i)
+					f(*tuples[i]);
+				return;
+			}
+
+			for(ITuple &tuple : *this)
+				f(tuple);
+		}
+
+		template<typename F>
+		void forEach(F f) const
+		{
+			if(const ITuple * const *tuples = this->data())
+			{
+				for(size_type i = 0, n = this->size(); i < n; ++i)
+					f(*tuples[i]);
+				return;
+			}
+
+			for(const ITuple &tuple : *this)
+				f(tuple);
+		}
+
+		// 512 tuple pointers take up 4 KiB, which leaves room in L1 for the
+		// data the algorithm touches per tuple
+		static const size_type DEFAULT_CHUNK_SIZE = 512;
+
+		// Calls f(tuples, count) for consecutive chunks of at most chunkSize
+		// tuples. Contiguous storage is handed out in place, otherwise the
+		// pointers are collected into a single reused buffer. Throws
+		// std::invalid_argument if chunkSize is 0.
+		template<typename F>
+		void forEachChunk(F f, size_type chunkSize = DEFAULT_CHUNK_SIZE)
+		{
+			if(chunkSize == 0)
+				throw std::invalid_argument("Chunk size must not be 0.");
+
+			if(ITuple * const *tuples = this->data())
+			{
+				for(size_type i = 0, n = this->size(); i < n; i += chunkSize)
+					f(tuples + i, std::min(chunkSize, n - i));
+				return;
+			}
+
+			std::vector<ITuple *> buffer;
+			buffer.reserve(chunkSize);
+			for(ITuple &tuple : *this)
+			{
+				buffer.push_back(&tuple);
+				if(buffer.size() == chunkSize)
+				{
+					f(&buffer[0], buffer.size());
+					buffer.clear();
+				}
+			}
+			if(!buffer.empty())
+				f(&buffer[0], buffer.size());
+		}
+
+		template<typename F>
+		void forEachChunk(F f, size_type chunkSize = DEFAULT_CHUNK_SIZE) const
+		{
+			if(chunkSize == 0)
+				throw std::invalid_argument("Chunk size must not be 0.");
+
+			if(const ITuple * const *tuples = this->data())
+			{
+				for(size_type i = 0, n = this->size(); i < n; i += chunkSize)
+					f(tuples + i, std::min(chunkSize, n - i));
+				return;
+			}
+
+			std::vector<const ITuple *> buffer;
+			buffer.reserve(chunkSize);
+			for(const ITuple &tuple : *this)
+			{
+				buffer.push_back(&tuple);
+				if(buffer.size() == chunkSize)
+				{
+					f(&buffer[0], buffer.size());
+					buffer.clear();
+				}
+			}
+			if(!buffer.empty())
+				f(&buffer[0], buffer.size());
+		}
+
+		// Random access view of all tuples. Contiguous storage is viewed in
+		// place, otherwise the tuple pointers are gathered once.
+		TupleRange range() const
+		{
+			if(const ITuple * const *tuples = this->data())
+				return TupleRange(tuples, this->size());
+
+			std::shared_ptr<TupleRange::Storage> storage =
+				std::make_shared<TupleRange::Storage>();
+			storage->reserve(this->size());
+			for(const ITuple &tuple : *this)
+				storage->push_back(&tuple);
+			return TupleRange(
+					std::shared_ptr<const TupleRange::Storage>(storage));
+		}
+
+		// Splits the set into threadCount subranges and calls f(subrange)
+		// for each of them concurrently.
+		template<typename F>
+		void parallelForEach(F f, unsigned int threadCount) const
+		{
+			range().parallelForEach(f, threadCount);
+		}
+
 	}; // class ITupleSet
 
 	inline ITupleSet::~ITupleSet() { }
@@ -0,0 +1,42 @@
+#ifndef SHARP_SHARP_ITUPLESETCOMBINER_H_
+#define SHARP_SHARP_ITUPLESETCOMBINER_H_
+
+#include <sharp/global>
+
+#include <sharp/ITupleSet.hpp>
+#include <sharp/INodeTupleSetMap.hpp>
+#include <sharp/IInstance.hpp>
+
+#include <htd/main.hpp>
+
+#include <vector>
+
+namespace sharp
+{
+	// Merges the tuple sets that independent tuple algorithms computed
+	// concurrently for the same node (see create::treeTupleAlgorithm).
+	class SHARP_API ITupleSetCombiner
+	{
+	protected:
+		ITupleSetCombiner &operator=(ITupleSetCombiner &) { return *this; };
+
+	public:
+		virtual ~ITupleSetCombiner() = 0;
+
+		// outputs holds one set per algorithm, in the order of the
+		// algorithms, and is deleted afterwards; tuples can be moved into
+		// outputTuples by erasing them from their set
+		virtual void combine(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				const INodeTupleSetMap &tuples,
+				const IInstance &instance,
+				const std::vector<ITupleSet *> &outputs,
+				ITupleSet &outputTuples) const = 0;
+
+	}; // class ITupleSetCombiner
+
+	inline ITupleSetCombiner::~ITupleSetCombiner() { }
+} // namespace sharp
+
+#endif // SHARP_SHARP_ITUPLESETCOMBINER_H_
@@ -0,0 +1,114 @@
+#ifndef SHARP_SHARP_MULTISETHASH_H_
+#define SHARP_SHARP_MULTISETHASH_H_
+
+#include <sharp/global>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace sharp
+{
+	// Order-independent hash of a multiset of words, e.g. the elements of a
+	// nested set inside a tuple. Every element is scrambled by a strong
+	// mixer (splitmix64) and accumulated by addition, so accumulators can
+	// be combined and elements or whole sub-multisets subtracted again:
+	// the hash of a parent set can be derived from a child's accumulator
+	// instead of rehashing all elements.
+	class SHARP_API MultisetHash
+	{
+	public:
+		MultisetHash() : sum_(0), xor_(0), count_(0) { }
+
+		static std::uint64_t element(std::uint64_t data)
+		{
+			data += UINT64_C(0x9E3779B97F4A7C15);
+			data = (data ^ (data >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+			data = (data ^ (data >> 27)) * UINT64_C(0x94D049BB133111EB);
+			return data ^ (data >> 31);
+		}
+
+		void add(std::uint64_t data)
+		{
+			std::uint64_t hash = element(data);
+			sum_ += hash;
+			xor_ ^= hash;
+			++count_;
+		}
+
+		void subtract(std::uint64_t data)
+		{
+			std::uint64_t hash = element(data);
+			sum_ -= hash;
+			xor_ ^= hash;
+			--count_;
+		}
+
+		template<typename Iter>
+		void add(Iter begin, Iter end)
+		{
+			for(; begin != end; ++begin)
+				add(static_cast<std::uint64_t>(*begin));
+		}
+
+		template<typename Iter>
+		void subtract(Iter begin, Iter end)
+		{
+			for(; begin != end; ++begin)
+				subtract(static_cast<std::uint64_t>(*begin));
+		}
+
+		// multiset union resp. difference
+		MultisetHash &operator+=(const MultisetHash &other)
+		{
+			sum_ += other.sum_;
+			xor_ ^= other.xor_;
+			count_ += other.count_;
+			return *this;
+		}
+
+		MultisetHash &operator-=(const MultisetHash &other)
+		{
+			sum_ -= other.sum_;
+			xor_ ^= other.xor_;
+			count_ -= other.count_;
+			return *this;
+		}
+
+		void reset()
+		{
+			sum_ = xor_ = count_ = 0;
+		}
+
+		std::size_t size() const
+		{
+			return static_cast<std::size_t>(count_);
+		}
+
+		std::size_t get() const
+		{
+			return static_cast<std::size_t>(
+					element(sum_ ^ element(xor_ ^ element(count_))));
+		}
+
+		bool operator==(const MultisetHash &other) const
+		{
+			return sum_ == other.sum_
+				&& xor_ == other.xor_
+				&& count_ == other.count_;
+		}
+
+		bool operator!=(const MultisetHash &other) const
+		{
+			return !(*this == other);
+		}
+
+	private:
+		std::uint64_t sum_;
+		std::uint64_t xor_;
+		std::uint64_t count_;
+
+	}; // class MultisetHash
+
+} // namespace sharp
+
+#endif // SHARP_SHARP_MULTISETHASH_H_
@@ -0,0 +1,83 @@
+#ifndef SHARP_SHARP_MULTIWAYJOIN_H_
+#define SHARP_SHARP_MULTIWAYJOIN_H_
+
+#include <sharp/global>
+
+#include <sharp/HashJoin.hpp>
+#include <sharp/ITuple.hpp>
+#include <sharp/ITupleSet.hpp>
+
+#include <vector>
+#include <cstddef>
+
+namespace sharp
+{
+	class HashIndex;
+
+	// Join of the (possibly more than two) child tuple sets of a join node,
+	// with the same matching semantics as HashJoin.
+	//
+	// Instead of joining in child order, the smallest child drives the join
+	// and the other children are probed in order of increasing number of
+	// distinct keys, so a driver tuple is discarded by the most selective
+	// child first. Matching combinations are produced one at a time, either
+	// pulled through next() or pushed to a callback by forEach(), so no
+	// intermediate pairwise join result is ever materialized. Combinations
+	// always list the tuples in the order of the children passed in.
+	class SHARP_API MultiwayJoin
+	{
+	public:
+		MultiwayJoin(
+				const std::vector<const ITupleSet *> &children,
+				const HashJoin::KeyHash &hash,
+				const HashJoin::KeyEqual &equal,
+				unsigned int threadCount);
+
+		~MultiwayJoin();
+
+		// join order as indices into the children, order()[0] drives
+		const std::vector<std::size_t> &order() const;
+
+		// fetches the next combination, returns false once exhausted
+		bool next(std::vector<const ITuple *> &combination);
+		void reset();
+
+		void forEach(const HashJoin::TupleCallback &combine) const;
+
+	private:
+		MultiwayJoin(const MultiwayJoin &) = delete;
+		MultiwayJoin &operator=(const MultiwayJoin &) = delete;
+
+		typedef std::vector<const ITuple *> TupleVector;
+
+		bool findMatches(
+				std::size_t driver,
+				std::vector<TupleVector> &matches) const;
+
+		bool advance(
+				const std::vector<TupleVector> &matches,
+				std::vector<std::size_t> &positions) const;
+
+		void fill(
+				std::size_t driver,
+				const std::vector<TupleVector> &matches,
+				const std::vector<std::size_t> &positions,
+				TupleVector &combination) const;
+
+		HashJoin::KeyEqual equal_;
+		unsigned int threadCount_;
+		std::vector<std::size_t> order_;
+		std::vector<TupleVector> tuples_;
+		std::vector<std::vector<std::size_t> > hashes_;
+		std::vector<HashIndex *> indices_;
+
+		std::size_t driver_;
+		bool pending_;
+		std::vector<TupleVector> matches_;
+		std::vector<std::size_t> positions_;
+
+	}; // class MultiwayJoin
+
+} // namespace sharp
+
+#endif // SHARP_SHARP_MULTIWAYJOIN_H_
@@ -0,0 +1,126 @@
+#ifndef SHARP_SHARP_NODEPROFILER_H_
+#define SHARP_SHARP_NODEPROFILER_H_
+
+#include <sharp/global>
+
+#include <sharp/ITable.hpp>
+#include <sharp/INodeTableMap.hpp>
+
+#include <htd/main.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace sharp
+{
+	// Opt-in profile of every node evaluation, owned by a
+	// BenchmarkSession. When enabled, the iterative solvers record one
+	// entry per node and pass into their session; printCsv() and
+	// printJson() export the entries, and BenchmarkSession::print()
+	// appends the summary by node type and bag size.
+	class SHARP_API NodeProfiler
+	{
+	public:
+		enum NodeType
+		{
+			LEAF,
+			INTRODUCE,
+			FORGET,
+			// introduces and forgets vertices, or keeps the bag unchanged
+			EXCHANGE,
+			JOIN
+		};
+
+		struct Entry
+		{
+			std::string pass;
+			htd::vertex_t node;
+			NodeType type;
+			std::size_t bagSize;
+			std::size_t childCount;
+			// tuples in the input tables (the child tables, or the parent's
+			// table in top-down passes) resp. the node's table; tables that
+			// are no tuple sets count as empty
+			std::size_t inputTuples;
+			std::size_t outputTuples;
+			double seconds;
+			// growth of the heap during the evaluation, or negative if it
+			// was not measured: the heap is shared by all threads and
+			// reading its usage locks every malloc arena, so evaluations
+			// running concurrently with other nodes (top-down passes with
+			// more than one thread) are not measured, nor are any if the C
+			// library cannot report its usage
+			long long allocatedBytes;
+		};
+
+		// Measures a single evaluation from the call to start() on.
+		class SHARP_API Probe
+		{
+		public:
+			Probe();
+
+			// measures the heap as well if measureHeap is true; only pass
+			// true if no other evaluation runs at the same time
+			void start(bool measureHeap);
+
+			double seconds() const;
+			long long allocatedBytes() const;
+
+		private:
+			std::chrono::steady_clock::time_point start_;
+			long long heap_;
+
+		}; // class Probe
+
+		NodeProfiler();
+
+		void enable(bool enabled);
+		bool enabled() const { return enabled_; }
+
+		static NodeType classify(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition);
+		static const char *typeName(NodeType type);
+
+		// Fills in the node figures of an entry. Call before evaluating
+		// node, while its input tables are still in tables.
+		static Entry begin(
+				const std::string &pass,
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				const INodeTableMap &tables,
+				bool topDown);
+
+		// Completes entry with the figures of probe and the new table of
+		// the node (which may be nullptr) and records it.
+		void end(Entry &entry, const Probe &probe, const ITable *table);
+
+		void record(const Entry &entry);
+
+		// bytes currently allocated on the heap, or -1 if unknown
+		static long long heapUsage();
+
+		std::vector<Entry> entries() const;
+		void printCsv(std::ostream &out) const;
+		void printJson(std::ostream &out) const;
+		void printSummary(std::ostream &out, bool csv) const;
+		void clear();
+
+	private:
+		NodeProfiler(const NodeProfiler &) = delete;
+		NodeProfiler &operator=(const NodeProfiler &) = delete;
+
+		std::atomic<bool> enabled_;
+		mutable std::mutex lock_;
+		std::vector<Entry> entries_;
+
+	}; // class NodeProfiler
+
+} // namespace sharp
+
+#endif // SHARP_SHARP_NODEPROFILER_H_
@@ -0,0 +1,123 @@
+#ifndef SHARP_SHARP_PERFCOUNTERS_H_
+#define SHARP_SHARP_PERFCOUNTERS_H_
+
+#include <sharp/global>
+
+#include <atomic>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <cstddef>
+
+namespace sharp
+{
+	// Opt-in hardware counters (perf_event_open on Linux) sampled around
+	// every node evaluation and the solution extraction, owned by a
+	// BenchmarkSession. When enabled, the iterative solvers attribute the
+	// counts to the pass and the node type (or "extraction") in their
+	// session; BenchmarkSession::print() appends the report.
+	//
+	// Only the calling thread is counted: a sample covers the user space
+	// work of the thread that evaluates the node (or extracts the
+	// solution), not that of threads it hands work to, e.g. partitioned
+	// hash joins, concurrent algorithms or parallel extraction. Figures of
+	// multi-threaded steps are therefore lower bounds.
+	//
+	// Counters are opened on the first sample of every thread and closed
+	// when it exits. That costs one perf_event_open call per counter
+	// (five) per thread; as the worker threads of a parallel pass are
+	// started for that pass, the cost recurs on every pass. Counters the
+	// system does not provide, e.g. in containers without access to the
+	// PMU, are silently left out; if none are available, nothing is
+	// recorded.
+	class SHARP_API PerfCounters
+	{
+	public:
+		enum Counter
+		{
+			CYCLES,
+			INSTRUCTIONS,
+			// last level cache read misses
+			LLC_MISSES,
+			// data TLB read misses
+			DTLB_MISSES,
+			BRANCH_MISSES,
+			COUNTER_COUNT
+		};
+
+		struct Values
+		{
+			// scaled for multiplexing; negative if the counter is not
+			// available
+			long long counts[COUNTER_COUNT];
+		};
+
+		// Reads the counters of the calling thread at start() and at
+		// stop(). Both have to be called on the same thread.
+		class SHARP_API Sample
+		{
+		public:
+			Sample();
+
+			void start();
+
+			// false if the counters were not available or did not run
+			bool stop(Values &values) const;
+
+		private:
+			bool started_;
+			long long counts_[COUNTER_COUNT];
+			unsigned long long enabled_;
+			unsigned long long running_;
+
+		}; // class Sample
+
+		PerfCounters();
+
+		void enable(bool enabled);
+		bool enabled() const { return enabled_; }
+
+		// whether any counter can be opened on the calling thread
+		static bool available();
+
+		static const char *counterName(Counter counter);
+
+		void record(
+				const std::string &pass,
+				const std::string &kind,
+				const Values &values);
+
+		// stops sample and records it if it is valid
+		void record(
+				const std::string &pass,
+				const std::string &kind,
+				const Sample &sample);
+
+		void print(std::ostream &out, bool csv) const;
+		void clear();
+
+	private:
+		PerfCounters(const PerfCounters &) = delete;
+		PerfCounters &operator=(const PerfCounters &) = delete;
+
+		struct Summary
+		{
+			Summary();
+
+			std::size_t samples;
+			long long counts[COUNTER_COUNT];
+			bool counted[COUNTER_COUNT];
+		};
+
+		std::atomic<bool> enabled_;
+		mutable std::mutex lock_;
+		// by pass and kind
+		std::map<std::pair<std::string, std::string>, Summary> summaries_;
+
+	}; // class PerfCounters
+
+} // namespace sharp
+
+#endif // SHARP_SHARP_PERFCOUNTERS_H_
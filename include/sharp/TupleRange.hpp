@@ -0,0 +1,75 @@
+#ifndef SHARP_SHARP_TUPLERANGE_H_
+#define SHARP_SHARP_TUPLERANGE_H_
+
+#include <sharp/global>
+
+#include <sharp/ITuple.hpp>
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+namespace sharp
+{
+	// Random access view of a slice of a tuple set, as returned by
+	// ITupleSet::range(). Ranges are cheap to copy and can be split into
+	// disjoint subranges that are processed by different threads. A range
+	// stays valid as long as the tuple set it was taken from is not
+	// modified.
+	class SHARP_API TupleRange
+	{
+	public:
+		typedef std::vector<const ITuple *> Storage;
+
+		TupleRange();
+		TupleRange(const ITuple * const *tuples, std::size_t size);
+
+		// takes shared ownership of a gathered pointer array
+		explicit TupleRange(const std::shared_ptr<const Storage> &storage);
+
+		~TupleRange();
+
+		std::size_t size() const { return size_; }
+		bool empty() const { return size_ == 0; }
+
+		const ITuple &operator[](std::size_t position) const
+		{
+			return *tuples_[position];
+		}
+
+		const ITuple * const *begin() const { return tuples_; }
+		const ITuple * const *end() const { return tuples_ + size_; }
+
+		// [begin, end) relative to this range
+		TupleRange subrange(std::size_t begin, std::size_t end) const;
+
+		// at most count non-empty subranges whose sizes differ by at most one
+		std::vector<TupleRange> split(std::size_t count) const;
+
+		// Calls f(subrange) for threadCount subranges concurrently, one of
+		// them on the calling thread. f must be safe to call from several
+		// threads at once. The first exception thrown by f is rethrown
+		// after all subranges are done.
+		template<typename F>
+		void parallelForEach(F f, unsigned int threadCount) const
+		{
+			forEachPart(
+					split(threadCount == 0 ? 1 : threadCount),
+					std::function<void(const TupleRange &)>(f));
+		}
+
+	private:
+		static void forEachPart(
+				const std::vector<TupleRange> &parts,
+				const std::function<void(const TupleRange &)> &f);
+
+		std::shared_ptr<const Storage> storage_;
+		const ITuple * const *tuples_;
+		std::size_t size_;
+
+	}; // class TupleRange
+
+} // namespace sharp
+
+#endif // SHARP_SHARP_TUPLERANGE_H_
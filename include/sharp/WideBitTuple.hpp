@@ -0,0 +1,61 @@
+#ifndef SHARP_SHARP_WIDEBITTUPLE_H_
+#define SHARP_SHARP_WIDEBITTUPLE_H_
+
+#include <sharp/global>
+
+#include <sharp/ITuple.hpp>
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace sharp
+{
+	// Multi-word variant of BitTuple for bags wider than 64 vertices. Words
+	// are stored least significant first, bit i lives in word i / 64.
+	class SHARP_API WideBitTuple : public ITuple
+	{
+	public:
+		static const std::size_t WORD_WIDTH = 64;
+
+		explicit WideBitTuple(std::size_t width);
+		WideBitTuple(std::size_t width, const std::uint64_t *words);
+
+		virtual ~WideBitTuple() override;
+
+		std::size_t width() const { return width_; }
+		std::size_t wordCount() const { return words_.size(); }
+		const std::uint64_t *words() const { return words_.data(); }
+
+		bool get(std::size_t position) const
+		{
+			return (words_[position / WORD_WIDTH]
+					>> (position % WORD_WIDTH)) & 1u;
+		}
+
+		void set(std::size_t position, bool value)
+		{
+			std::uint64_t &word = words_[position / WORD_WIDTH];
+			std::size_t shift = position % WORD_WIDTH;
+			word = (word & ~(std::uint64_t(1) << shift))
+				| (std::uint64_t(value) << shift);
+		}
+
+		// introduce: grows the tuple by one bit at position
+		void insert(std::size_t position, bool value);
+
+		// forget: shrinks the tuple by removing the bit at position
+		void erase(std::size_t position);
+
+		virtual std::size_t hash() const override;
+		virtual bool operator==(const ITuple &other) const override;
+
+	private:
+		std::size_t width_;
+		std::vector<std::uint64_t> words_;
+
+	}; // class WideBitTuple
+
+} // namespace sharp
+
+#endif // SHARP_SHARP_WIDEBITTUPLE_H_
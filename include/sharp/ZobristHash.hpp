@@ -0,0 +1,66 @@
+#ifndef SHARP_SHARP_ZOBRISTHASH_H_
+#define SHARP_SHARP_ZOBRISTHASH_H_
+
+#include <sharp/global>
+
+#include <sharp/Hash.hpp>
+
+#include <htd/main.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace sharp
+{
+	// Incremental hash of a set of (vertex, value) assignments: the XOR of
+	// a pseudo-random key per assignment. Introducing, forgetting or
+	// changing the value of a single vertex updates the hash in O(1), so a
+	// tuple derived from a child tuple can start from the child's hash
+	// instead of rehashing the whole bag.
+	//
+	// Keys are computed on the fly by Hash's word mixer from a fixed seed,
+	// so they need no table and are the same in every run.
+	class SHARP_API ZobristHash
+	{
+	public:
+		ZobristHash() : hash_(0) { }
+		explicit ZobristHash(std::size_t hash) : hash_(hash) { }
+
+		static std::size_t key(htd::vertex_t vertex, std::size_t value)
+		{
+			return static_cast<std::size_t>(Hash::finalize(Hash::mix(
+					Hash::mix(SEED, vertex), value)));
+		}
+
+		void add(htd::vertex_t vertex, std::size_t value)
+		{
+			hash_ ^= key(vertex, value);
+		}
+
+		void remove(htd::vertex_t vertex, std::size_t value)
+		{
+			hash_ ^= key(vertex, value);
+		}
+
+		void replace(
+				htd::vertex_t vertex,
+				std::size_t oldValue,
+				std::size_t newValue)
+		{
+			hash_ ^= key(vertex, oldValue) ^ key(vertex, newValue);
+		}
+
+		void reset() { hash_ = 0; }
+
+		std::size_t get() const { return hash_; }
+
+	private:
+		static const std::uint64_t SEED = UINT64_C(0x2545F4914F6CDD1D);
+
+		std::size_t hash_;
+
+	}; // class ZobristHash
+
+} // namespace sharp
+
+#endif // SHARP_SHARP_ZOBRISTHASH_H_
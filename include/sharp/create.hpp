@@ -6,11 +6,19 @@
 #include <sharp/ITreeSolver.hpp>
 #include <sharp/ITreeAlgorithm.hpp>
 #include <sharp/ITreeTupleAlgorithm.hpp>
+#include <sharp/ITreeTopDownAlgorithm.hpp>
+#include <sharp/ITreeTupleTopDownAlgorithm.hpp>
+#include <sharp/ITreeTupleStreamAlgorithm.hpp>
+#include <sharp/ITableCombiner.hpp>
+#include <sharp/ITupleSetCombiner.hpp>
 #include <sharp/ITreeSolutionExtractor.hpp>
 #include <sharp/ITreeTupleSolutionExtractor.hpp>
+#include <sharp/ITupleSet.hpp>
 
 #include <htd/main.hpp>
 
+#include <vector>
+
 namespace sharp
 {
 
@@ -46,6 +54,14 @@ namespace sharp
 				const TreeAlgorithmVector &algorithms,
 				const ITreeSolutionExtractor &extractor);
 
+		// runs topDownAlgorithms from the root to the leaves after the
+		// bottom-up algorithms
+		static ITreeSolver *treeSolver(
+				const htd::ITreeDecompositionAlgorithm &decomposer,
+				const TreeAlgorithmVector &algorithms,
+				const TreeTopDownAlgorithmVector &topDownAlgorithms,
+				const ITreeSolutionExtractor &extractor);
+
 		static ITreeSolver *treeSolver(
 				const htd::ITreeDecompositionAlgorithm &decomposer,
 				const ITreeTupleAlgorithm &algorithm);
@@ -75,14 +91,44 @@ namespace sharp
 				const TreeTupleAlgorithmVector &algorithms,
 				const ITreeTupleSolutionExtractor &extractor);
 
+		static ITreeSolver *treeSolver(
+				const htd::ITreeDecompositionAlgorithm &decomposer,
+				const TreeTupleAlgorithmVector &algorithms,
+				const TreeTupleTopDownAlgorithmVector &topDownAlgorithms,
+				const ITreeTupleSolutionExtractor &extractor);
+
 		static ITreeAlgorithm *treeAlgorithm(
 				const ITreeAlgorithm &algorithm1,
 				const ITreeAlgorithm &algorithm2);
 
+		static ITreeAlgorithm *treeAlgorithm(
+				const TreeAlgorithmVector &algorithms);
+
+		// runs independent algorithms concurrently on each node and
+		// merges their results with combiner
+		static ITreeAlgorithm *treeAlgorithm(
+				const TreeAlgorithmVector &algorithms,
+				const ITableCombiner &combiner);
+
 		static ITreeTupleAlgorithm *treeTupleAlgorithm(
 				const ITreeTupleAlgorithm &algorithm1,
 				const ITreeTupleAlgorithm &algorithm2);
 
+		static ITreeTupleAlgorithm *treeTupleAlgorithm(
+				const TreeTupleAlgorithmVector &algorithms);
+
+		static ITreeTupleAlgorithm *treeTupleAlgorithm(
+				const TreeTupleAlgorithmVector &algorithms,
+				const ITupleSetCombiner &combiner);
+
+		// streams the output of algorithm1 into algorithm2 tuple by tuple
+		static ITreeTupleAlgorithm *treeTupleAlgorithm(
+				const ITreeTupleAlgorithm &algorithm1,
+				const ITreeTupleStreamAlgorithm &algorithm2);
+
+		// read-only view of the given sets as one, takes ownership of them
+		static ITupleSet *tupleSetUnion(const std::vector<ITupleSet *> &sets);
+
 	private:
 		create();
 
@@ -0,0 +1,426 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <sharp/BenchmarkSession.hpp>
+
+#include "util/output.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <thread>
+
+#include <time.h>
+
+#ifdef HAVE_SYS_RESOURCE_H
+	#include <sys/resource.h>
+#endif
+
+namespace sharp
+{
+	using std::int64_t;
+	using std::uint64_t;
+	using std::size_t;
+	using std::string;
+	using std::vector;
+	using std::map;
+	using std::endl;
+	using std::ios;
+
+	struct BenchmarkSession::Buffer
+	{
+		std::thread::id owner;
+		unsigned int thread;
+		// number of running timers
+		unsigned int depth;
+		vector<Event> events;
+	};
+
+	namespace
+	{
+		const double NANOSECONDS = 1e9;
+
+		// session ids are never reused, so a stale cache entry can never
+		// match a later session
+		std::atomic<uint64_t> nextSessionId_(1);
+
+		// the buffer the calling thread recorded into last
+		struct BufferCache
+		{
+			uint64_t session;
+			void *buffer;
+		};
+
+		thread_local BufferCache cache_ = { 0, nullptr };
+
+		thread_local BenchmarkSession *current_ = nullptr;
+
+		struct TimerSummary
+		{
+			TimerSummary() : calls(0), wall(0), threadCpu(0) { }
+
+			size_t calls;
+			int64_t wall;
+			int64_t threadCpu;
+		};
+
+		int64_t threadCpuTime()
+		{
+#ifdef CLOCK_THREAD_CPUTIME_ID
+			struct timespec time;
+			if(clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) == 0)
+				return int64_t(time.tv_sec) * 1000000000 + time.tv_nsec;
+#endif
+			return 0;
+		}
+
+		void processCpuTime(int64_t &user, int64_t &system)
+		{
+#ifdef HAVE_SYS_RESOURCE_H
+			struct rusage usage;
+			if(getrusage(RUSAGE_SELF, &usage) == 0)
+			{
+				user = int64_t(usage.ru_utime.tv_sec) * 1000000000
+					+ int64_t(usage.ru_utime.tv_usec) * 1000;
+				system = int64_t(usage.ru_stime.tv_sec) * 1000000000
+					+ int64_t(usage.ru_stime.tv_usec) * 1000;
+				return;
+			}
+#endif
+			user = system = 0;
+		}
+
+		// trace event timestamps are in microseconds
+		double microseconds(int64_t nanoseconds)
+		{
+			return nanoseconds / 1e3;
+		}
+
+	} // namespace
+
+	const int64_t BenchmarkSession::NO_NODE;
+
+	BenchmarkSession::ScopedTimer::ScopedTimer(
+			BenchmarkSession &session,
+			const string &name)
+		: session_(&session), index_(0)
+	{
+		this->start("timer", name, NO_NODE);
+	}
+
+	BenchmarkSession::ScopedTimer::ScopedTimer(
+			BenchmarkSession *session,
+			const char *category,
+			const string &name,
+			int64_t node)
+		: session_(session), index_(0)
+	{
+		if(session_)
+			this->start(category, name, node);
+	}
+
+	void BenchmarkSession::ScopedTimer::start(
+			const char *category,
+			const string &name,
+			int64_t node)
+	{
+		Buffer &buffer = session_->buffer();
+		index_ = buffer.events.size();
+
+		Event event;
+		event.type = TIMER;
+		event.name = name;
+		event.category = category;
+		event.node = node;
+		event.depth = buffer.depth++;
+		event.end = 0;
+		event.user = event.system = 0;
+		buffer.events.push_back(std::move(event));
+
+		// read the clocks last, so that the timer does not measure itself
+		Event &started = buffer.events.back();
+		started.threadCpu = threadCpuTime();
+		started.begin = session_->now();
+	}
+
+	BenchmarkSession::ScopedTimer::~ScopedTimer()
+	{
+		if(!session_)
+			return;
+
+		int64_t end = session_->now();
+		int64_t threadCpu = threadCpuTime();
+
+		Buffer &buffer = session_->buffer();
+		Event &event = buffer.events[index_];
+		event.end = end;
+		event.threadCpu = threadCpu - event.threadCpu;
+		--buffer.depth;
+	}
+
+	BenchmarkSession::Activation::Activation(BenchmarkSession &session)
+		: previous_(current_)
+	{
+		current_ = &session;
+	}
+
+	BenchmarkSession::Activation::~Activation()
+	{
+		current_ = previous_;
+	}
+
+	BenchmarkSession *BenchmarkSession::current()
+	{
+		return current_;
+	}
+
+	BenchmarkSession *BenchmarkSession::currentDetailed()
+	{
+		return current_ && current_->nodeTiming() ? current_ : nullptr;
+	}
+
+	BenchmarkSession::BenchmarkSession()
+		: id_(nextSessionId_++),
+		  start_(std::chrono::steady_clock::now()),
+		  nodeTiming_(false)
+	{ }
+
+	BenchmarkSession::~BenchmarkSession() { }
+
+	void BenchmarkSession::registerTimestamp(const string &name)
+	{
+		Buffer &buffer = this->buffer();
+
+		Event event;
+		event.type = TIMESTAMP;
+		event.name = name;
+		event.category = "timestamp";
+		event.node = NO_NODE;
+		event.depth = buffer.depth;
+		event.begin = event.end = this->now();
+		event.threadCpu = threadCpuTime();
+		processCpuTime(event.user, event.system);
+		buffer.events.push_back(std::move(event));
+	}
+
+	void BenchmarkSession::setNodeTiming(bool enabled)
+	{
+		nodeTiming_ = enabled;
+	}
+
+	int64_t BenchmarkSession::now() const
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - start_).count();
+	}
+
+	vector<BenchmarkSession::ThreadEvents> BenchmarkSession::events() const
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+
+		vector<ThreadEvents> events(buffers_.size());
+		for(size_t i = 0; i < buffers_.size(); ++i)
+		{
+			events[i].thread = buffers_[i]->thread;
+			events[i].events = buffers_[i]->events;
+		}
+		return events;
+	}
+
+	void BenchmarkSession::print(std::ostream &out, bool csv) const
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+
+		vector<const Event *> timestamps;
+		map<string, TimerSummary> timers;
+		for(const std::unique_ptr<Buffer> &buffer : buffers_)
+		{
+			// names of the timers enclosing the current event
+			vector<string> path;
+			for(const Event &event : buffer->events)
+			{
+				if(event.type == TIMESTAMP)
+				{
+					timestamps.push_back(&event);
+					continue;
+				}
+
+				path.resize(event.depth);
+				string key;
+				for(const string &name : path)
+					key += name + "/";
+				key += event.name;
+				path.push_back(event.name);
+
+				TimerSummary &summary = timers[key];
+				++summary.calls;
+				summary.wall += event.end - event.begin;
+				summary.threadCpu += event.threadCpu;
+			}
+		}
+
+		std::stable_sort(timestamps.begin(), timestamps.end(),
+				[](const Event *lhs, const Event *rhs)
+				{
+					return lhs->begin < rhs->begin;
+				});
+
+		StreamFormatGuard format(out);
+		out.setf(ios::fixed, ios::floatfield);
+
+		if(!timestamps.empty())
+		{
+			out.precision(2);
+
+			const Event *last = timestamps.front();
+			if(!csv)
+				out << "0.00s (usr),\t0.00s (sys),\t0.00s (wall) - "
+					<< last->name << endl;
+			else
+				out << "usr,sys,cpu,wall,description" << endl
+					<< "0.00,0.00,0.00,0.00,"
+					<< last->name << endl;
+
+			for(size_t i = 1; i < timestamps.size(); ++i)
+			{
+				const Event *current = timestamps[i];
+				double user = (current->user - last->user) / NANOSECONDS;
+				double system = (current->system - last->system) / NANOSECONDS;
+				double wall = (current->begin - last->begin) / NANOSECONDS;
+
+				if(!csv)
+					out << user << "s (usr),\t"
+						<< system << "s (sys),\t"
+						<< wall << "s (wall) - "
+						<< current->name << endl;
+				else
+					out << user << ","
+						<< system << ","
+						<< user + system << ","
+						<< wall << ","
+						<< current->name << endl;
+
+				last = current;
+			}
+		}
+
+		if(!timers.empty())
+		{
+			out.precision(6);
+
+			if(csv)
+				out << "calls,wall,cpu,timer" << endl;
+
+			for(const auto &timer : timers)
+			{
+				double wall = timer.second.wall / NANOSECONDS;
+				double threadCpu = timer.second.threadCpu / NANOSECONDS;
+
+				if(!csv)
+					out << timer.second.calls << " calls,\t"
+						<< wall << "s (wall),\t"
+						<< threadCpu << "s (thread cpu) - "
+						<< timer.first << endl;
+				else
+					out << timer.second.calls << ","
+						<< wall << ","
+						<< threadCpu << ","
+						<< timer.first << endl;
+			}
+		}
+
+		hashStatistics_.print(out, csv);
+		nodeProfiler_.printSummary(out, csv);
+		perfCounters_.print(out, csv);
+	}
+
+	void BenchmarkSession::printTrace(std::ostream &out) const
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+
+		StreamFormatGuard format(out);
+		out.setf(ios::fixed, ios::floatfield);
+		out.precision(3);
+
+		out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [" << endl
+			<< " {\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, "
+			<< "\"tid\": 0, \"args\": {\"name\": \"sharp\"}}";
+
+		for(const std::unique_ptr<Buffer> &buffer : buffers_)
+		{
+			out << "," << endl
+				<< " {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, "
+				<< "\"tid\": " << buffer->thread << ", \"args\": "
+				<< "{\"name\": \"thread " << buffer->thread << "\"}}";
+
+			for(const Event &event : buffer->events)
+			{
+				// timers that are still running have no duration yet
+				if(event.end < event.begin)
+					continue;
+
+				out << "," << endl
+					<< " {\"name\": \"" << jsonEscape(event.name) << "\""
+					<< ", \"cat\": \"" << event.category << "\""
+					<< ", \"ph\": \"" << (event.type == TIMER ? "X" : "i")
+					<< "\", \"ts\": " << microseconds(event.begin);
+				if(event.type == TIMER)
+					out << ", \"dur\": " << microseconds(event.end - event.begin);
+				else
+					out << ", \"s\": \"p\"";
+				out << ", \"pid\": 1, \"tid\": " << buffer->thread
+					<< ", \"args\": {";
+				if(event.node != NO_NODE)
+					out << "\"node\": " << event.node << ", ";
+				out << "\"threadCpu\": " << microseconds(event.threadCpu)
+					<< "}}";
+			}
+		}
+
+		out << endl << "]}" << endl;
+	}
+
+	void BenchmarkSession::clear()
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+		buffers_.clear();
+		id_ = nextSessionId_++;
+		hashStatistics_.clear();
+		nodeProfiler_.clear();
+		perfCounters_.clear();
+	}
+
+	BenchmarkSession::Buffer &BenchmarkSession::buffer()
+	{
+		if(cache_.session == id_)
+			return *static_cast<Buffer *>(cache_.buffer);
+
+		std::lock_guard<std::mutex> guard(lock_);
+
+		// a thread that exited may leave its buffer to a new thread with
+		// the same id; they never record at the same time
+		std::thread::id self = std::this_thread::get_id();
+		Buffer *buffer = nullptr;
+		for(const std::unique_ptr<Buffer> &candidate : buffers_)
+			if(candidate->owner == self)
+			{
+				buffer = candidate.get();
+				break;
+			}
+
+		if(!buffer)
+		{
+			buffers_.emplace_back(new Buffer);
+			buffer = buffers_.back().get();
+			buffer->owner = self;
+			buffer->thread = buffers_.size() - 1;
+			buffer->depth = 0;
+		}
+
+		cache_.session = id_;
+		cache_.buffer = buffer;
+		return *buffer;
+	}
+
+} // namespace sharp
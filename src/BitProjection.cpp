@@ -0,0 +1,246 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <sharp/BitProjection.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__BMI2__)
+	#include <immintrin.h>
+#endif
+
+namespace sharp
+{
+	using htd::vertex_t;
+
+	using std::size_t;
+	using std::uint64_t;
+	using std::vector;
+	using std::min;
+
+	const size_t BitProjection::NONE;
+
+	namespace
+	{
+		const size_t WORD_WIDTH = 64;
+
+		// rows are processed in blocks that stay in L1 while every run is
+		// applied to them
+		const size_t BLOCK_SIZE = 256;
+
+		size_t wordsFor(size_t width)
+		{
+			return width == 0 ? 1 : (width + WORD_WIDTH - 1) / WORD_WIDTH;
+		}
+	}
+
+	BitProjection::BitProjection(
+			const vector<size_t> &positions,
+			size_t sourceWidth)
+		: sourceWidth_(sourceWidth),
+		  targetWidth_(positions.size()),
+		  sourceWords_(wordsFor(sourceWidth)),
+		  targetWords_(wordsFor(positions.size())),
+		  monotone_(true),
+		  sourceMask_(0),
+		  targetMask_(0)
+	{
+		size_t lastSource = NONE;
+		size_t position = 0;
+		while(position < targetWidth_)
+		{
+			if(positions[position] == NONE)
+			{
+				freePositions_.push_back(position);
+				++position;
+				continue;
+			}
+
+			size_t source = positions[position];
+			if(source >= sourceWidth_)
+				throw std::invalid_argument(
+						"Source position out of range!");
+
+			if(lastSource != NONE && source <= lastSource)
+				monotone_ = false;
+
+			// every source bit of the run has to exist, not only the first
+			size_t length = 1;
+			while(position + length < targetWidth_
+					&& source + length < sourceWidth_
+					&& positions[position + length] == source + length)
+				++length;
+			lastSource = source + length - 1;
+
+			// split the run where it crosses a word boundary on either side
+			size_t target = position;
+			size_t remaining = length;
+			while(remaining > 0)
+			{
+				size_t sourceShift = source % WORD_WIDTH;
+				size_t targetShift = target % WORD_WIDTH;
+				size_t chunk = min(remaining, min(
+							WORD_WIDTH - sourceShift,
+							WORD_WIDTH - targetShift));
+
+				Run run;
+				run.sourceWord = source / WORD_WIDTH;
+				run.targetWord = target / WORD_WIDTH;
+				run.sourceShift = (unsigned int)sourceShift;
+				run.targetShift = (unsigned int)targetShift;
+				run.mask = chunk == WORD_WIDTH
+					? ~uint64_t(0)
+					: (uint64_t(1) << chunk) - 1;
+				runs_.push_back(run);
+
+				if(sourceWords_ == 1 && targetWords_ == 1)
+				{
+					sourceMask_ |= run.mask << run.sourceShift;
+					targetMask_ |= run.mask << run.targetShift;
+				}
+
+				source += chunk;
+				target += chunk;
+				remaining -= chunk;
+			}
+
+			position += length;
+		}
+	}
+
+	BitProjection::~BitProjection() { }
+
+	vector<size_t> BitProjection::positionMap(
+			const vector<vertex_t> &sourceBag,
+			const vector<vertex_t> &targetBag)
+	{
+		vector<size_t> positions;
+		positions.reserve(targetBag.size());
+
+		for(vertex_t vertex : targetBag)
+		{
+			auto found = std::find(sourceBag.begin(), sourceBag.end(), vertex);
+			positions.push_back(found == sourceBag.end()
+					? NONE
+					: (size_t)(found - sourceBag.begin()));
+		}
+
+		return positions;
+	}
+
+	void BitProjection::project(
+			const uint64_t *source,
+			size_t rowCount,
+			uint64_t *target) const
+	{
+		if(sourceWords_ == 1 && targetWords_ == 1)
+			this->projectSingleWord(source, rowCount, target);
+		else
+			this->projectMultiWord(source, rowCount, target);
+	}
+
+	void BitProjection::extend(
+			const uint64_t *source,
+			size_t rowCount,
+			uint64_t *target) const
+	{
+		// project() works for any number of introduced positions, only the
+		// extension has to enumerate their assignments
+		if(freePositions_.size() >= WORD_WIDTH / 2)
+			throw std::invalid_argument(
+					"Too many introduced positions for extension!");
+
+		this->project(source, rowCount, target);
+
+		size_t blockWords = rowCount * targetWords_;
+		size_t factor = this->extensionFactor();
+		vector<uint64_t> deposit(targetWords_);
+
+		for(size_t combination = 1; combination < factor; ++combination)
+		{
+			std::fill(deposit.begin(), deposit.end(), 0);
+			for(size_t bit = 0; bit < freePositions_.size(); ++bit)
+				if((combination >> bit) & 1u)
+					deposit[freePositions_[bit] / WORD_WIDTH] |=
+						uint64_t(1) << (freePositions_[bit] % WORD_WIDTH);
+
+			uint64_t *block = target + combination * blockWords;
+			if(targetWords_ == 1)
+			{
+				uint64_t bits = deposit[0];
+				for(size_t row = 0; row < rowCount; ++row)
+					block[row] = target[row] | bits;
+			}
+			else
+			{
+				for(size_t word = 0; word < blockWords; ++word)
+					block[word] = target[word] | deposit[word % targetWords_];
+			}
+		}
+	}
+
+	void BitProjection::projectSingleWord(
+			const uint64_t *source,
+			size_t rowCount,
+			uint64_t *target) const
+	{
+#if defined(__BMI2__)
+		// fragmented order-preserving maps are one pext/pdep pair per row
+		if(monotone_ && runs_.size() > 2)
+		{
+			for(size_t row = 0; row < rowCount; ++row)
+				target[row] = _pdep_u64(
+						_pext_u64(source[row], sourceMask_),
+						targetMask_);
+			return;
+		}
+#endif
+
+		for(size_t begin = 0; begin < rowCount; begin += BLOCK_SIZE)
+		{
+			size_t end = min(begin + BLOCK_SIZE, rowCount);
+
+			for(size_t row = begin; row < end; ++row)
+				target[row] = 0;
+
+			for(const Run &run : runs_)
+			{
+				unsigned int sourceShift = run.sourceShift;
+				unsigned int targetShift = run.targetShift;
+				uint64_t mask = run.mask;
+
+				for(size_t row = begin; row < end; ++row)
+					target[row] |=
+						((source[row] >> sourceShift) & mask) << targetShift;
+			}
+		}
+	}
+
+	void BitProjection::projectMultiWord(
+			const uint64_t *source,
+			size_t rowCount,
+			uint64_t *target) const
+	{
+		for(size_t begin = 0; begin < rowCount; begin += BLOCK_SIZE)
+		{
+			size_t end = min(begin + BLOCK_SIZE, rowCount);
+
+			std::fill(target + begin * targetWords_,
+					target + end * targetWords_, 0);
+
+			for(const Run &run : runs_)
+			{
+				const uint64_t *in = source + run.sourceWord;
+				uint64_t *out = target + run.targetWord;
+
+				for(size_t row = begin; row < end; ++row)
+					out[row * targetWords_] |=
+						((in[row * sourceWords_] >> run.sourceShift)
+						 & run.mask) << run.targetShift;
+			}
+		}
+	}
+
+} // namespace sharp
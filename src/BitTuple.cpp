@@ -0,0 +1,65 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <sharp/BitTuple.hpp>
+
+#include <sharp/Hash.hpp>
+
+#include <cassert>
+#include <typeinfo>
+
+namespace sharp
+{
+	using std::size_t;
+	using std::uint64_t;
+
+	BitTuple::BitTuple() : bits_(0) { }
+
+	BitTuple::BitTuple(uint64_t bits) : bits_(bits) { }
+
+	BitTuple::~BitTuple() { }
+
+	void BitTuple::insert(size_t position, bool value)
+	{
+		assert(position < MAX_WIDTH);
+
+		uint64_t low = bits_ & ((uint64_t(1) << position) - 1);
+		uint64_t high = bits_ & ~low;
+		bits_ = low | (high << 1) | (uint64_t(value) << position);
+	}
+
+	void BitTuple::erase(size_t position)
+	{
+		assert(position < MAX_WIDTH);
+
+		uint64_t low = bits_ & ((uint64_t(1) << position) - 1);
+		uint64_t high = position + 1 < MAX_WIDTH
+			? (bits_ >> (position + 1)) << position
+			: 0;
+		bits_ = low | high;
+	}
+
+	void BitTuple::gather(
+			const ITuple * const *tuples,
+			size_t count,
+			uint64_t *bits)
+	{
+		for(size_t i = 0; i < count; ++i)
+			bits[i] = static_cast<const BitTuple *>(tuples[i])->bits_;
+	}
+
+	size_t BitTuple::hash() const
+	{
+		Hash h;
+		h.add(&bits_, sizeof(bits_));
+		return h.get();
+	}
+
+	bool BitTuple::operator==(const ITuple &other) const
+	{
+		if(typeid(other) != typeid(*this)) return false;
+		return bits_ == static_cast<const BitTuple &>(other).bits_;
+	}
+
+} // namespace sharp
@@ -0,0 +1,22 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <sharp/CachedHashTuple.hpp>
+
+namespace sharp
+{
+	using std::size_t;
+
+	CachedHashTuple::CachedHashTuple() : hash_(0) { }
+
+	CachedHashTuple::CachedHashTuple(size_t hash) : hash_(hash) { }
+
+	CachedHashTuple::~CachedHashTuple() { }
+
+	size_t CachedHashTuple::hash() const
+	{
+		return hash_;
+	}
+
+} // namespace sharp
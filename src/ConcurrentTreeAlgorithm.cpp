@@ -0,0 +1,92 @@
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include "ConcurrentTreeAlgorithm.hpp"
+
+#include "util/concurrent.hpp"
+
+#include <stdexcept>
+
+namespace sharp
+{
+	using htd::vertex_t;
+	using htd::ITreeDecomposition;
+	using htd::ILabelingFunction;
+
+	using std::vector;
+	using std::size_t;
+
+	ConcurrentTreeAlgorithm::ConcurrentTreeAlgorithm(
+			const TreeAlgorithmVector &algorithms,
+			const ITableCombiner &combiner)
+		: algorithms_(algorithms), combiner_(combiner)
+	{
+		if(algorithms.empty())
+			throw std::invalid_argument("Need at least one algorithm.");
+	}
+
+	ConcurrentTreeAlgorithm::~ConcurrentTreeAlgorithm() { }
+
+	vector<const ILabelingFunction *>
+	ConcurrentTreeAlgorithm::preprocessOperations() const
+	{
+		vector<const ILabelingFunction *> operations;
+		for(const ITreeAlgorithm *algorithm : algorithms_)
+		{
+			vector<const ILabelingFunction *> algorithmOperations =
+				algorithm->preprocessOperations();
+			operations.insert(operations.end(),
+					algorithmOperations.begin(),
+					algorithmOperations.end());
+		}
+		return operations;
+	}
+
+	ITable *ConcurrentTreeAlgorithm::evaluateNode(
+			vertex_t node,
+			const ITreeDecomposition &decomposition,
+			INodeTableMap &tables,
+			const IInstance &instance) const
+	{
+		vector<ITable *> outputs(algorithms_.size(), nullptr);
+		try
+		{
+			runConcurrently(algorithms_.size(), [&](size_t i)
+			{
+				outputs[i] = algorithms_[i]->evaluateNode(
+						node,
+						decomposition,
+						tables,
+						instance);
+			});
+		}
+		catch(...)
+		{
+			for(ITable *output : outputs)
+				delete output;
+			throw;
+		}
+
+		// like InterleavedTreeAlgorithm, a missing table aborts the node
+		for(ITable *output : outputs)
+			if(!output)
+			{
+				for(ITable *other : outputs)
+					delete other;
+				return nullptr;
+			}
+
+		return combiner_.combine(node, decomposition, tables, instance,
+				outputs);
+	}
+
+	bool ConcurrentTreeAlgorithm::needAllTables() const
+	{
+		for(const ITreeAlgorithm *algorithm : algorithms_)
+			if(algorithm->needAllTables())
+				return true;
+		return false;
+	}
+
+} // namespace sharp
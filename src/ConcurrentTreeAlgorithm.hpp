@@ -0,0 +1,41 @@
+#ifndef SHARP_CONCURRENTTREEALGORITHM_H_
+#define SHARP_CONCURRENTTREEALGORITHM_H_
+
+#include <sharp/global>
+
+#include <sharp/ITreeAlgorithm.hpp>
+#include <sharp/ITableCombiner.hpp>
+
+namespace sharp
+{
+	// Runs independent algorithms concurrently on each node and merges
+	// their tables with a combiner. The algorithms must only read the
+	// table map, as all of them access it at the same time.
+	class SHARP_LOCAL ConcurrentTreeAlgorithm : public ITreeAlgorithm
+	{
+		TreeAlgorithmVector algorithms_;
+		const ITableCombiner &combiner_;
+
+	public:
+		ConcurrentTreeAlgorithm(
+				const TreeAlgorithmVector &algorithms,
+				const ITableCombiner &combiner);
+
+		virtual ~ConcurrentTreeAlgorithm() override;
+
+		virtual std::vector<const htd::ILabelingFunction *>
+			preprocessOperations() const override;
+
+		virtual ITable *evaluateNode(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				INodeTableMap &tables,
+				const IInstance &instance) const override;
+
+		virtual bool needAllTables() const override;
+
+	}; // class ConcurrentTreeAlgorithm
+
+} // namespace sharp
+
+#endif // SHARP_CONCURRENTTREEALGORITHM_H_
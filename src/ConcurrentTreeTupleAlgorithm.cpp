@@ -0,0 +1,86 @@
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include "ConcurrentTreeTupleAlgorithm.hpp"
+
+#include "TupleSet.hpp"
+#include "util/concurrent.hpp"
+
+#include <memory>
+#include <stdexcept>
+
+namespace sharp
+{
+	using htd::vertex_t;
+	using htd::ITreeDecomposition;
+	using htd::ILabelingFunction;
+
+	using std::unique_ptr;
+	using std::vector;
+	using std::size_t;
+
+	ConcurrentTreeTupleAlgorithm::ConcurrentTreeTupleAlgorithm(
+			const TreeTupleAlgorithmVector &algorithms,
+			const ITupleSetCombiner &combiner)
+		: algorithms_(algorithms), combiner_(combiner)
+	{
+		if(algorithms.empty())
+			throw std::invalid_argument("Need at least one algorithm.");
+	}
+
+	ConcurrentTreeTupleAlgorithm::~ConcurrentTreeTupleAlgorithm() { }
+
+	vector<const ILabelingFunction *>
+	ConcurrentTreeTupleAlgorithm::preprocessOperations() const
+	{
+		vector<const ILabelingFunction *> operations;
+		for(const ITreeTupleAlgorithm *algorithm : algorithms_)
+		{
+			vector<const ILabelingFunction *> algorithmOperations =
+				algorithm->preprocessOperations();
+			operations.insert(operations.end(),
+					algorithmOperations.begin(),
+					algorithmOperations.end());
+		}
+		return operations;
+	}
+
+	void ConcurrentTreeTupleAlgorithm::evaluateNode(
+			vertex_t node,
+			const ITreeDecomposition &decomposition,
+			INodeTupleSetMap &tuples,
+			const IInstance &instance,
+			ITupleSet &outputTuples) const
+	{
+		vector<unique_ptr<ITupleSet> > outputs;
+		vector<ITupleSet *> outputPointers;
+		for(size_t i = 0; i < algorithms_.size(); ++i)
+		{
+			outputs.push_back(unique_ptr<ITupleSet>(new TupleSet()));
+			outputPointers.push_back(outputs.back().get());
+		}
+
+		runConcurrently(algorithms_.size(), [&](size_t i)
+		{
+			algorithms_[i]->evaluateNode(
+					node,
+					decomposition,
+					tuples,
+					instance,
+					*outputPointers[i]);
+		});
+
+		combiner_.combine(node, decomposition, tuples, instance,
+				outputPointers, outputTuples);
+	}
+
+	bool ConcurrentTreeTupleAlgorithm::needAllTupleSets() const
+	{
+		for(const ITreeTupleAlgorithm *algorithm : algorithms_)
+			if(algorithm->needAllTupleSets())
+				return true;
+		return false;
+	}
+
+} // namespace sharp
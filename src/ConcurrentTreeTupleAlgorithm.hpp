@@ -0,0 +1,41 @@
+#ifndef SHARP_CONCURRENTTREETUPLEALGORITHM_H_
+#define SHARP_CONCURRENTTREETUPLEALGORITHM_H_
+
+#include <sharp/global>
+
+#include <sharp/ITreeTupleAlgorithm.hpp>
+#include <sharp/ITupleSetCombiner.hpp>
+
+namespace sharp
+{
+	// Tuple variant of ConcurrentTreeAlgorithm: every algorithm writes into
+	// a set of its own, which the combiner merges into the node's output.
+	class SHARP_LOCAL ConcurrentTreeTupleAlgorithm : public ITreeTupleAlgorithm
+	{
+		TreeTupleAlgorithmVector algorithms_;
+		const ITupleSetCombiner &combiner_;
+
+	public:
+		ConcurrentTreeTupleAlgorithm(
+				const TreeTupleAlgorithmVector &algorithms,
+				const ITupleSetCombiner &combiner);
+
+		virtual ~ConcurrentTreeTupleAlgorithm() override;
+
+		virtual std::vector<const htd::ILabelingFunction *>
+			preprocessOperations() const override;
+
+		virtual void evaluateNode(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				INodeTupleSetMap &tuples,
+				const IInstance &instance,
+				ITupleSet &outputTuples) const override;
+
+		virtual bool needAllTupleSets() const override;
+
+	}; // class ConcurrentTreeTupleAlgorithm
+
+} // namespace sharp
+
+#endif // SHARP_CONCURRENTTREETUPLEALGORITHM_H_
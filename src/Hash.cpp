@@ -3,121 +3,100 @@
 #endif
 
 #include <sharp/Hash.hpp>
-#include <climits>
-#include <cassert>
+
+#include <cstring>
 
 namespace sharp
 {
 	using std::size_t;
-	using std::uint_least32_t;
+	using std::uint64_t;
+
+	const uint64_t Hash::FNV_OFFSET;
+	const uint64_t Hash::FNV_PRIME;
+	const uint64_t Hash::MIX_FACTOR;
 
 	namespace
 	{
-		const size_t HASH_OFFSET =
-			sizeof(size_t) >= 8 ? 1099511628211u :
-			(sizeof(size_t) >= 4 ? 16777619u : 0u);
-
-		const size_t HASH_PRIME =
-			sizeof(size_t) >= 8 ? 14695981039346656037u :
-			(sizeof(size_t) >= 4 ? 2166136261u : 0u);
-
-		const size_t CHUNK_SIZE = CHAR_BIT;
+		// rows hashed side by side in hashRows()
+		const size_t LANES = 8;
 	}
-	
+
 	Hash::Hash()
-		: hash_(HASH_OFFSET),
-		  unorderedXor_(HASH_OFFSET),
-		  unorderedSum_(0)
+		: state_(FNV_OFFSET)
 	{ }
 
 	Hash::~Hash() { }
 
-	void Hash::add(uint_least32_t data)
+	void Hash::add(const void *data, size_t size)
 	{
-		size_t size = sizeof(uint_least32_t);
-		for(size_t shift = 0; shift < size; ++shift)
-			this->add((unsigned char) (data >> (shift * CHUNK_SIZE)));
-	}
-
-	void Hash::add(size_t data)
-	{
-		size_t size = sizeof(size_t);
-
-		for(size_t shift = 0; shift < size; ++shift)
-			this->add((unsigned char) (data >> (shift * CHUNK_SIZE)));
-	}
-
-	void Hash::add(unsigned char data)
-	{
-		hash_ ^= (size_t)data;
-		//FIXME: use optimized version of *= via += and <<
-		hash_ *= HASH_PRIME; 
+		const unsigned char *bytes = static_cast<const unsigned char *>(data);
+		size_t words = size / sizeof(uint64_t);
+		for(size_t i = 0; i < words; ++i)
+		{
+			uint64_t word;
+			std::memcpy(&word, bytes + i * sizeof(uint64_t), sizeof(word));
+			state_ = mix(state_, word);
+		}
+
+		size_t rest = size % sizeof(uint64_t);
+		if(rest)
+		{
+			uint64_t word = 0;
+			std::memcpy(&word, bytes + words * sizeof(uint64_t), rest);
+			state_ = mix(state_, word);
+		}
+
+		state_ = mix(state_, size);
 	}
 
 	void Hash::reset()
 	{
-		hash_ = HASH_OFFSET;
-	}
-
-	void Hash::addUnordered(uint_least32_t data)
-	{
-		size_t hashtmp = hash_;
-		reset();
-		add(data);
-		unorderedXor_ ^= get();
-		unorderedSum_ += get();
-		hash_ = hashtmp;
-	}
-
-
-	void Hash::addUnordered(size_t data)
-	{
-		size_t hashtmp = hash_;
-		reset();
-		add(data);
-		unorderedXor_ ^= get();
-		unorderedSum_ += get();
-		hash_ = hashtmp;
-	}
-
-	void Hash::addUnordered(unsigned char data)
-	{
-		size_t hashtmp = hash_;
-		reset();
-		add(data);
-		unorderedXor_ ^= get();
-		unorderedSum_ += get();
-		hash_ = hashtmp;
+		state_ = FNV_OFFSET;
 	}
 
 	void Hash::incorporateUnordered()
 	{
-		this->add(unorderedXor_);
-		this->add(unorderedSum_);
+		this->add(unordered_.get());
 		this->resetUnordered();
 	}
 
 	void Hash::resetUnordered()
 	{
-		unorderedXor_ = HASH_OFFSET;
-		unorderedSum_ = 0;
-	}
-
-	size_t Hash::get() const
-	{
-		//assert(false);
-		return hash_;
+		unordered_.reset();
 	}
 
-	size_t Hash::getUnordered() //const
+	void Hash::hashRows(
+			const uint64_t *rows,
+			size_t wordCount,
+			size_t rowCount,
+			size_t *hashes)
 	{
-		size_t hashtmp = hash_;
-		reset();
-		add(unorderedXor_);
-		add(unorderedSum_);
-		size_t retHash = get();
-		hash_ = hashtmp;
-		return retHash;
+		const uint64_t byteCount = wordCount * sizeof(uint64_t);
+		size_t row = 0;
+
+		for(; row + LANES <= rowCount; row += LANES)
+		{
+			const uint64_t *block = rows + row * wordCount;
+			uint64_t state[LANES];
+			for(size_t lane = 0; lane < LANES; ++lane)
+				state[lane] = FNV_OFFSET;
+			for(size_t word = 0; word < wordCount; ++word)
+				for(size_t lane = 0; lane < LANES; ++lane)
+					state[lane] = mix(state[lane],
+							block[lane * wordCount + word]);
+			for(size_t lane = 0; lane < LANES; ++lane)
+				hashes[row + lane] = static_cast<size_t>(
+						finalize(mix(state[lane], byteCount)));
+		}
+
+		for(; row < rowCount; ++row)
+		{
+			uint64_t state = FNV_OFFSET;
+			for(size_t word = 0; word < wordCount; ++word)
+				state = mix(state, rows[row * wordCount + word]);
+			hashes[row] = static_cast<size_t>(
+					finalize(mix(state, byteCount)));
+		}
 	}
 
 } // namespace sharp
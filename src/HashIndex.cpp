@@ -0,0 +1,107 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include "HashIndex.hpp"
+
+#include "util/concurrent.hpp"
+
+#include <climits>
+#include <cstdint>
+
+namespace sharp
+{
+	using std::size_t;
+	using std::vector;
+
+	const size_t HashIndex::NIL;
+	const unsigned int HashIndex::WORD_BITS = sizeof(size_t) * CHAR_BIT;
+
+	HashIndex::HashIndex(
+			const TupleVector &tuples,
+			const vector<size_t> &hashes)
+		: tuples_(tuples), hashes_(hashes), skip_(0), bits_(1)
+	{
+		vector<size_t> members(tuples.size());
+		for(size_t i = 0; i < members.size(); ++i)
+			members[i] = i;
+		this->build(members);
+	}
+
+	HashIndex::HashIndex(
+			const TupleVector &tuples,
+			const vector<size_t> &hashes,
+			const vector<size_t> &members,
+			unsigned int skip)
+		: tuples_(tuples), hashes_(hashes), skip_(skip), bits_(1)
+	{
+		this->build(members);
+	}
+
+	HashIndex::~HashIndex() { }
+
+	void HashIndex::build(const vector<size_t> &members)
+	{
+		while(bits_ + skip_ < WORD_BITS
+				&& (size_t(1) << bits_) < members.size())
+			++bits_;
+
+		heads_.assign(size_t(1) << bits_, NIL);
+		members_.reserve(members.size());
+		next_.reserve(members.size());
+
+		for(size_t member : members)
+		{
+			size_t &head = heads_[bucket(hashes_[member])];
+			next_.push_back(head);
+			head = members_.size();
+			members_.push_back(member);
+		}
+	}
+
+	size_t HashIndex::scramble(size_t hash)
+	{
+		return hash * static_cast<size_t>(UINT64_C(0x9E3779B97F4A7C15));
+	}
+
+	HashStatistics::Entry HashIndex::statistics(const std::string &name) const
+	{
+		vector<size_t> hashes;
+		hashes.reserve(members_.size());
+		for(size_t member : members_)
+			hashes.push_back(hashes_[member]);
+		HashStatistics::Entry entry =
+			HashStatistics::analyze(name, hashes, heads_.size());
+
+		vector<size_t> bucketSizes(heads_.size(), 0);
+		for(size_t bucket = 0; bucket < heads_.size(); ++bucket)
+			for(size_t link = heads_[bucket]; link != NIL; link = next_[link])
+				++bucketSizes[bucket];
+		HashStatistics::analyzeBuckets(entry, bucketSizes);
+		return entry;
+	}
+
+	HashIndex::TupleVector HashIndex::gather(const ITupleSet &tuples)
+	{
+		TupleVector result;
+		result.reserve(tuples.size());
+		tuples.forEach([&](const ITuple &tuple) { result.push_back(&tuple); });
+		return result;
+	}
+
+	vector<size_t> HashIndex::hashAll(
+			const TupleVector &tuples,
+			const HashJoin::KeyHash &hash,
+			unsigned int threadCount)
+	{
+		vector<size_t> hashes(tuples.size());
+		parallelFor(tuples.size(), threadCount,
+			[&](size_t begin, size_t end)
+			{
+				for(size_t i = begin; i < end; ++i)
+					hashes[i] = scramble(hash(*tuples[i]));
+			});
+		return hashes;
+	}
+
+} // namespace sharp
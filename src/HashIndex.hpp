@@ -0,0 +1,97 @@
+#ifndef SHARP_HASHINDEX_H_
+#define SHARP_HASHINDEX_H_
+
+#include <sharp/global>
+
+#include <sharp/HashJoin.hpp>
+#include <sharp/HashStatistics.hpp>
+#include <sharp/ITuple.hpp>
+#include <sharp/ITupleSet.hpp>
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace sharp
+{
+	// Chained hash index over a subset of a tuple vector, used by the join
+	// operators. Chains are kept in flat arrays, so building the index
+	// allocates three times in total instead of once per tuple.
+	//
+	// Hashes are expected in scrambled form (see scramble()): bucket and
+	// partition numbers are taken from their high bits, skipping the skip
+	// topmost bits that were already used for radix partitioning.
+	class SHARP_LOCAL HashIndex
+	{
+	public:
+		typedef std::vector<const ITuple *> TupleVector;
+
+		static const std::size_t NIL = static_cast<std::size_t>(-1);
+		static const unsigned int WORD_BITS;
+
+		HashIndex(
+				const TupleVector &tuples,
+				const std::vector<std::size_t> &hashes);
+
+		HashIndex(
+				const TupleVector &tuples,
+				const std::vector<std::size_t> &hashes,
+				const std::vector<std::size_t> &members,
+				unsigned int skip);
+
+		~HashIndex();
+
+		template<typename F>
+		void probe(
+				const ITuple &tuple,
+				std::size_t hash,
+				const HashJoin::KeyEqual &equal,
+				F f) const
+		{
+			for(std::size_t entry = heads_[bucket(hash)];
+					entry != NIL;
+					entry = next_[entry])
+			{
+				std::size_t member = members_[entry];
+				if(hashes_[member] == hash && equal(*tuples_[member], tuple))
+					f(*tuples_[member]);
+			}
+		}
+
+		// multiplying with an odd constant is a bijection, so scrambled
+		// hashes compare equal iff the original ones do, but their high bits
+		// depend on all bits of the original hash
+		static std::size_t scramble(std::size_t hash);
+
+		// bucket occupancy of the index; tuples are not compared, so equal
+		// hashes count as collisions
+		HashStatistics::Entry statistics(const std::string &name) const;
+
+		static TupleVector gather(const ITupleSet &tuples);
+
+		static std::vector<std::size_t> hashAll(
+				const TupleVector &tuples,
+				const HashJoin::KeyHash &hash,
+				unsigned int threadCount);
+
+	private:
+		void build(const std::vector<std::size_t> &members);
+
+		std::size_t bucket(std::size_t hash) const
+		{
+			return (hash << skip_) >> (WORD_BITS - bits_);
+		}
+
+		const TupleVector &tuples_;
+		const std::vector<std::size_t> &hashes_;
+		unsigned int skip_;
+		unsigned int bits_;
+		std::vector<std::size_t> heads_;
+		std::vector<std::size_t> members_;
+		std::vector<std::size_t> next_;
+
+	}; // class HashIndex
+
+} // namespace sharp
+
+#endif // SHARP_HASHINDEX_H_
@@ -0,0 +1,124 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <sharp/HashJoin.hpp>
+
+#include "HashIndex.hpp"
+#include "util/concurrent.hpp"
+
+#include <sharp/BenchmarkSession.hpp>
+#include <sharp/HashStatistics.hpp>
+#include <sharp/MultiwayJoin.hpp>
+
+#include <atomic>
+
+namespace sharp
+{
+	using std::size_t;
+	using std::vector;
+	using std::atomic;
+
+	HashJoin::HashJoin(const KeyHash &hash, const KeyEqual &equal)
+		: hash_(hash), equal_(equal), threadCount_(1)
+	{ }
+
+	HashJoin::~HashJoin() { }
+
+	void HashJoin::setThreadCount(unsigned int threadCount)
+	{
+		threadCount_ = threadCount == 0 ? 1 : threadCount;
+	}
+
+	unsigned int HashJoin::threadCount() const
+	{
+		return threadCount_;
+	}
+
+	void HashJoin::join(
+			const ITupleSet &left,
+			const ITupleSet &right,
+			const PairCallback &combine) const
+	{
+		BenchmarkSession *session = BenchmarkSession::currentDetailed();
+		BenchmarkSession::ScopedTimer timer(
+				session, "join", "hash join", BenchmarkSession::NO_NODE);
+
+		bool buildLeft = left.size() <= right.size();
+		HashIndex::TupleVector build =
+			HashIndex::gather(buildLeft ? left : right);
+		HashIndex::TupleVector probe =
+			HashIndex::gather(buildLeft ? right : left);
+
+		vector<size_t> buildHashes =
+			HashIndex::hashAll(build, hash_, threadCount_);
+		vector<size_t> probeHashes =
+			HashIndex::hashAll(probe, hash_, threadCount_);
+
+		auto emit = [&](const ITuple &match, const ITuple &tuple)
+		{
+			if(buildLeft)
+				combine(match, tuple);
+			else
+				combine(tuple, match);
+		};
+
+		if(threadCount_ <= 1
+				|| build.size() + probe.size() < PARALLEL_THRESHOLD)
+		{
+			HashIndex index(build, buildHashes);
+			BenchmarkSession *current = BenchmarkSession::current();
+			if(current && current->hashStatistics().enabled())
+				current->hashStatistics().record(
+						index.statistics("hash join"));
+			for(size_t i = 0; i < probe.size(); ++i)
+				index.probe(*probe[i], probeHashes[i], equal_,
+					[&](const ITuple &match) { emit(match, *probe[i]); });
+			return;
+		}
+
+		// radix-partition both sides on the top bits of the scrambled hash,
+		// with a few partitions per thread to even out skew
+		unsigned int partitionBits = 0;
+		while((1u << partitionBits) < threadCount_ * 4)
+			++partitionBits;
+		size_t partitionCount = size_t(1) << partitionBits;
+		unsigned int shift = HashIndex::WORD_BITS - partitionBits;
+
+		vector<vector<size_t> > buildPartitions(partitionCount);
+		vector<vector<size_t> > probePartitions(partitionCount);
+		for(size_t i = 0; i < build.size(); ++i)
+			buildPartitions[buildHashes[i] >> shift].push_back(i);
+		for(size_t i = 0; i < probe.size(); ++i)
+			probePartitions[probeHashes[i] >> shift].push_back(i);
+
+		atomic<size_t> nextPartition(0);
+		runConcurrently(threadCount_, [&](size_t)
+		{
+			BenchmarkSession::ScopedTimer timer(session, "join",
+					"hash join partitions", BenchmarkSession::NO_NODE);
+			size_t partition;
+			while((partition = nextPartition++) < partitionCount)
+			{
+				if(probePartitions[partition].empty()) continue;
+
+				HashIndex index(build, buildHashes,
+						buildPartitions[partition], partitionBits);
+				for(size_t i : probePartitions[partition])
+					index.probe(*probe[i], probeHashes[i], equal_,
+						[&](const ITuple &match) { emit(match, *probe[i]); });
+			}
+		});
+	}
+
+	void HashJoin::join(
+			const vector<const ITupleSet *> &children,
+			const TupleCallback &combine) const
+	{
+		BenchmarkSession::ScopedTimer timer(
+				BenchmarkSession::currentDetailed(), "join", "multiway join",
+				BenchmarkSession::NO_NODE);
+		MultiwayJoin(children, hash_, equal_, threadCount_).forEach(combine);
+	}
+
+} // namespace sharp
@@ -0,0 +1,179 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <sharp/HashStatistics.hpp>
+
+#include "util/output.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace sharp
+{
+	using std::size_t;
+	using std::string;
+	using std::vector;
+	using std::endl;
+	using std::ios;
+
+	namespace
+	{
+		size_t defaultBucketCount(size_t elements, size_t bucketCount)
+		{
+			if(bucketCount) return bucketCount;
+			size_t buckets = 1;
+			while(buckets < elements) buckets <<= 1;
+			return buckets;
+		}
+
+	} // namespace
+
+	double HashStatistics::Entry::loadFactor() const
+	{
+		return buckets ? elements / (double)buckets : 0.0;
+	}
+
+	double HashStatistics::Entry::distinctRatio() const
+	{
+		return elements ? distinctHashes / (double)elements : 1.0;
+	}
+
+	HashStatistics::HashStatistics() : enabled_(false) { }
+
+	void HashStatistics::enable(bool enabled)
+	{
+		enabled_ = enabled;
+	}
+
+	void HashStatistics::record(const Entry &entry)
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+		entries_.push_back(entry);
+	}
+
+	HashStatistics::Entry HashStatistics::analyze(
+			const string &name,
+			const ITupleSet &tuples,
+			size_t bucketCount)
+	{
+		Entry entry;
+		entry.name = name;
+		entry.elements = tuples.size();
+		entry.collisions = 0;
+
+		// per hash value, the unequal tuples seen so far
+		std::unordered_map<size_t, vector<const ITuple *> > groups;
+		vector<size_t> bucketSizes(
+				defaultBucketCount(entry.elements, bucketCount), 0);
+		tuples.forEach([&](const ITuple &tuple)
+		{
+			size_t hash = tuple.hash();
+			++bucketSizes[hash % bucketSizes.size()];
+
+			vector<const ITuple *> &group = groups[hash];
+			bool known = false;
+			for(const ITuple *other : group)
+				if((known = *other == tuple)) break;
+			if(known) return;
+			if(!group.empty()) ++entry.collisions;
+			group.push_back(&tuple);
+		});
+
+		entry.distinctHashes = groups.size();
+		analyzeBuckets(entry, bucketSizes);
+		return entry;
+	}
+
+	HashStatistics::Entry HashStatistics::analyze(
+			const string &name,
+			const vector<size_t> &hashes,
+			size_t bucketCount)
+	{
+		Entry entry;
+		entry.name = name;
+		entry.elements = hashes.size();
+
+		vector<size_t> sorted(hashes);
+		std::sort(sorted.begin(), sorted.end());
+		entry.distinctHashes =
+			std::unique(sorted.begin(), sorted.end()) - sorted.begin();
+		entry.collisions = entry.elements - entry.distinctHashes;
+
+		vector<size_t> bucketSizes(
+				defaultBucketCount(entry.elements, bucketCount), 0);
+		for(size_t hash : hashes)
+			++bucketSizes[hash % bucketSizes.size()];
+		analyzeBuckets(entry, bucketSizes);
+		return entry;
+	}
+
+	void HashStatistics::analyzeBuckets(
+			Entry &entry,
+			const vector<size_t> &bucketSizes)
+	{
+		size_t probes = 0;
+		entry.buckets = bucketSizes.size();
+		entry.occupiedBuckets = 0;
+		entry.maxProbeLength = 0;
+		for(size_t size : bucketSizes)
+		{
+			if(size) ++entry.occupiedBuckets;
+			entry.maxProbeLength = std::max(entry.maxProbeLength, size);
+			probes += size * (size + 1) / 2;
+		}
+		entry.meanProbeLength =
+			entry.elements ? probes / (double)entry.elements : 0.0;
+	}
+
+	vector<HashStatistics::Entry> HashStatistics::entries() const
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+		return entries_;
+	}
+
+	void HashStatistics::print(std::ostream &out, bool csv) const
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+		if(entries_.empty()) return;
+
+		StreamFormatGuard format(out);
+		out.setf(ios::fixed, ios::floatfield);
+		out.precision(2);
+
+		if(csv)
+			out << "name,elements,distinct,collisions,buckets,occupied,"
+				<< "load,maxprobe,meanprobe" << endl;
+		else
+			out << "hash statistics:" << endl;
+
+		for(const Entry &entry : entries_)
+		{
+			if(csv)
+				out << entry.name << ","
+					<< entry.elements << ","
+					<< entry.distinctHashes << ","
+					<< entry.collisions << ","
+					<< entry.buckets << ","
+					<< entry.occupiedBuckets << ","
+					<< entry.loadFactor() << ","
+					<< entry.maxProbeLength << ","
+					<< entry.meanProbeLength << endl;
+			else
+				out << entry.name << ": "
+					<< entry.elements << " elements, "
+					<< entry.distinctRatio() * 100 << "% distinct hashes, "
+					<< entry.collisions << " collisions, load "
+					<< entry.loadFactor() << ", probe length "
+					<< entry.meanProbeLength << " (mean) "
+					<< entry.maxProbeLength << " (max)" << endl;
+		}
+	}
+
+	void HashStatistics::clear()
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+		entries_.clear();
+	}
+
+} // namespace sharp
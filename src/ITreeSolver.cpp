@@ -0,0 +1,23 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <sharp/ITreeSolver.hpp>
+
+#include "SingleSolutionCursor.hpp"
+
+namespace sharp
+{
+	ISolutionCursor *ITreeSolver::enumerate(
+			const IInstance &instance,
+			const htd::ITreeDecomposition &decomposition) const
+	{
+		return new SingleSolutionCursor(this->solve(instance, decomposition));
+	}
+
+	ISolutionCursor *ITreeSolver::enumerate(const IInstance &instance) const
+	{
+		return new SingleSolutionCursor(this->solve(instance));
+	}
+
+} // namespace sharp
@@ -7,6 +7,7 @@
 #include "NodeTableMapOverlay.hpp"
 
 #include <memory>
+#include <stdexcept>
 
 namespace sharp
 {
@@ -16,13 +17,34 @@ namespace sharp
 
 	using std::unique_ptr;
 	using std::vector;
+	using std::size_t;
 
 	InterleavedTreeAlgorithm::InterleavedTreeAlgorithm(
 			const ITreeAlgorithm &algorithm1,
 			const ITreeAlgorithm &algorithm2)
-		: algorithm1_(algorithm1), algorithm2_(algorithm2)
+		: InterleavedTreeAlgorithm(
+				TreeAlgorithmVector { &algorithm1, &algorithm2 })
 	{ }
 
+	InterleavedTreeAlgorithm::InterleavedTreeAlgorithm(
+			const TreeAlgorithmVector &algorithms)
+	{
+		if(algorithms.empty())
+			throw std::invalid_argument("Need at least one algorithm.");
+
+		for(const ITreeAlgorithm *algorithm : algorithms)
+		{
+			const InterleavedTreeAlgorithm *nested =
+				dynamic_cast<const InterleavedTreeAlgorithm *>(algorithm);
+			if(nested)
+				algorithms_.insert(algorithms_.end(),
+						nested->algorithms_.begin(),
+						nested->algorithms_.end());
+			else
+				algorithms_.push_back(algorithm);
+		}
+	}
+
 	InterleavedTreeAlgorithm::~InterleavedTreeAlgorithm() { }
 
 	vector<const ILabelingFunction *>
@@ -38,24 +60,32 @@ namespace sharp
 			INodeTableMap &tables,
 			const IInstance &instance) const
 	{
-		unique_ptr<ITable> table1(algorithm1_.evaluateNode(
+		unique_ptr<ITable> table(algorithms_[0]->evaluateNode(
 					node,
 					decomposition,
 					tables,
 					instance));
 
-		NodeTableMapOverlay overlay(tables, node, *table1);
+		NodeTableMapOverlay overlay(tables);
+		for(size_t stage = 1; stage < algorithms_.size() && table; ++stage)
+		{
+			overlay.replace(node, *table);
+			table.reset(algorithms_[stage]->evaluateNode(
+					node,
+					decomposition,
+					overlay,
+					instance));
+		}
 
-		return algorithm2_.evaluateNode(
-				node,
-				decomposition,
-				overlay,
-				instance);
+		return table.release();
 	}
 
 	bool InterleavedTreeAlgorithm::needAllTables() const
 	{
-		return algorithm1_.needAllTables() || algorithm2_.needAllTables();
+		for(const ITreeAlgorithm *algorithm : algorithms_)
+			if(algorithm->needAllTables())
+				return true;
+		return false;
 	}
 
 } // namespace sharp
@@ -7,16 +7,21 @@
 
 namespace sharp
 {
+	// Runs any number of algorithms one after the other on each node; each
+	// stage sees the table of the previous one in place of the node's
+	// table. Nested interleaved algorithms are flattened into one list of
+	// stages, and all stages share a single flat overlay.
 	class SHARP_LOCAL InterleavedTreeAlgorithm : public ITreeAlgorithm
 	{
-		const ITreeAlgorithm &algorithm1_;
-		const ITreeAlgorithm &algorithm2_;
+		TreeAlgorithmVector algorithms_;
 
 	public:
 		InterleavedTreeAlgorithm(
 				const ITreeAlgorithm &algorithm1,
 				const ITreeAlgorithm &algorithm2);
 
+		InterleavedTreeAlgorithm(const TreeAlgorithmVector &algorithms);
+
 		virtual ~InterleavedTreeAlgorithm() override;
 
 		virtual std::vector<const htd::ILabelingFunction *>
@@ -8,6 +8,7 @@
 #include "TupleSet.hpp"
 
 #include <memory>
+#include <stdexcept>
 
 namespace sharp
 {
@@ -17,13 +18,34 @@ namespace sharp
 
 	using std::unique_ptr;
 	using std::vector;
+	using std::size_t;
 
 	InterleavedTreeTupleAlgorithm::InterleavedTreeTupleAlgorithm(
 			const ITreeTupleAlgorithm &algorithm1,
 			const ITreeTupleAlgorithm &algorithm2)
-		: algorithm1_(algorithm1), algorithm2_(algorithm2)
+		: InterleavedTreeTupleAlgorithm(
+				TreeTupleAlgorithmVector { &algorithm1, &algorithm2 })
 	{ }
 
+	InterleavedTreeTupleAlgorithm::InterleavedTreeTupleAlgorithm(
+			const TreeTupleAlgorithmVector &algorithms)
+	{
+		if(algorithms.empty())
+			throw std::invalid_argument("Need at least one algorithm.");
+
+		for(const ITreeTupleAlgorithm *algorithm : algorithms)
+		{
+			const InterleavedTreeTupleAlgorithm *nested =
+				dynamic_cast<const InterleavedTreeTupleAlgorithm *>(algorithm);
+			if(nested)
+				algorithms_.insert(algorithms_.end(),
+						nested->algorithms_.begin(),
+						nested->algorithms_.end());
+			else
+				algorithms_.push_back(algorithm);
+		}
+	}
+
 	InterleavedTreeTupleAlgorithm::~InterleavedTreeTupleAlgorithm() { }
 
 	vector<const ILabelingFunction *>
@@ -40,28 +62,29 @@ namespace sharp
 			const IInstance &instance,
 			ITupleSet &outputTuples) const
 	{
-		//TupleSet intermediateOutputTuples;
-
-		algorithm1_.evaluateNode(
+		algorithms_[0]->evaluateNode(
 				node,
 				decomposition,
 				tuples,
-				instance, outputTuples);
-				//intermediateOutputTuples);
-
-		NodeTupleSetMapOverlay overlay(tuples, node, outputTuples); //intermediateOutputTuples);
-
-		algorithm2_.evaluateNode(
-				node,
-				decomposition,
-				overlay,
-				instance, 
+				instance,
 				outputTuples);
+
+		NodeTupleSetMapOverlay overlay(tuples, node, outputTuples);
+		for(size_t stage = 1; stage < algorithms_.size(); ++stage)
+			algorithms_[stage]->evaluateNode(
+					node,
+					decomposition,
+					overlay,
+					instance,
+					outputTuples);
 	}
 
 	bool InterleavedTreeTupleAlgorithm::needAllTupleSets() const
 	{
-		return algorithm1_.needAllTupleSets() || algorithm2_.needAllTupleSets();
+		for(const ITreeTupleAlgorithm *algorithm : algorithms_)
+			if(algorithm->needAllTupleSets())
+				return true;
+		return false;
 	}
 
 } // namespace sharp
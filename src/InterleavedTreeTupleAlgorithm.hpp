@@ -7,16 +7,21 @@
 
 namespace sharp
 {
+	// Runs any number of algorithms one after the other on each node; each
+	// stage sees the table of the previous one in place of the node's
+	// table. Nested interleaved algorithms are flattened into one list of
+	// stages, and all stages share a single flat overlay.
 	class SHARP_LOCAL InterleavedTreeTupleAlgorithm : public ITreeTupleAlgorithm
 	{
-		const ITreeTupleAlgorithm &algorithm1_;
-		const ITreeTupleAlgorithm &algorithm2_;
+		TreeTupleAlgorithmVector algorithms_;
 
 	public:
 		InterleavedTreeTupleAlgorithm(
 				const ITreeTupleAlgorithm &algorithm1,
 				const ITreeTupleAlgorithm &algorithm2);
 
+		InterleavedTreeTupleAlgorithm(const TreeTupleAlgorithmVector &algorithms);
+
 		virtual ~InterleavedTreeTupleAlgorithm() override;
 
 		virtual std::vector<const htd::ILabelingFunction *>
@@ -5,9 +5,21 @@
 #include "IterativeTreeSolver.hpp"
 
 #include "NullTreeSolutionExtractor.hpp"
+#include "ParallelSolutionExtraction.hpp"
+#include "SingleSolutionCursor.hpp"
+#include "TableOwningSolutionCursor.hpp"
 #include "NodeTableMap.hpp"
+#include "NodeTableMapOverlay.hpp"
+#include "NodeTupleSetMap.hpp"
+#include "util/concurrent.hpp"
 
 #include <sharp/Benchmark.hpp>
+#include <sharp/HashStatistics.hpp>
+#include <sharp/NodeProfiler.hpp>
+#include <sharp/PerfCounters.hpp>
+#include <sharp/ITreeTopDownSolutionExtractor.hpp>
+#include <sharp/ITreeSolutionEnumerator.hpp>
+#include <sharp/ITreeParallelSolutionExtractor.hpp>
 #include <htd/JoinNodeReplacementOperation.hpp>
 #include <htd/TreeDecompositionFactory.hpp>
 #include <htd/SemiNormalizationOperation.hpp>
@@ -15,8 +27,11 @@
 #include <htd/LimitChildCountOperation.hpp>
 #include <htd/TreeDecompositionVerifier.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <stack>
 #include <memory>
+#include <thread>
 #include <cstddef>
 
 
@@ -37,6 +52,41 @@ namespace sharp
 	using std::size_t;
 	using std::string;
 	using std::to_string;
+	using std::vector;
+
+	namespace
+	{
+		void recordStatistics(
+				HashStatistics &statistics,
+				const INodeTableMap &tables,
+				const string &name)
+		{
+			if(const NodeTableMap *map =
+					dynamic_cast<const NodeTableMap *>(&tables))
+				statistics.record(map->statistics(name));
+			else if(const NodeTupleSetMap *map =
+					dynamic_cast<const NodeTupleSetMap *>(&tables))
+				statistics.record(map->statistics(name));
+		}
+
+		void recordStatistics(
+				HashStatistics &statistics,
+				vertex_t node,
+				const ITable &table)
+		{
+			if(const ITupleSet *tuples =
+					dynamic_cast<const ITupleSet *>(&table))
+				statistics.record(HashStatistics::analyze(
+							"node " + to_string(node), *tuples));
+		}
+
+		unsigned int defaultThreadCount()
+		{
+			unsigned int threads = std::thread::hardware_concurrency();
+			return threads ? threads : 1;
+		}
+
+	} // namespace
 
 	IterativeTreeSolver::IterativeTreeSolver(
 			const htd::ITreeDecompositionAlgorithm &decomposer,
@@ -56,16 +106,40 @@ namespace sharp
 			std::unique_ptr<const ITreeSolutionExtractor> extractor,
 			bool deleteAlgorithms,
 			bool deleteExtractor)
+		: IterativeTreeSolver(decomposer,
+				std::move(algorithms),
+				std::vector<std::unique_ptr<const ITreeTopDownAlgorithm> >(),
+				std::move(extractor),
+				deleteAlgorithms,
+				deleteExtractor)
+	{ }
+
+	IterativeTreeSolver::IterativeTreeSolver(
+			const htd::ITreeDecompositionAlgorithm &decomposer,
+			std::vector<std::unique_ptr<const ITreeAlgorithm> > &&algorithms,
+			std::vector<std::unique_ptr<const ITreeTopDownAlgorithm> >
+				&&topDownAlgorithms,
+			std::unique_ptr<const ITreeSolutionExtractor> extractor,
+			bool deleteAlgorithms,
+			bool deleteExtractor)
 		: decomposer_(decomposer),
 		  extractor_(extractor.get()),
 		  manageAlgorithmMemory_(deleteAlgorithms),
-		  manageExtractorMemory_(deleteExtractor)
+		  manageExtractorMemory_(deleteExtractor),
+		  threadCount_(defaultThreadCount()),
+		  session_(nullptr)
 	{
 		for(std::unique_ptr<const ITreeAlgorithm> &alg : algorithms)
 			algorithms_.push_back(alg.get());
+		for(std::unique_ptr<const ITreeTopDownAlgorithm> &alg
+				: topDownAlgorithms)
+			topDownAlgorithms_.push_back(alg.get());
 
 		for(std::unique_ptr<const ITreeAlgorithm> &alg : algorithms)
 			alg.release();
+		for(std::unique_ptr<const ITreeTopDownAlgorithm> &alg
+				: topDownAlgorithms)
+			alg.release();
 		extractor.release();
 	}
 
@@ -89,7 +163,9 @@ namespace sharp
 		  algorithms_(algorithms),
 		  extractor_(new NullTreeSolutionExtractor()),
 		  manageAlgorithmMemory_(false),
-		  manageExtractorMemory_(true)
+		  manageExtractorMemory_(true),
+		  threadCount_(defaultThreadCount()),
+		  session_(nullptr)
 	{ }
 
 	IterativeTreeSolver::IterativeTreeSolver(
@@ -115,7 +191,24 @@ namespace sharp
 		  algorithms_(algorithms),
 		  extractor_(&extractor),
 		  manageAlgorithmMemory_(false),
-		  manageExtractorMemory_(false)
+		  manageExtractorMemory_(false),
+		  threadCount_(defaultThreadCount()),
+		  session_(nullptr)
+	{ }
+
+	IterativeTreeSolver::IterativeTreeSolver(
+			const htd::ITreeDecompositionAlgorithm &decomposer,
+			const TreeAlgorithmVector &algorithms,
+			const TreeTopDownAlgorithmVector &topDownAlgorithms,
+			const ITreeSolutionExtractor &extractor)
+		: decomposer_(decomposer),
+		  algorithms_(algorithms),
+		  topDownAlgorithms_(topDownAlgorithms),
+		  extractor_(&extractor),
+		  manageAlgorithmMemory_(false),
+		  manageExtractorMemory_(false),
+		  threadCount_(defaultThreadCount()),
+		  session_(nullptr)
 	{ }
 
 
@@ -125,6 +218,9 @@ namespace sharp
 			for(const ITreeAlgorithm *alg : algorithms_)
 				if(alg)
 					delete alg;
+		if(manageAlgorithmMemory_)
+			for(const ITreeTopDownAlgorithm *alg : topDownAlgorithms_)
+				delete alg;
 
 		if(manageExtractorMemory_ && extractor_) delete extractor_;
 	}
@@ -171,6 +267,9 @@ namespace sharp
 	ITreeDecomposition *IterativeTreeSolver::decompose(
 			const IInstance &instance, bool weak, unsigned int maxChilds, bool optimizedTD) const
 	{
+		BenchmarkSession::ScopedTimer timer(&this->benchmarkSession(),
+				"decomposition", "tree decomposition",
+				BenchmarkSession::NO_NODE);
         	htd::ITreeDecomposition * td = nullptr;
 		unique_ptr<IHypergraph> hg(instance.toHypergraph());
 		//TODO: include preprocessingOperations in decomposition call
@@ -296,51 +395,159 @@ namespace sharp
 		std::cout << std::endl << "AFTER NORMALIZATION" << std::endl << std::endl;
 		traversal.traverse(*td, [&](htd::vertex_t v, htd::vertex_t v2, size_t s){ std::cout << v << "[" << v2 << "]" << " @" << s << ": " << td->bagContent(v) << std::endl; });*/
 		}
-		Benchmark::registerTimestamp("tree decomposition time");
+		this->benchmarkSession().registerTimestamp(
+				"tree decomposition time");
 		assert(td->maximumBagSize() <= 15);
 		//assert(td->maximumBagSize() - 1 <= 15);
 		return td;
 	}
 
-	ISolution *IterativeTreeSolver::solve(
+	bool IterativeTreeSolver::evaluateAll(
+			const ITreeDecomposition &td,
 			const IInstance &instance,
-			const ITreeDecomposition &td) const
+			unique_ptr<INodeTableMap> &tables,
+			unique_ptr<INodeTableMap> &topDownTables) const
 	{
-		unique_ptr<INodeTableMap> tables = 
-			this->initializeMap(td.vertexCount());
+		// lets joins inside the algorithms find the session
+		BenchmarkSession::Activation activation(this->benchmarkSession());
+		HashStatistics &statistics = this->benchmarkSession().hashStatistics();
+		tables = this->initializeMap(td.vertexCount());
+
+		// bottom-up passes, followed by top-down passes
+		vector<const ITableReader *> readers;
+		for(const ITreeAlgorithm *alg : algorithms_)
+			readers.push_back(this->tableReader(*alg));
+		for(const ITreeTopDownAlgorithm *alg : topDownAlgorithms_)
+			readers.push_back(this->tableReader(*alg));
+		const ITableReader *extractorReader = this->tableReader(*extractor_);
 
-		vertex_t root = td.root();
 		bool success = true;
 		unsigned int pass = 1;
 		for(const ITreeAlgorithm *alg : algorithms_)
 		{
 			/*if (alg == *algorithms_.end())	//last one
 				alg->setPass(1);*/
-			if(!(success = this->evaluate(td, *alg, instance, *tables)))
-				break;
+			Retention retention;
+			retention.needAllTables = alg->needAllTables();
+			retention.reader = readers[pass - 1];
+			for(size_t later = pass; later < readers.size(); ++later)
+				if(readers[later])
+					retention.consumers.push_back(readers[later]);
+			if(extractorReader)
+				retention.consumers.push_back(extractorReader);
+
 			std::string passDesc("PASS ");
 			passDesc += ('0' + pass);
-			Benchmark::registerTimestamp(passDesc.c_str());
+			if(!(success = this->evaluate(
+							td, *alg, instance, *tables, retention, passDesc)))
+				break;
+			this->benchmarkSession().registerTimestamp(passDesc);
+			if(statistics.enabled())
+				recordStatistics(
+						statistics, *tables, "node table map, " + passDesc);
 			std::cout << std::endl << passDesc <<  " finished " << std::endl;
 			++pass;
 		}
+
+		if(success && !Benchmark::isInterrupt())
+			this->reduceTables(td, *tables);
+
+		if(success && !topDownAlgorithms_.empty())
+		{
+			topDownTables = this->initializeMap(td.vertexCount());
+			unsigned int topDownPass = 1;
+			for(const ITreeTopDownAlgorithm *alg : topDownAlgorithms_)
+			{
+				// bottom-up passes do not read the top-down tables
+				size_t reader = algorithms_.size() + topDownPass - 1;
+				Retention retention;
+				retention.needAllTables = alg->needAllTables();
+				retention.reader = readers[reader];
+				for(size_t later = reader + 1; later < readers.size(); ++later)
+					if(readers[later])
+						retention.consumers.push_back(readers[later]);
+				if(extractorReader)
+					retention.consumers.push_back(extractorReader);
+
+				string passDesc("TOP-DOWN PASS " + to_string(topDownPass));
+				if(!(success = this->evaluateTopDown(td, *alg, instance,
+								*tables, *topDownTables, retention, passDesc)))
+					break;
+				this->benchmarkSession().registerTimestamp(passDesc);
+				if(statistics.enabled())
+					recordStatistics(statistics, *topDownTables,
+							"top-down node table map, " + passDesc);
+				++topDownPass;
+			}
+		}
 			/*else
 				alg->forceSolution();
 				//cleanup solutions after every branch
 				for (auto &sol : (tables.get())[root])
 					sol.forceSolution(); //delete it and non extended children*/
 
-		Benchmark::registerTimestamp("solving time");
+		this->benchmarkSession().registerTimestamp("solving time");
+		return success;
+	}
+
+	ISolution *IterativeTreeSolver::extract(
+			const ITreeDecomposition &td,
+			const IInstance &instance,
+			const INodeTableMap &tables,
+			const INodeTableMap *topDownTables) const
+	{
+		if(const ITreeParallelSolutionExtractor *parallelExtractor =
+				dynamic_cast<const ITreeParallelSolutionExtractor *>(
+					extractor_))
+			return extractConcurrently(
+					*parallelExtractor, td, tables, instance, threadCount_);
+
+		const ITreeTopDownSolutionExtractor *topDownExtractor =
+			topDownTables
+				? dynamic_cast<const ITreeTopDownSolutionExtractor *>(
+					extractor_)
+				: nullptr;
+
+		if(topDownExtractor)
+			return topDownExtractor->extractSolution(
+					td.root(), td, tables, *topDownTables, instance);
+		return extractor_->extractSolution(td.root(), td, tables, instance);
+	}
+
+	ISolution *IterativeTreeSolver::solve(
+			const IInstance &instance,
+			const ITreeDecomposition &td) const
+	{
+		unique_ptr<INodeTableMap> tables;
+		unique_ptr<INodeTableMap> topDownTables;
+		bool success = this->evaluateAll(td, instance, tables, topDownTables);
+
 		if (!Benchmark::isInterrupt())
 		{
 			ISolution *sol = nullptr;
 
 			if(success)
-				sol = extractor_->extractSolution(root, td, *tables, instance);
+			{
+				BenchmarkSession::ScopedTimer timer(&this->benchmarkSession(),
+						"extraction", "solution extraction",
+						BenchmarkSession::NO_NODE);
+				PerfCounters &perfCounters =
+					this->benchmarkSession().perfCounters();
+				PerfCounters::Sample counters;
+				if(perfCounters.enabled())
+					counters.start();
+
+				sol = this->extract(
+						td, instance, *tables, topDownTables.get());
+
+				if(perfCounters.enabled())
+					perfCounters.record("EXTRACTION", "extraction", counters);
+			}
 			else
 				sol = extractor_->emptySolution(instance);
 
-			Benchmark::registerTimestamp("solution extraction time");
+			this->benchmarkSession().registerTimestamp(
+					"solution extraction time");
 
 			return sol;
 		}
@@ -354,15 +561,100 @@ namespace sharp
 		return this->solve(instance, *td);
 	}
 
+	ISolutionCursor *IterativeTreeSolver::enumerate(
+			const IInstance &instance,
+			const ITreeDecomposition &td) const
+	{
+		return this->cursor(instance, td, unique_ptr<ITreeDecomposition>());
+	}
+
+	ISolutionCursor *IterativeTreeSolver::enumerate(
+			const IInstance &instance) const
+	{
+		unique_ptr<ITreeDecomposition> td(
+				this->decompose(instance, true, 3, false));
+		const ITreeDecomposition &decomposition = *td;
+		return this->cursor(instance, decomposition, std::move(td));
+	}
+
+	ISolutionCursor *IterativeTreeSolver::cursor(
+			const IInstance &instance,
+			const ITreeDecomposition &td,
+			unique_ptr<ITreeDecomposition> ownedDecomposition) const
+	{
+		unique_ptr<INodeTableMap> tables;
+		unique_ptr<INodeTableMap> topDownTables;
+		if(!this->evaluateAll(td, instance, tables, topDownTables)
+				|| Benchmark::isInterrupt())
+			return new SingleSolutionCursor(
+					extractor_->emptySolution(instance));
+
+		unique_ptr<ISolutionCursor> cursor(
+				this->enumerateSolutions(td, instance, *tables));
+		if(!cursor)
+		{
+			BenchmarkSession::ScopedTimer timer(&this->benchmarkSession(),
+					"extraction", "solution extraction",
+					BenchmarkSession::NO_NODE);
+			PerfCounters &perfCounters =
+				this->benchmarkSession().perfCounters();
+			PerfCounters::Sample counters;
+			if(perfCounters.enabled())
+				counters.start();
+
+			cursor.reset(new SingleSolutionCursor(this->extract(
+							td, instance, *tables, topDownTables.get())));
+
+			if(perfCounters.enabled())
+				perfCounters.record("EXTRACTION", "extraction", counters);
+		}
+
+		return new TableOwningSolutionCursor(
+				std::move(cursor),
+				std::move(tables),
+				std::move(topDownTables),
+				std::move(ownedDecomposition));
+	}
+
+	ISolutionCursor *IterativeTreeSolver::enumerateSolutions(
+			const ITreeDecomposition &td,
+			const IInstance &instance,
+			const INodeTableMap &tables) const
+	{
+		const ITreeSolutionEnumerator *enumerator =
+			dynamic_cast<const ITreeSolutionEnumerator *>(extractor_);
+		if(!enumerator)
+			return nullptr;
+		return enumerator->enumerateSolutions(td.root(), td, tables, instance);
+	}
+
+	void IterativeTreeSolver::setThreadCount(unsigned int threadCount)
+	{
+		threadCount_ = threadCount ? threadCount : 1;
+	}
+
+	void IterativeTreeSolver::setBenchmarkSession(BenchmarkSession *session)
+	{
+		session_ = session;
+	}
+
+	BenchmarkSession &IterativeTreeSolver::benchmarkSession() const
+	{
+		return session_ ? *session_ : Benchmark::session();
+	}
+
 	bool IterativeTreeSolver::evaluate(
 			const ITreeDecomposition &td,
 			const ITreeAlgorithm &algorithm,
 			const IInstance &instance,
-			INodeTableMap &tables) const
+			INodeTableMap &tables,
+			const Retention &retention,
+			const string &pass) const
 	{
-		bool needAllTables = /*
-			algorithms_.size() > 1 ||*/ algorithm.needAllTables();
-
+		BenchmarkSession &session = this->benchmarkSession();
+		NodeProfiler &profiler = session.nodeProfiler();
+		PerfCounters &perfCounters = session.perfCounters();
+		HashStatistics &statistics = session.hashStatistics();
 		bool finishedBranch = false;
 		vertex_t current = td.root();
 		ITable *currentTable = nullptr;
@@ -395,14 +687,44 @@ namespace sharp
 				continue;
 			}
 			current = top.first;
-			currentTable = algorithm.evaluateNode(
-											current,
-											td,
-											tables,
-											instance);
+
+			bool profile = profiler.enabled();
+			NodeProfiler::Entry profileEntry;
+			NodeProfiler::Probe probe;
+			if(profile)
+			{
+				profileEntry = NodeProfiler::begin(
+						pass, current, td, tables, false);
+				probe.start(true);
+			}
+
+			{
+				BenchmarkSession::ScopedTimer timer(
+						session.nodeTiming() ? &session : nullptr,
+						"evaluation", pass, current);
+				PerfCounters::Sample counters;
+				if(perfCounters.enabled())
+					counters.start();
+
+				currentTable = algorithm.evaluateNode(
+												current,
+												td,
+												tables,
+												instance);
+
+				if(perfCounters.enabled())
+					perfCounters.record(pass, NodeProfiler::typeName(
+								NodeProfiler::classify(current, td)), counters);
+			}
+
+			if(profile)
+				profiler.end(profileEntry, probe, currentTable);
+
+			if(currentTable && statistics.enabled())
+				recordStatistics(statistics, current, *currentTable);
 
 			if(currentTable) 
-				insertIntoMap(current, td, currentTable, tables, needAllTables);
+				insertIntoMap(current, td, currentTable, tables, retention);
 			else
 				return false;
 		}
@@ -410,6 +732,150 @@ namespace sharp
 		return true;
 	}
 
+	void IterativeTreeSolver::reduceTables(
+			const ITreeDecomposition &,
+			INodeTableMap &) const
+	{ }
+
+	bool IterativeTreeSolver::evaluateTopDown(
+			const ITreeDecomposition &td,
+			const ITreeTopDownAlgorithm &algorithm,
+			const IInstance &instance,
+			const INodeTableMap &bottomUpTables,
+			INodeTableMap &topDownTables,
+			const Retention &retention,
+			const string &pass) const
+	{
+		IMutableNodeTableMap &map =
+			dynamic_cast<IMutableNodeTableMap &>(topDownTables);
+		BenchmarkSession &session = this->benchmarkSession();
+		NodeProfiler &profiler = session.nodeProfiler();
+		PerfCounters &perfCounters = session.perfCounters();
+		HashStatistics &statistics = session.hashStatistics();
+
+		// nodes in breadth-first order, so the children of a node are
+		// consecutive
+		vector<vertex_t> nodes(1, td.root());
+		vector<size_t> parents(1, 0);
+		vector<size_t> firstChildren;
+		for(size_t i = 0; i < nodes.size(); ++i)
+		{
+			firstChildren.push_back(nodes.size());
+			size_t childCount = td.childCount(nodes[i]);
+			for(size_t childIndex = 0; childIndex < childCount; ++childIndex)
+			{
+				nodes.push_back(td.childAtPosition(nodes[i], childIndex));
+				parents.push_back(i);
+			}
+		}
+		firstChildren.push_back(nodes.size());
+
+		// tables that outlive the evaluation of the children of their node
+		vector<bool> retained(nodes.size());
+		for(size_t i = 0; i < nodes.size(); ++i)
+			retained[i] = this->retains(nodes[i], td, retention);
+
+		// A node is evaluated as soon as its parent is done. The new tables
+		// stay out of the map until the pass is over, so that the map is
+		// never written while it is being read; every node sees them
+		// through an overlay of the map instead.
+		vector<unique_ptr<ITable> > results(nodes.size());
+		// children of every node that have not been evaluated yet
+		vector<std::atomic<size_t> > remaining(nodes.size());
+		for(size_t i = 0; i < nodes.size(); ++i)
+			remaining[i] = firstChildren[i + 1] - firstChildren[i];
+		std::atomic<bool> failed(false);
+		bool profile = profiler.enabled();
+		size_t threadCount = std::min<size_t>(threadCount_, nodes.size());
+
+		TaskQueue queue;
+		queue.schedule(0);
+		queue.run(threadCount, [&](size_t i)
+		{
+			if(failed || Benchmark::isInterrupt())
+				return;
+
+			// the parent and every retained ancestor
+			vector<pair<vertex_t, const ITable *> > ancestors;
+			for(size_t ancestor = i; ancestor != 0; )
+			{
+				ancestor = parents[ancestor];
+				if(ancestor == parents[i] || retained[ancestor])
+					ancestors.push_back(make_pair(
+								nodes[ancestor], results[ancestor].get()));
+			}
+			unique_ptr<INodeTableMap> visibleTables =
+				this->overlayMap(topDownTables, ancestors);
+
+			NodeProfiler::Entry profileEntry;
+			NodeProfiler::Probe probe;
+			if(profile)
+			{
+				profileEntry = NodeProfiler::begin(
+						pass, nodes[i], td, *visibleTables, true);
+				// the heap is only attributable to this node if no other
+				// node is evaluated at the same time
+				probe.start(threadCount == 1);
+			}
+
+			BenchmarkSession::Activation activation(session);
+			{
+				BenchmarkSession::ScopedTimer timer(
+						session.nodeTiming() ? &session : nullptr,
+						"evaluation", pass, nodes[i]);
+				PerfCounters::Sample counters;
+				if(perfCounters.enabled())
+					counters.start();
+
+				results[i].reset(algorithm.evaluateNode(
+							nodes[i],
+							td,
+							bottomUpTables,
+							*visibleTables,
+							instance));
+
+				if(perfCounters.enabled())
+					perfCounters.record(pass, NodeProfiler::typeName(
+								NodeProfiler::classify(nodes[i], td)),
+							counters);
+			}
+
+			if(profile)
+				profiler.end(profileEntry, probe, results[i].get());
+
+			if(!results[i])
+			{
+				failed = true;
+				return;
+			}
+			if(statistics.enabled())
+				recordStatistics(statistics, nodes[i], *results[i]);
+
+			for(size_t child = firstChildren[i];
+					child < firstChildren[i + 1]; ++child)
+				queue.schedule(child);
+
+			// the last child to finish drops the parent's table unless it
+			// is retained
+			if(i != 0 && --remaining[parents[i]] == 0
+					&& !retained[parents[i]])
+				results[parents[i]].reset();
+		});
+
+		if(failed || Benchmark::isInterrupt())
+			return false;
+
+		for(size_t i = 0; i < nodes.size(); ++i)
+		{
+			if(results[i])
+				map.insert(nodes[i], results[i].release());
+			else
+				map.erase(nodes[i]);
+		}
+
+		return true;
+	}
+
 	unique_ptr<INodeTableMap> IterativeTreeSolver::initializeMap(
 			size_t decompositionNodeCount) const
 	{
@@ -417,26 +883,74 @@ namespace sharp
 				new NodeTableMap(decompositionNodeCount));
 	}
 
+	unique_ptr<INodeTableMap> IterativeTreeSolver::overlayMap(
+			const INodeTableMap &tables,
+			const vector<pair<vertex_t, const ITable *> > &replacements) const
+	{
+		NodeTableMapOverlay *overlay = new NodeTableMapOverlay(tables);
+		unique_ptr<INodeTableMap> map(overlay);
+		for(const pair<vertex_t, const ITable *> &replacement : replacements)
+			overlay->replace(replacement.first, *replacement.second);
+		return map;
+	}
+
 	void IterativeTreeSolver::insertIntoMap(
 			vertex_t node,
 			const ITreeDecomposition &td,
 			ITable *table,
 			INodeTableMap &tables,
-			bool needAllTables) const
+			const Retention &retention) const
 	{
 		IMutableNodeTableMap &map =
 			dynamic_cast<IMutableNodeTableMap &>(tables);
 
 		if (!map.contains(node))
 			map.insert(node, table);
-		
-		if(!needAllTables)
+		else if(&map[node] != table)
+			delete table;
+
+		size_t childCount = td.childCount(node);
+		for(size_t childIndex = 0; childIndex < childCount; ++childIndex)
 		{
-			//assert(false);
-			size_t childCount = td.childCount(node);
-			for(size_t childIndex = 0; childIndex < childCount; ++childIndex)
-				map.erase(td.childAtPosition(node, childIndex));
+			vertex_t child = td.childAtPosition(node, childIndex);
+			if(!this->retains(child, td, retention))
+				map.erase(child);
 		}
 	}
 
+	bool IterativeTreeSolver::retains(
+			vertex_t node,
+			const ITreeDecomposition &td,
+			const Retention &retention) const
+	{
+		if(retention.reader
+				? retention.reader->readsTable(node, td)
+				: retention.needAllTables)
+			return true;
+
+		for(const ITableReader *consumer : retention.consumers)
+			if(consumer->readsTable(node, td))
+				return true;
+
+		return false;
+	}
+
+	const ITableReader *IterativeTreeSolver::tableReader(
+			const ITreeAlgorithm &algorithm) const
+	{
+		return dynamic_cast<const ITableReader *>(&algorithm);
+	}
+
+	const ITableReader *IterativeTreeSolver::tableReader(
+			const ITreeTopDownAlgorithm &algorithm) const
+	{
+		return dynamic_cast<const ITableReader *>(&algorithm);
+	}
+
+	const ITableReader *IterativeTreeSolver::tableReader(
+			const ITreeSolutionExtractor &extractor) const
+	{
+		return dynamic_cast<const ITableReader *>(&extractor);
+	}
+
 } // namespace sharp
@@ -5,13 +5,18 @@
 
 #include <sharp/ITreeSolver.hpp>
 #include <sharp/ITreeAlgorithm.hpp>
+#include <sharp/ITreeTopDownAlgorithm.hpp>
 #include <sharp/IInstance.hpp>
 #include <sharp/ISolution.hpp>
 #include <sharp/ITreeSolutionExtractor.hpp>
+#include <sharp/ITableReader.hpp>
 
 #include <htd/main.hpp>
 
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace sharp
 {
@@ -39,6 +44,15 @@ namespace sharp
 				bool deleteAlgorithms,
 				bool deleteExtractor);
 
+		IterativeTreeSolver(
+				const htd::ITreeDecompositionAlgorithm &decomposer,
+				std::vector<std::unique_ptr<const ITreeAlgorithm> > &&algorithms,
+				std::vector<std::unique_ptr<const ITreeTopDownAlgorithm> >
+					&&topDownAlgorithms,
+				std::unique_ptr<const ITreeSolutionExtractor> extractor,
+				bool deleteAlgorithms,
+				bool deleteExtractor);
+
 	public:
 		IterativeTreeSolver(
 				const htd::ITreeDecompositionAlgorithm &decomposer,
@@ -69,6 +83,13 @@ namespace sharp
 				const TreeAlgorithmVector &algorithms,
 				const ITreeSolutionExtractor &extractor);
 
+		// runs the top-down passes after the bottom-up passes
+		IterativeTreeSolver(
+				const htd::ITreeDecompositionAlgorithm &decomposer,
+				const TreeAlgorithmVector &algorithms,
+				const TreeTopDownAlgorithmVector &topDownAlgorithms,
+				const ITreeSolutionExtractor &extractor);
+
 		virtual ~IterativeTreeSolver() override;
 
 		virtual htd::ITreeDecomposition *decompose(
@@ -80,28 +101,120 @@ namespace sharp
 				const IInstance &instance,
 				const htd::ITreeDecomposition &decomposition) const override;
 
+		virtual ISolutionCursor *enumerate(
+				const IInstance &instance,
+				const htd::ITreeDecomposition &decomposition) const override;
+
+		virtual ISolutionCursor *enumerate(
+				const IInstance &instance) const override;
+
+		virtual void setThreadCount(unsigned int threadCount) override;
+
+		virtual void setBenchmarkSession(BenchmarkSession *session) override;
+
 	private:
+		// decides which child tables outlive the evaluation of their parent
+		struct Retention
+		{
+			// the current pass, used if it is no ITableReader
+			bool needAllTables;
+			// the current pass, if it is an ITableReader
+			const ITableReader *reader;
+			// later passes and the extractor that are ITableReaders
+			std::vector<const ITableReader *> consumers;
+		};
+
 		virtual std::unique_ptr<INodeTableMap> initializeMap(
 				std::size_t decompositionNodeCount) const;
 
+		// read-only view of tables in which the nodes of replacements map
+		// to the given tables instead
+		virtual std::unique_ptr<INodeTableMap> overlayMap(
+				const INodeTableMap &tables,
+				const std::vector<std::pair<htd::vertex_t, const ITable *> >
+					&replacements) const;
+
+		virtual const ITableReader *tableReader(
+				const ITreeAlgorithm &algorithm) const;
+
+		virtual const ITableReader *tableReader(
+				const ITreeTopDownAlgorithm &algorithm) const;
+
+		virtual const ITableReader *tableReader(
+				const ITreeSolutionExtractor &extractor) const;
+
 		void insertIntoMap(
 				htd::vertex_t node,
 				const htd::ITreeDecomposition &decomposition,
 				ITable *table,
 				INodeTableMap &tables,
-				bool needAllTables) const;
+				const Retention &retention) const;
+
+		// the session set by setBenchmarkSession(), or Benchmark::session()
+		BenchmarkSession &benchmarkSession() const;
+
+		bool retains(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				const Retention &retention) const;
 
 		bool evaluate(
 				const htd::ITreeDecomposition &decomposition,
 				const ITreeAlgorithm &algorithm,
 				const IInstance &instance,
+				INodeTableMap &tables,
+				const Retention &retention,
+				const std::string &pass) const;
+
+		// runs all passes; tables and topDownTables receive the maps
+		bool evaluateAll(
+				const htd::ITreeDecomposition &decomposition,
+				const IInstance &instance,
+				std::unique_ptr<INodeTableMap> &tables,
+				std::unique_ptr<INodeTableMap> &topDownTables) const;
+
+		// uses the most specific extractor interface available
+		virtual ISolution *extract(
+				const htd::ITreeDecomposition &decomposition,
+				const IInstance &instance,
+				const INodeTableMap &tables,
+				const INodeTableMap *topDownTables) const;
+
+		// ownedDecomposition is either empty or owns decomposition
+		ISolutionCursor *cursor(
+				const IInstance &instance,
+				const htd::ITreeDecomposition &decomposition,
+				std::unique_ptr<htd::ITreeDecomposition> ownedDecomposition)
+			const;
+
+		// nullptr if the extractor is no ITreeSolutionEnumerator
+		virtual ISolutionCursor *enumerateSolutions(
+				const htd::ITreeDecomposition &decomposition,
+				const IInstance &instance,
+				const INodeTableMap &tables) const;
+
+		// runs between the bottom-up and the top-down passes
+		virtual void reduceTables(
+				const htd::ITreeDecomposition &decomposition,
 				INodeTableMap &tables) const;
+
+		bool evaluateTopDown(
+				const htd::ITreeDecomposition &decomposition,
+				const ITreeTopDownAlgorithm &algorithm,
+				const IInstance &instance,
+				const INodeTableMap &bottomUpTables,
+				INodeTableMap &topDownTables,
+				const Retention &retention,
+				const std::string &pass) const;
 		
 		const htd::ITreeDecompositionAlgorithm &decomposer_;
 		TreeAlgorithmVector algorithms_;
+		TreeTopDownAlgorithmVector topDownAlgorithms_;
 		const ITreeSolutionExtractor *extractor_;
 		bool manageAlgorithmMemory_;
 		bool manageExtractorMemory_;
+		unsigned int threadCount_;
+		BenchmarkSession *session_;
 
 	}; // class IterativeTreeSolver
 
@@ -5,9 +5,15 @@
 #include "IterativeTreeTupleSolver.hpp"
 
 #include "NodeTupleSetMap.hpp"
+#include "NodeTupleSetMapOverlay.hpp"
+#include "ParallelSolutionExtraction.hpp"
+#include "SemiJoinReducer.hpp"
 #include "TupleSet.hpp"
 
 #include <sharp/Benchmark.hpp>
+#include <sharp/ITupleProjection.hpp>
+#include <sharp/ITreeTupleSolutionEnumerator.hpp>
+#include <sharp/ITreeTupleParallelSolutionExtractor.hpp>
 
 #include <stack>
 #include <memory>
@@ -22,6 +28,8 @@ namespace sharp
 
 	using std::size_t;
 	using std::unique_ptr;
+	using std::vector;
+	using std::pair;
 
 	IterativeTreeTupleSolver::IterativeTreeTupleSolver(
 			const htd::ITreeDecompositionAlgorithm &decomposer,
@@ -72,6 +80,21 @@ namespace sharp
 				true)
 	{ }
 
+	IterativeTreeTupleSolver::IterativeTreeTupleSolver(
+			const htd::ITreeDecompositionAlgorithm &decomposer,
+			const TreeTupleAlgorithmVector &algorithms,
+			const TreeTupleTopDownAlgorithmVector &topDownAlgorithms,
+			const ITreeTupleSolutionExtractor &extractor)
+		: IterativeTreeSolver(
+				decomposer,
+				convertAlgorithmList(algorithms),
+				convertAlgorithmList(topDownAlgorithms),
+				std::unique_ptr<const ITreeSolutionExtractor>(
+					new TupleToTreeSolutionExtractorAdapter(extractor)),
+				true,
+				true)
+	{ }
+
 	IterativeTreeTupleSolver::~IterativeTreeTupleSolver() { }
 
 	unique_ptr<INodeTableMap> IterativeTreeTupleSolver::initializeMap(
@@ -81,6 +104,115 @@ namespace sharp
 				new NodeTupleSetMap(decompositionNodeCount));
 	}
 
+	unique_ptr<INodeTableMap> IterativeTreeTupleSolver::overlayMap(
+			const INodeTableMap &tables,
+			const vector<pair<vertex_t, const ITable *> > &replacements) const
+	{
+		NodeTupleSetMapOverlay *overlay = new NodeTupleSetMapOverlay(
+				dynamic_cast<const INodeTupleSetMap &>(tables));
+		unique_ptr<INodeTableMap> map(overlay);
+		for(const pair<vertex_t, const ITable *> &replacement : replacements)
+			overlay->replace(replacement.first,
+					dynamic_cast<const ITupleSet &>(*replacement.second));
+		return map;
+	}
+
+	const ITableReader *IterativeTreeTupleSolver::tableReader(
+			const ITreeAlgorithm &algorithm) const
+	{
+		if(const TupleToTreeAlgorithmAdapter *adapter =
+				dynamic_cast<const TupleToTreeAlgorithmAdapter *>(&algorithm))
+			return dynamic_cast<const ITableReader *>(&adapter->adaptee());
+		return IterativeTreeSolver::tableReader(algorithm);
+	}
+
+	const ITableReader *IterativeTreeTupleSolver::tableReader(
+			const ITreeTopDownAlgorithm &algorithm) const
+	{
+		if(const TupleToTreeTopDownAlgorithmAdapter *adapter =
+				dynamic_cast<const TupleToTreeTopDownAlgorithmAdapter *>(
+					&algorithm))
+			return dynamic_cast<const ITableReader *>(&adapter->adaptee());
+		return IterativeTreeSolver::tableReader(algorithm);
+	}
+
+	const ITableReader *IterativeTreeTupleSolver::tableReader(
+			const ITreeSolutionExtractor &extractor) const
+	{
+		if(const TupleToTreeSolutionExtractorAdapter *adapter =
+				dynamic_cast<const TupleToTreeSolutionExtractorAdapter *>(
+					&extractor))
+			return dynamic_cast<const ITableReader *>(&adapter->adaptee());
+		return IterativeTreeSolver::tableReader(extractor);
+	}
+
+	ISolution *IterativeTreeTupleSolver::extract(
+			const ITreeDecomposition &td,
+			const IInstance &instance,
+			const INodeTableMap &tables,
+			const INodeTableMap *topDownTables) const
+	{
+		const TupleToTreeSolutionExtractorAdapter *adapter =
+			dynamic_cast<const TupleToTreeSolutionExtractorAdapter *>(
+					extractor_);
+		const ITreeTupleParallelSolutionExtractor *parallelExtractor = adapter
+			? dynamic_cast<const ITreeTupleParallelSolutionExtractor *>(
+					&adapter->adaptee())
+			: nullptr;
+		if(!parallelExtractor)
+			return IterativeTreeSolver::extract(
+					td, instance, tables, topDownTables);
+
+		return extractConcurrently(
+				*parallelExtractor,
+				td,
+				dynamic_cast<const INodeTupleSetMap &>(tables),
+				instance,
+				threadCount_);
+	}
+
+	ISolutionCursor *IterativeTreeTupleSolver::enumerateSolutions(
+			const ITreeDecomposition &td,
+			const IInstance &instance,
+			const INodeTableMap &tables) const
+	{
+		const TupleToTreeSolutionExtractorAdapter *adapter =
+			dynamic_cast<const TupleToTreeSolutionExtractorAdapter *>(
+					extractor_);
+		const ITreeTupleSolutionEnumerator *enumerator = adapter
+			? dynamic_cast<const ITreeTupleSolutionEnumerator *>(
+					&adapter->adaptee())
+			: nullptr;
+		if(!enumerator)
+			return IterativeTreeSolver::enumerateSolutions(
+					td, instance, tables);
+
+		return enumerator->enumerateSolutions(
+				td.root(),
+				td,
+				dynamic_cast<const INodeTupleSetMap &>(tables),
+				instance);
+	}
+
+	void IterativeTreeTupleSolver::reduceTables(
+			const ITreeDecomposition &td,
+			INodeTableMap &tables) const
+	{
+		const TupleToTreeSolutionExtractorAdapter *adapter =
+			dynamic_cast<const TupleToTreeSolutionExtractorAdapter *>(
+					extractor_);
+		const ITupleProjection *projection = adapter
+			? dynamic_cast<const ITupleProjection *>(&adapter->adaptee())
+			: nullptr;
+		if(!projection)
+			return;
+
+		SemiJoinReducer reducer(*projection, threadCount_);
+		reducer.reduce(td, dynamic_cast<INodeTupleSetMap &>(tables));
+		this->benchmarkSession().registerTimestamp(
+				"semi-join reduction time");
+	}
+
 	std::vector<std::unique_ptr<const ITreeAlgorithm> >
 	IterativeTreeTupleSolver::convertAlgorithmList(
 			const TreeTupleAlgorithmVector &algorithms)
@@ -93,5 +225,18 @@ namespace sharp
 		return newAlgorithms;
 	}
 
+	std::vector<std::unique_ptr<const ITreeTopDownAlgorithm> >
+	IterativeTreeTupleSolver::convertAlgorithmList(
+			const TreeTupleTopDownAlgorithmVector &algorithms)
+	{
+		std::vector<std::unique_ptr<const ITreeTopDownAlgorithm> >
+			newAlgorithms;
+		for(const ITreeTupleTopDownAlgorithm *alg : algorithms)
+			newAlgorithms.push_back(
+					std::unique_ptr<const ITreeTopDownAlgorithm>(
+						new TupleToTreeTopDownAlgorithmAdapter(*alg)));
+		return newAlgorithms;
+	}
+
 
 } // namespace sharp
@@ -8,7 +8,9 @@
 #include <sharp/ITreeSolver.hpp>
 #include <sharp/IInstance.hpp>
 #include <sharp/ITreeTupleAlgorithm.hpp>
+#include <sharp/ITreeTupleTopDownAlgorithm.hpp>
 #include <sharp/ITreeTupleSolutionExtractor.hpp>
+#include <sharp/ITreeTopDownSolutionExtractor.hpp>
 
 #include <htd/main.hpp>
 
@@ -34,13 +36,41 @@ namespace sharp
 
 			virtual bool needAllTables() const override;
 
+			const ITreeTupleAlgorithm &adaptee() const;
+
 		private:
 			const ITreeTupleAlgorithm &algorithm_;
 
 		}; // class TupleToTreeAlgorithmAdapter
 
+		class SHARP_LOCAL TupleToTreeTopDownAlgorithmAdapter
+			: public ITreeTopDownAlgorithm
+		{
+		public:
+			TupleToTreeTopDownAlgorithmAdapter(
+					const ITreeTupleTopDownAlgorithm &algorithm);
+
+			virtual ~TupleToTreeTopDownAlgorithmAdapter() override;
+
+			virtual ITable *evaluateNode(
+					htd::vertex_t node,
+					const htd::ITreeDecomposition &decomposition,
+					const INodeTableMap &bottomUpTables,
+					const INodeTableMap &topDownTables,
+					const IInstance &instance) const override;
+
+			virtual bool needAllTables() const override;
+
+			const ITreeTupleTopDownAlgorithm &adaptee() const;
+
+		private:
+			const ITreeTupleTopDownAlgorithm &algorithm_;
+
+		}; // class TupleToTreeTopDownAlgorithmAdapter
+
 		class SHARP_LOCAL TupleToTreeSolutionExtractorAdapter
-			: public ITreeSolutionExtractor
+			: public ITreeSolutionExtractor,
+			  public ITreeTopDownSolutionExtractor
 		{
 		public:
 			TupleToTreeSolutionExtractorAdapter(
@@ -54,9 +84,20 @@ namespace sharp
 					const INodeTableMap &tables,
 					const IInstance &instance) const override;
 
+			// forwards to the plain overload unless the adaptee is an
+			// ITreeTupleTopDownSolutionExtractor
+			virtual ISolution *extractSolution(
+					htd::vertex_t node,
+					const htd::ITreeDecomposition &decomposition,
+					const INodeTableMap &bottomUpTables,
+					const INodeTableMap &topDownTables,
+					const IInstance &instance) const override;
+
 			virtual ISolution *emptySolution(
 					const IInstance &instance) const override;
 
+			const ITreeTupleSolutionExtractor &adaptee() const;
+
 		private:
 			const ITreeTupleSolutionExtractor &extractor_;
 
@@ -97,15 +138,55 @@ namespace sharp
 				const TreeTupleAlgorithmVector &algorithms,
 				const ITreeTupleSolutionExtractor &extractor);
 
+		IterativeTreeTupleSolver(
+				const htd::ITreeDecompositionAlgorithm &decomposer,
+				const TreeTupleAlgorithmVector &algorithms,
+				const TreeTupleTopDownAlgorithmVector &topDownAlgorithms,
+				const ITreeTupleSolutionExtractor &extractor);
+
 		virtual ~IterativeTreeTupleSolver() override;
 
 	private:
 		virtual std::unique_ptr<INodeTableMap> initializeMap(
 				std::size_t decompositionNodeCount) const override;
 
+		virtual std::unique_ptr<INodeTableMap> overlayMap(
+				const INodeTableMap &tables,
+				const std::vector<std::pair<htd::vertex_t, const ITable *> >
+					&replacements) const override;
+
+		virtual const ITableReader *tableReader(
+				const ITreeAlgorithm &algorithm) const override;
+
+		virtual const ITableReader *tableReader(
+				const ITreeTopDownAlgorithm &algorithm) const override;
+
+		virtual const ITableReader *tableReader(
+				const ITreeSolutionExtractor &extractor) const override;
+
+		virtual ISolution *extract(
+				const htd::ITreeDecomposition &decomposition,
+				const IInstance &instance,
+				const INodeTableMap &tables,
+				const INodeTableMap *topDownTables) const override;
+
+		virtual ISolutionCursor *enumerateSolutions(
+				const htd::ITreeDecomposition &decomposition,
+				const IInstance &instance,
+				const INodeTableMap &tables) const override;
+
+		// semi-join reduction if the extractor is an ITupleProjection
+		virtual void reduceTables(
+				const htd::ITreeDecomposition &decomposition,
+				INodeTableMap &tables) const override;
+
 		static std::vector<std::unique_ptr<const ITreeAlgorithm> >
 		convertAlgorithmList(const TreeTupleAlgorithmVector &algorithms);
 
+		static std::vector<std::unique_ptr<const ITreeTopDownAlgorithm> >
+		convertAlgorithmList(
+				const TreeTupleTopDownAlgorithmVector &algorithms);
+
 	}; // class IterativeTreeTupleSolver
 
 } // namespace sharp
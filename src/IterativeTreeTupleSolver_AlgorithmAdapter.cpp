@@ -62,4 +62,11 @@ namespace sharp
 		return algorithm_.needAllTupleSets();
 	}
 
+	const ITreeTupleAlgorithm &
+	IterativeTreeTupleSolver::
+	TupleToTreeAlgorithmAdapter::adaptee() const
+	{
+		return algorithm_;
+	}
+
 } // namespace sharp
@@ -4,6 +4,8 @@
 
 #include "IterativeTreeTupleSolver.hpp"
 
+#include <sharp/ITreeTupleTopDownSolutionExtractor.hpp>
+
 namespace sharp
 {
 	using htd::vertex_t;
@@ -35,6 +37,30 @@ namespace sharp
 				instance);
 	}
 
+	ISolution *
+	IterativeTreeTupleSolver::
+	TupleToTreeSolutionExtractorAdapter::extractSolution(
+			vertex_t node,
+			const ITreeDecomposition &decomposition,
+			const INodeTableMap &bottomUpTables,
+			const INodeTableMap &topDownTables,
+			const IInstance &instance) const
+	{
+		const ITreeTupleTopDownSolutionExtractor *topDownExtractor =
+			dynamic_cast<const ITreeTupleTopDownSolutionExtractor *>(
+					&extractor_);
+		if(!topDownExtractor)
+			return this->extractSolution(
+					node, decomposition, bottomUpTables, instance);
+
+		return topDownExtractor->extractSolution(
+				node,
+				decomposition,
+				dynamic_cast<const INodeTupleSetMap &>(bottomUpTables),
+				dynamic_cast<const INodeTupleSetMap &>(topDownTables),
+				instance);
+	}
+
 	ISolution *
 	IterativeTreeTupleSolver::
 	TupleToTreeSolutionExtractorAdapter::emptySolution(
@@ -43,4 +69,11 @@ namespace sharp
 		return extractor_.emptySolution(instance);
 	}
 
+	const ITreeTupleSolutionExtractor &
+	IterativeTreeTupleSolver::
+	TupleToTreeSolutionExtractorAdapter::adaptee() const
+	{
+		return extractor_;
+	}
+
 } // namespace sharp
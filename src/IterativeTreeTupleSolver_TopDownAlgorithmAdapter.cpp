@@ -0,0 +1,62 @@
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include "IterativeTreeTupleSolver.hpp"
+
+#include "TupleSet.hpp"
+
+#include <memory>
+
+namespace sharp
+{
+	using htd::vertex_t;
+	using htd::ITreeDecomposition;
+
+	IterativeTreeTupleSolver::
+	TupleToTreeTopDownAlgorithmAdapter::TupleToTreeTopDownAlgorithmAdapter(
+			const ITreeTupleTopDownAlgorithm &algorithm)
+		: algorithm_(algorithm)
+	{ }
+
+	IterativeTreeTupleSolver::
+	TupleToTreeTopDownAlgorithmAdapter::~TupleToTreeTopDownAlgorithmAdapter()
+	{ }
+
+	ITable *
+	IterativeTreeTupleSolver::
+	TupleToTreeTopDownAlgorithmAdapter::evaluateNode(
+			vertex_t node,
+			const ITreeDecomposition &decomposition,
+			const INodeTableMap &bottomUpTables,
+			const INodeTableMap &topDownTables,
+			const IInstance &instance) const
+	{
+		std::unique_ptr<ITupleSet> newTable(new TupleSet());
+
+		algorithm_.evaluateNode(
+				node,
+				decomposition,
+				dynamic_cast<const INodeTupleSetMap &>(bottomUpTables),
+				dynamic_cast<const INodeTupleSetMap &>(topDownTables),
+				instance,
+				*newTable);
+
+		return newTable.release();
+	}
+
+	bool
+	IterativeTreeTupleSolver::
+	TupleToTreeTopDownAlgorithmAdapter::needAllTables() const
+	{
+		return algorithm_.needAllTupleSets();
+	}
+
+	const ITreeTupleTopDownAlgorithm &
+	IterativeTreeTupleSolver::
+	TupleToTreeTopDownAlgorithmAdapter::adaptee() const
+	{
+		return algorithm_;
+	}
+
+} // namespace sharp
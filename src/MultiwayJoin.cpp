@@ -0,0 +1,199 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <sharp/MultiwayJoin.hpp>
+
+#include "HashIndex.hpp"
+#include "util/concurrent.hpp"
+
+#include <algorithm>
+
+namespace sharp
+{
+	using std::size_t;
+	using std::vector;
+
+	namespace
+	{
+		size_t distinctCount(vector<size_t> hashes)
+		{
+			std::sort(hashes.begin(), hashes.end());
+			return std::unique(hashes.begin(), hashes.end()) - hashes.begin();
+		}
+	}
+
+	MultiwayJoin::MultiwayJoin(
+			const vector<const ITupleSet *> &children,
+			const HashJoin::KeyHash &hash,
+			const HashJoin::KeyEqual &equal,
+			unsigned int threadCount)
+		: equal_(equal),
+		  threadCount_(threadCount == 0 ? 1 : threadCount),
+		  order_(children.size()),
+		  tuples_(children.size()),
+		  hashes_(children.size()),
+		  driver_(0),
+		  pending_(false),
+		  matches_(children.size()),
+		  positions_(children.size(), 0)
+	{
+		vector<TupleVector> tuples(children.size());
+		vector<vector<size_t> > hashes(children.size());
+		vector<size_t> distinct(children.size());
+
+		for(size_t child = 0; child < children.size(); ++child)
+		{
+			tuples[child] = HashIndex::gather(*children[child]);
+			hashes[child] =
+				HashIndex::hashAll(tuples[child], hash, threadCount_);
+			distinct[child] = distinctCount(hashes[child]);
+			order_[child] = child;
+		}
+
+		// the smallest child drives, the others are probed fewest keys first
+		auto driver = std::min_element(order_.begin(), order_.end(),
+			[&](size_t a, size_t b)
+			{
+				return tuples[a].size() < tuples[b].size();
+			});
+		if(driver != order_.end())
+			std::iter_swap(order_.begin(), driver);
+		if(!order_.empty())
+			std::stable_sort(order_.begin() + 1, order_.end(),
+				[&](size_t a, size_t b)
+				{
+					return distinct[a] < distinct[b]
+						|| (distinct[a] == distinct[b]
+							&& tuples[a].size() < tuples[b].size());
+				});
+
+		for(size_t position = 0; position < order_.size(); ++position)
+		{
+			tuples_[position].swap(tuples[order_[position]]);
+			hashes_[position].swap(hashes[order_[position]]);
+		}
+
+		for(size_t position = 1; position < order_.size(); ++position)
+			indices_.push_back(
+					new HashIndex(tuples_[position], hashes_[position]));
+	}
+
+	MultiwayJoin::~MultiwayJoin()
+	{
+		for(HashIndex *index : indices_)
+			delete index;
+	}
+
+	const vector<size_t> &MultiwayJoin::order() const
+	{
+		return order_;
+	}
+
+	bool MultiwayJoin::next(TupleVector &combination)
+	{
+		if(order_.empty()) return false;
+
+		if(pending_ && !this->advance(matches_, positions_))
+		{
+			pending_ = false;
+			++driver_;
+		}
+
+		if(!pending_)
+		{
+			while(driver_ < tuples_[0].size()
+					&& !this->findMatches(driver_, matches_))
+				++driver_;
+
+			if(driver_ == tuples_[0].size())
+				return false;
+
+			std::fill(positions_.begin(), positions_.end(), 0);
+			pending_ = true;
+		}
+
+		this->fill(driver_, matches_, positions_, combination);
+		return true;
+	}
+
+	void MultiwayJoin::reset()
+	{
+		driver_ = 0;
+		pending_ = false;
+	}
+
+	void MultiwayJoin::forEach(const HashJoin::TupleCallback &combine) const
+	{
+		if(order_.empty()) return;
+
+		parallelFor(tuples_[0].size(), threadCount_,
+			[&](size_t begin, size_t end)
+			{
+				vector<TupleVector> matches(order_.size());
+				vector<size_t> positions(order_.size());
+				TupleVector combination;
+
+				for(size_t driver = begin; driver < end; ++driver)
+				{
+					if(!this->findMatches(driver, matches)) continue;
+
+					std::fill(positions.begin(), positions.end(), 0);
+					do
+					{
+						this->fill(driver, matches, positions, combination);
+						combine(combination);
+					}
+					while(this->advance(matches, positions));
+				}
+			});
+	}
+
+	bool MultiwayJoin::findMatches(
+			size_t driver,
+			vector<TupleVector> &matches) const
+	{
+		const ITuple &tuple = *tuples_[0][driver];
+		size_t hash = hashes_[0][driver];
+
+		for(size_t position = 1; position < order_.size(); ++position)
+		{
+			TupleVector &found = matches[position];
+			found.clear();
+			indices_[position - 1]->probe(tuple, hash, equal_,
+				[&](const ITuple &match) { found.push_back(&match); });
+
+			if(found.empty())
+				return false;
+		}
+
+		return true;
+	}
+
+	bool MultiwayJoin::advance(
+			const vector<TupleVector> &matches,
+			vector<size_t> &positions) const
+	{
+		for(size_t position = order_.size() - 1; position > 0; --position)
+		{
+			if(++positions[position] < matches[position].size())
+				return true;
+			positions[position] = 0;
+		}
+		return false;
+	}
+
+	void MultiwayJoin::fill(
+			size_t driver,
+			const vector<TupleVector> &matches,
+			const vector<size_t> &positions,
+			TupleVector &combination) const
+	{
+		combination.resize(order_.size());
+		combination[order_[0]] = tuples_[0][driver];
+		for(size_t position = 1; position < order_.size(); ++position)
+			combination[order_[position]] =
+				matches[position][positions[position]];
+	}
+
+} // namespace sharp
@@ -0,0 +1,331 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <sharp/NodeProfiler.hpp>
+#include <sharp/ITupleSet.hpp>
+
+#include "util/output.hpp"
+
+#include <algorithm>
+#include <map>
+
+#ifdef HAVE_MALLOC_H
+	#include <malloc.h>
+#endif
+
+namespace sharp
+{
+	using htd::vertex_t;
+	using htd::ITreeDecomposition;
+
+	using std::size_t;
+	using std::string;
+	using std::vector;
+	using std::map;
+	using std::endl;
+	using std::ios;
+
+	namespace
+	{
+		struct Summary
+		{
+			Summary()
+				: count(0), seconds(0), maxSeconds(0),
+				  inputTuples(0), outputTuples(0),
+				  measuredCount(0), allocatedBytes(0)
+			{ }
+
+			void add(const NodeProfiler::Entry &entry)
+			{
+				++count;
+				seconds += entry.seconds;
+				maxSeconds = std::max(maxSeconds, entry.seconds);
+				inputTuples += entry.inputTuples;
+				outputTuples += entry.outputTuples;
+				if(entry.allocatedBytes >= 0)
+				{
+					++measuredCount;
+					allocatedBytes += entry.allocatedBytes;
+				}
+			}
+
+			size_t count;
+			double seconds;
+			double maxSeconds;
+			size_t inputTuples;
+			size_t outputTuples;
+			// entries with a heap measurement
+			size_t measuredCount;
+			long long allocatedBytes;
+		};
+
+		// empty if the heap was not measured
+		string bytes(long long allocatedBytes)
+		{
+			return allocatedBytes >= 0 ? std::to_string(allocatedBytes) : "";
+		}
+
+		size_t tupleCount(const ITable &table)
+		{
+			const ITupleSet *tuples = dynamic_cast<const ITupleSet *>(&table);
+			return tuples ? tuples->size() : 0;
+		}
+
+		void printSummaryLine(
+				std::ostream &out,
+				bool csv,
+				const string &group,
+				const string &key,
+				const Summary &summary)
+		{
+			if(csv)
+				out << group << ","
+					<< key << ","
+					<< summary.count << ","
+					<< summary.seconds << ","
+					<< summary.seconds / summary.count << ","
+					<< summary.maxSeconds << ","
+					<< summary.inputTuples << ","
+					<< summary.outputTuples << ","
+					<< bytes(summary.measuredCount
+							? summary.allocatedBytes : -1) << endl;
+			else
+			{
+				out << group << " " << key << ": "
+					<< summary.count << " nodes, "
+					<< summary.seconds << "s (total), "
+					<< summary.seconds / summary.count << "s (mean), "
+					<< summary.maxSeconds << "s (max), "
+					<< summary.inputTuples << " tuples in, "
+					<< summary.outputTuples << " tuples out";
+				if(summary.measuredCount)
+					out << ", " << summary.allocatedBytes
+						<< " bytes allocated (" << summary.measuredCount
+						<< " nodes measured)";
+				out << endl;
+			}
+		}
+
+	} // namespace
+
+	NodeProfiler::Probe::Probe() : heap_(-1) { }
+
+	void NodeProfiler::Probe::start(bool measureHeap)
+	{
+		heap_ = measureHeap ? NodeProfiler::heapUsage() : -1;
+		start_ = std::chrono::steady_clock::now();
+	}
+
+	double NodeProfiler::Probe::seconds() const
+	{
+		return std::chrono::duration<double>(
+				std::chrono::steady_clock::now() - start_).count();
+	}
+
+	long long NodeProfiler::Probe::allocatedBytes() const
+	{
+		if(heap_ < 0)
+			return -1;
+		long long heap = NodeProfiler::heapUsage();
+		return heap < 0 ? -1 : heap - heap_;
+	}
+
+	NodeProfiler::NodeProfiler() : enabled_(false) { }
+
+	void NodeProfiler::enable(bool enabled)
+	{
+		enabled_ = enabled;
+	}
+
+	NodeProfiler::NodeType NodeProfiler::classify(
+			vertex_t node,
+			const ITreeDecomposition &td)
+	{
+		size_t childCount = td.childCount(node);
+		if(childCount == 0) return LEAF;
+		if(childCount > 1) return JOIN;
+
+		// bags are sorted
+		const std::vector<vertex_t> &bag = td.bagContent(node);
+		const std::vector<vertex_t> &childBag =
+			td.bagContent(td.childAtPosition(node, 0));
+		bool introduces = !std::includes(
+				childBag.begin(), childBag.end(), bag.begin(), bag.end());
+		bool forgets = !std::includes(
+				bag.begin(), bag.end(), childBag.begin(), childBag.end());
+
+		if(introduces && !forgets) return INTRODUCE;
+		if(forgets && !introduces) return FORGET;
+		return EXCHANGE;
+	}
+
+	const char *NodeProfiler::typeName(NodeType type)
+	{
+		switch(type)
+		{
+		case LEAF: return "leaf";
+		case INTRODUCE: return "introduce";
+		case FORGET: return "forget";
+		case EXCHANGE: return "exchange";
+		case JOIN: return "join";
+		default: return "unknown";
+		}
+	}
+
+	NodeProfiler::Entry NodeProfiler::begin(
+			const string &pass,
+			vertex_t node,
+			const ITreeDecomposition &td,
+			const INodeTableMap &tables,
+			bool topDown)
+	{
+		Entry entry;
+		entry.pass = pass;
+		entry.node = node;
+		entry.type = classify(node, td);
+		entry.bagSize = td.bagSize(node);
+		entry.childCount = td.childCount(node);
+		entry.inputTuples = 0;
+		if(topDown)
+		{
+			if(!td.isRoot(node) && tables.contains(td.parent(node)))
+				entry.inputTuples = tupleCount(tables[td.parent(node)]);
+		}
+		else
+			for(size_t childIndex = 0; childIndex < entry.childCount;
+					++childIndex)
+			{
+				vertex_t child = td.childAtPosition(node, childIndex);
+				if(tables.contains(child))
+					entry.inputTuples += tupleCount(tables[child]);
+			}
+		entry.outputTuples = 0;
+		entry.seconds = 0;
+		entry.allocatedBytes = -1;
+		return entry;
+	}
+
+	void NodeProfiler::end(Entry &entry, const Probe &probe, const ITable *table)
+	{
+		entry.seconds = probe.seconds();
+		entry.allocatedBytes = probe.allocatedBytes();
+		entry.outputTuples = table ? tupleCount(*table) : 0;
+		record(entry);
+	}
+
+	void NodeProfiler::record(const Entry &entry)
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+		entries_.push_back(entry);
+	}
+
+	long long NodeProfiler::heapUsage()
+	{
+#if defined(HAVE_MALLOC_H) && defined(HAVE_MALLINFO2)
+		struct mallinfo2 info = mallinfo2();
+		return static_cast<long long>(info.uordblks + info.hblkhd);
+#elif defined(HAVE_MALLOC_H) && defined(HAVE_MALLINFO)
+		struct mallinfo info = mallinfo();
+		return static_cast<long long>(info.uordblks) + info.hblkhd;
+#else
+		return -1;
+#endif
+	}
+
+	vector<NodeProfiler::Entry> NodeProfiler::entries() const
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+		return entries_;
+	}
+
+	void NodeProfiler::printCsv(std::ostream &out) const
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+
+		StreamFormatGuard format(out);
+		out.setf(ios::fixed, ios::floatfield);
+		out.precision(6);
+
+		out << "pass,node,type,bagsize,children,tuplesin,tuplesout,"
+			<< "seconds,bytes" << endl;
+		for(const Entry &entry : entries_)
+			out << entry.pass << ","
+				<< entry.node << ","
+				<< typeName(entry.type) << ","
+				<< entry.bagSize << ","
+				<< entry.childCount << ","
+				<< entry.inputTuples << ","
+				<< entry.outputTuples << ","
+				<< entry.seconds << ","
+				<< bytes(entry.allocatedBytes) << endl;
+	}
+
+	void NodeProfiler::printJson(std::ostream &out) const
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+
+		StreamFormatGuard format(out);
+		out.setf(ios::fixed, ios::floatfield);
+		out.precision(6);
+
+		out << "[";
+		for(size_t i = 0; i < entries_.size(); ++i)
+		{
+			const Entry &entry = entries_[i];
+			out << (i ? ",\n " : "\n ")
+				<< "{\"pass\": \"" << jsonEscape(entry.pass) << "\""
+				<< ", \"node\": " << entry.node
+				<< ", \"type\": \"" << typeName(entry.type) << "\""
+				<< ", \"bagSize\": " << entry.bagSize
+				<< ", \"children\": " << entry.childCount
+				<< ", \"tuplesIn\": " << entry.inputTuples
+				<< ", \"tuplesOut\": " << entry.outputTuples
+				<< ", \"seconds\": " << entry.seconds
+				<< ", \"bytes\": ";
+			if(entry.allocatedBytes >= 0)
+				out << entry.allocatedBytes << "}";
+			else
+				out << "null}";
+		}
+		out << "\n]" << endl;
+	}
+
+	void NodeProfiler::printSummary(std::ostream &out, bool csv) const
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+		if(entries_.empty()) return;
+
+		map<int, Summary> byType;
+		map<size_t, Summary> byBagSize;
+		for(const Entry &entry : entries_)
+		{
+			byType[entry.type].add(entry);
+			byBagSize[entry.bagSize].add(entry);
+		}
+
+		StreamFormatGuard format(out);
+		out.setf(ios::fixed, ios::floatfield);
+		out.precision(6);
+
+		if(csv)
+			out << "group,key,nodes,seconds,mean,max,tuplesin,tuplesout,"
+				<< "bytes" << endl;
+		else
+			out << "node profile:" << endl;
+
+		for(const auto &type : byType)
+			printSummaryLine(out, csv, "type",
+					typeName(static_cast<NodeType>(type.first)), type.second);
+		for(const auto &bagSize : byBagSize)
+			printSummaryLine(out, csv, "bagsize",
+					std::to_string(bagSize.first), bagSize.second);
+	}
+
+	void NodeProfiler::clear()
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+		entries_.clear();
+	}
+
+} // namespace sharp
@@ -5,6 +5,7 @@
 #include "NodeTableMap.hpp"
 
 #include <stdexcept>
+#include <vector>
 
 namespace sharp
 {
@@ -83,4 +84,20 @@ namespace sharp
 		return existingEntry != map_.end();
 	}
 
+	HashStatistics::Entry NodeTableMap::statistics(
+			const std::string &name) const
+	{
+		HashStatistics::Entry entry;
+		entry.name = name;
+		entry.elements = map_.size();
+		entry.distinctHashes = map_.size();
+		entry.collisions = 0;
+
+		std::vector<size_t> bucketSizes(map_.bucket_count());
+		for(size_t bucket = 0; bucket < bucketSizes.size(); ++bucket)
+			bucketSizes[bucket] = map_.bucket_size(bucket);
+		HashStatistics::analyzeBuckets(entry, bucketSizes);
+		return entry;
+	}
+
 } // namespace sharp
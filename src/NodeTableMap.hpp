@@ -2,7 +2,9 @@
 #define SHARP_NODETABLEMAP_H_
 
 #include <sharp/IMutableNodeTableMap.hpp>
+#include <sharp/HashStatistics.hpp>
 
+#include <string>
 #include <unordered_map>
 #include <cstddef>
 
@@ -27,6 +29,10 @@ namespace sharp
 		virtual bool contains(htd::vertex_t node) const override;
 		
 		virtual void clear();
+
+		// bucket occupancy of the underlying hash map
+		HashStatistics::Entry statistics(const std::string &name) const;
+
 	private:
 		std::unordered_map<htd::vertex_t, ITable *> map_;
 
@@ -9,49 +9,137 @@
 namespace sharp
 {
 	using htd::vertex_t;
-	
+
+	NodeTableMapOverlay::NodeTableMapOverlay(
+			const INodeTableMap &original)
+		: map_(nullptr), mutableMap_(nullptr)
+	{
+		this->flatten(original, false);
+	}
+
+	NodeTableMapOverlay::NodeTableMapOverlay(
+			INodeTableMap &original)
+		: map_(nullptr), mutableMap_(nullptr)
+	{
+		this->flatten(original, true);
+		if(map_ == &original)
+			mutableMap_ = &original;
+	}
+
+	NodeTableMapOverlay::NodeTableMapOverlay(
+			const NodeTableMapOverlay &original)
+		: NodeTableMapOverlay(static_cast<const INodeTableMap &>(original))
+	{ }
+
+	NodeTableMapOverlay::NodeTableMapOverlay(
+			NodeTableMapOverlay &original)
+		: NodeTableMapOverlay(static_cast<INodeTableMap &>(original))
+	{ }
+
 	NodeTableMapOverlay::NodeTableMapOverlay(
 			const INodeTableMap &original,
-			htd::vertex_t node,
+			vertex_t node,
 			const ITable &replacement)
-		: map_(original), node_(node), replacement_(replacement)
-	{ }
+		: NodeTableMapOverlay(original)
+	{
+		this->replace(node, replacement);
+	}
+
+	NodeTableMapOverlay::NodeTableMapOverlay(
+			INodeTableMap &original,
+			vertex_t node,
+			ITable &replacement)
+		: NodeTableMapOverlay(original)
+	{
+		this->replace(node, replacement);
+	}
 
 	NodeTableMapOverlay::~NodeTableMapOverlay() { }
 
-	ITable &NodeTableMapOverlay::operator[](vertex_t)
+	void NodeTableMapOverlay::flatten(
+			const INodeTableMap &original,
+			bool writable)
 	{
-		throw std::runtime_error("Unimplemented function! 3");
+		const NodeTableMapOverlay *overlay =
+			dynamic_cast<const NodeTableMapOverlay *>(&original);
+		if(!overlay)
+		{
+			map_ = &original;
+			return;
+		}
+
+		map_ = overlay->map_;
+		replacements_ = overlay->replacements_;
+		if(writable)
+			mutableMap_ = overlay->mutableMap_;
+		else
+			for(auto &replacement : replacements_)
+				replacement.second.mutableTable = nullptr;
 	}
 
-	ITable &NodeTableMapOverlay::at(vertex_t)
+	void NodeTableMapOverlay::replace(
+			vertex_t node,
+			const ITable &replacement)
 	{
-		throw std::runtime_error("Unimplemented function! 4");
+		replacements_[node] = Replacement { &replacement, nullptr };
+	}
+
+	void NodeTableMapOverlay::replace(
+			vertex_t node,
+			ITable &replacement)
+	{
+		replacements_[node] = Replacement { &replacement, &replacement };
+	}
+
+	void NodeTableMapOverlay::restore(vertex_t node)
+	{
+		replacements_.erase(node);
+	}
+
+	ITable &NodeTableMapOverlay::operator[](vertex_t node)
+	{
+		return this->at(node);
+	}
+
+	ITable &NodeTableMapOverlay::at(vertex_t node)
+	{
+		auto replacement = replacements_.find(node);
+		if(replacement != replacements_.end())
+		{
+			if(!replacement->second.mutableTable)
+				throw std::logic_error("Replacement table is read-only.");
+			return *replacement->second.mutableTable;
+		}
+
+		if(!mutableMap_)
+			throw std::logic_error("Overlaid table map is read-only.");
+		return mutableMap_->at(node);
 	}
 
 	const ITable &NodeTableMapOverlay::operator[](vertex_t node) const
 	{
-		if(node == node_)
-			return replacement_;
-		return map_[node];
+		return this->at(node);
 	}
 
 	const ITable &NodeTableMapOverlay::at(vertex_t node) const
 	{
-		if(node == node_)
-			return replacement_;
-		return map_.at(node);
+		auto replacement = replacements_.find(node);
+		if(replacement != replacements_.end())
+			return *replacement->second.table;
+		return map_->at(node);
 	}
 
-	void NodeTableMapOverlay::clear()
+	bool NodeTableMapOverlay::contains(vertex_t node) const
 	{
-		//TODO: nasty!
-		const_cast<INodeTableMap&>(map_).clear();
+		return replacements_.count(node) || map_->contains(node);
 	}
 
-	bool NodeTableMapOverlay::contains(vertex_t node) const
+	void NodeTableMapOverlay::clear()
 	{
-		return node == node_ || map_.contains(node);
+		if(!mutableMap_)
+			throw std::logic_error("Overlaid table map is read-only.");
+		replacements_.clear();
+		mutableMap_->clear();
 	}
 
 } // namespace sharp
@@ -3,18 +3,46 @@
 
 #include "NodeTableMap.hpp"
 
+#include <unordered_map>
+
 namespace sharp
 {
+	// View of a map in which the tables of some nodes are replaced.
+	// Overlays of overlays are flattened on construction, so a lookup costs
+	// one hash probe however many stages are stacked.
+	//
+	// Mutable access goes to a writable replacement, or through to the
+	// original map if the overlay was built on a mutable one. Read-only
+	// replacements and originals throw std::logic_error instead.
 	class SHARP_LOCAL NodeTableMapOverlay : public INodeTableMap
 	{
 	public:
+		NodeTableMapOverlay(const INodeTableMap &original);
+		NodeTableMapOverlay(INodeTableMap &original);
+
+		// copies of a const overlay are read-only as well
+		NodeTableMapOverlay(const NodeTableMapOverlay &original);
+		NodeTableMapOverlay(NodeTableMapOverlay &original);
+
 		NodeTableMapOverlay(
 				const INodeTableMap &original,
 				htd::vertex_t node,
 				const ITable &replacement);
 
+		NodeTableMapOverlay(
+				INodeTableMap &original,
+				htd::vertex_t node,
+				ITable &replacement);
+
 		virtual ~NodeTableMapOverlay() override;
 
+		// makes node refer to replacement from now on
+		void replace(htd::vertex_t node, const ITable &replacement);
+		void replace(htd::vertex_t node, ITable &replacement);
+
+		// makes node refer to the original table again
+		void restore(htd::vertex_t node);
+
 		virtual ITable &operator[](htd::vertex_t node) override;
 		virtual ITable &at(htd::vertex_t node) override;
 
@@ -22,11 +50,22 @@ namespace sharp
 		virtual const ITable &at(htd::vertex_t node) const override;
 
 		virtual bool contains(htd::vertex_t node) const override;
+
+		// forgets all replacements and clears the original map
 		virtual void clear();
+
 	private:
-		const INodeTableMap &map_;
-		htd::vertex_t node_;
-		const ITable &replacement_;
+		struct Replacement
+		{
+			const ITable *table;
+			ITable *mutableTable;
+		};
+
+		const INodeTableMap *map_;
+		INodeTableMap *mutableMap_;
+		std::unordered_map<htd::vertex_t, Replacement> replacements_;
+
+		void flatten(const INodeTableMap &original, bool writable);
 
 	}; // class NodeTableMapOverlay
 
@@ -26,6 +26,9 @@ namespace sharp
 		virtual bool contains(htd::vertex_t node) const override;
 		
 		virtual void clear();
+
+		using NodeTableMap::statistics;
+
 	}; // class NodeTupleSetMap
 
 } // namespace sharp
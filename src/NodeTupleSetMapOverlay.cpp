@@ -4,55 +4,142 @@
 
 #include "NodeTupleSetMapOverlay.hpp"
 
+#include <stdexcept>
+
 namespace sharp
 {
 	using htd::vertex_t;
-	
+
+	NodeTupleSetMapOverlay::NodeTupleSetMapOverlay(
+			const INodeTupleSetMap &original)
+		: map_(nullptr), mutableMap_(nullptr)
+	{
+		this->flatten(original, false);
+	}
+
+	NodeTupleSetMapOverlay::NodeTupleSetMapOverlay(
+			INodeTupleSetMap &original)
+		: map_(nullptr), mutableMap_(nullptr)
+	{
+		this->flatten(original, true);
+		if(map_ == &original)
+			mutableMap_ = &original;
+	}
+
+	NodeTupleSetMapOverlay::NodeTupleSetMapOverlay(
+			const NodeTupleSetMapOverlay &original)
+		: NodeTupleSetMapOverlay(static_cast<const INodeTupleSetMap &>(original))
+	{ }
+
+	NodeTupleSetMapOverlay::NodeTupleSetMapOverlay(
+			NodeTupleSetMapOverlay &original)
+		: NodeTupleSetMapOverlay(static_cast<INodeTupleSetMap &>(original))
+	{ }
+
 	NodeTupleSetMapOverlay::NodeTupleSetMapOverlay(
 			const INodeTupleSetMap &original,
-			htd::vertex_t node,
+			vertex_t node,
 			const ITupleSet &replacement)
-		: map_(original), node_(node), replacement_(replacement)
-	{ }
+		: NodeTupleSetMapOverlay(original)
+	{
+		this->replace(node, replacement);
+	}
+
+	NodeTupleSetMapOverlay::NodeTupleSetMapOverlay(
+			INodeTupleSetMap &original,
+			vertex_t node,
+			ITupleSet &replacement)
+		: NodeTupleSetMapOverlay(original)
+	{
+		this->replace(node, replacement);
+	}
 
 	NodeTupleSetMapOverlay::~NodeTupleSetMapOverlay() { }
 
-	ITupleSet &NodeTupleSetMapOverlay::operator[](vertex_t /*node*/)
+	void NodeTupleSetMapOverlay::flatten(
+			const INodeTupleSetMap &original,
+			bool writable)
 	{
-		/*if(node == node_)
-			return replacement_;
-		return map_[node];*/
-		throw std::runtime_error("Unimplemented function 1!");
+		const NodeTupleSetMapOverlay *overlay =
+			dynamic_cast<const NodeTupleSetMapOverlay *>(&original);
+		if(!overlay)
+		{
+			map_ = &original;
+			return;
+		}
+
+		map_ = overlay->map_;
+		replacements_ = overlay->replacements_;
+		if(writable)
+			mutableMap_ = overlay->mutableMap_;
+		else
+			for(auto &replacement : replacements_)
+				replacement.second.mutableTable = nullptr;
 	}
 
-	void NodeTupleSetMapOverlay::clear()
+	void NodeTupleSetMapOverlay::replace(
+			vertex_t node,
+			const ITupleSet &replacement)
+	{
+		replacements_[node] = Replacement { &replacement, nullptr };
+	}
+
+	void NodeTupleSetMapOverlay::replace(
+			vertex_t node,
+			ITupleSet &replacement)
+	{
+		replacements_[node] = Replacement { &replacement, &replacement };
+	}
+
+	void NodeTupleSetMapOverlay::restore(vertex_t node)
+	{
+		replacements_.erase(node);
+	}
+
+	ITupleSet &NodeTupleSetMapOverlay::operator[](vertex_t node)
 	{
-		//TODO: nasty!
-		const_cast<INodeTupleSetMap&>(map_).clear();
+		return this->at(node);
 	}
 
-	ITupleSet &NodeTupleSetMapOverlay::at(vertex_t)
+	ITupleSet &NodeTupleSetMapOverlay::at(vertex_t node)
 	{
-		throw std::runtime_error("Unimplemented function 2!");
+		auto replacement = replacements_.find(node);
+		if(replacement != replacements_.end())
+		{
+			if(!replacement->second.mutableTable)
+				throw std::logic_error("Replacement table is read-only.");
+			return *replacement->second.mutableTable;
+		}
+
+		if(!mutableMap_)
+			throw std::logic_error("Overlaid table map is read-only.");
+		return mutableMap_->at(node);
 	}
 
 	const ITupleSet &NodeTupleSetMapOverlay::operator[](vertex_t node) const
 	{
-		if(node == node_)
-			return replacement_;
-		return map_[node];
+		return this->at(node);
 	}
 
 	const ITupleSet &NodeTupleSetMapOverlay::at(vertex_t node) const
 	{
-		if(node == node_)
-			return replacement_;
-		return map_.at(node);
+		auto replacement = replacements_.find(node);
+		if(replacement != replacements_.end())
+			return *replacement->second.table;
+		return map_->at(node);
 	}
 
 	bool NodeTupleSetMapOverlay::contains(vertex_t node) const
 	{
-		return node == node_ || map_.contains(node);
+		return replacements_.count(node) || map_->contains(node);
+	}
+
+	void NodeTupleSetMapOverlay::clear()
+	{
+		if(!mutableMap_)
+			throw std::logic_error("Overlaid table map is read-only.");
+		replacements_.clear();
+		mutableMap_->clear();
 	}
 
 } // namespace sharp
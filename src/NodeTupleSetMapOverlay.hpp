@@ -3,30 +3,69 @@
 
 #include "NodeTupleSetMap.hpp"
 
+#include <unordered_map>
+
 namespace sharp
 {
+	// View of a map in which the tables of some nodes are replaced.
+	// Overlays of overlays are flattened on construction, so a lookup costs
+	// one hash probe however many stages are stacked.
+	//
+	// Mutable access goes to a writable replacement, or through to the
+	// original map if the overlay was built on a mutable one. Read-only
+	// replacements and originals throw std::logic_error instead.
 	class SHARP_LOCAL NodeTupleSetMapOverlay : public INodeTupleSetMap
 	{
 	public:
+		NodeTupleSetMapOverlay(const INodeTupleSetMap &original);
+		NodeTupleSetMapOverlay(INodeTupleSetMap &original);
+
+		// copies of a const overlay are read-only as well
+		NodeTupleSetMapOverlay(const NodeTupleSetMapOverlay &original);
+		NodeTupleSetMapOverlay(NodeTupleSetMapOverlay &original);
+
 		NodeTupleSetMapOverlay(
 				const INodeTupleSetMap &original,
 				htd::vertex_t node,
 				const ITupleSet &replacement);
 
+		NodeTupleSetMapOverlay(
+				INodeTupleSetMap &original,
+				htd::vertex_t node,
+				ITupleSet &replacement);
+
 		virtual ~NodeTupleSetMapOverlay() override;
 
+		// makes node refer to replacement from now on
+		void replace(htd::vertex_t node, const ITupleSet &replacement);
+		void replace(htd::vertex_t node, ITupleSet &replacement);
+
+		// makes node refer to the original table again
+		void restore(htd::vertex_t node);
+
 		virtual ITupleSet &operator[](htd::vertex_t node) override;
 		virtual ITupleSet &at(htd::vertex_t node) override;
-		
+
 		virtual const ITupleSet &operator[](htd::vertex_t node) const override;
 		virtual const ITupleSet &at(htd::vertex_t node) const override;
 
 		virtual bool contains(htd::vertex_t node) const override;
-		virtual void clear();	
+
+		// forgets all replacements and clears the original map
+		virtual void clear();
+
 	private:
-		const INodeTupleSetMap &map_;
-		htd::vertex_t node_;
-		const ITupleSet &replacement_;
+		struct Replacement
+		{
+			const ITupleSet *table;
+			ITupleSet *mutableTable;
+		};
+
+		const INodeTupleSetMap *map_;
+		INodeTupleSetMap *mutableMap_;
+		std::unordered_map<htd::vertex_t, Replacement> replacements_;
+
+		void flatten(const INodeTupleSetMap &original, bool writable);
 
 	}; // class NodeTupleSetMapOverlay
 
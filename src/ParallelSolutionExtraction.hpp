@@ -0,0 +1,111 @@
+#ifndef SHARP_PARALLELSOLUTIONEXTRACTION_H_
+#define SHARP_PARALLELSOLUTIONEXTRACTION_H_
+
+#include "util/concurrent.hpp"
+
+#include <sharp/ISolution.hpp>
+#include <sharp/IInstance.hpp>
+
+#include <htd/main.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+namespace sharp
+{
+	// Drives an ITreeParallelSolutionExtractor or its tuple set version
+	// over decomposition. Every node is a task on a single TaskQueue:
+	// extractNode runs as soon as the parent's part exists, and combine
+	// as soon as the node's children are combined, so independent
+	// subtrees never wait for each other.
+	template<typename Extractor, typename Map>
+	ISolution *extractConcurrently(
+			const Extractor &extractor,
+			const htd::ITreeDecomposition &decomposition,
+			const Map &tables,
+			const IInstance &instance,
+			unsigned int threadCount)
+	{
+		// nodes in breadth-first order, so the children of a node are
+		// consecutive
+		std::vector<htd::vertex_t> nodes(1, decomposition.root());
+		std::vector<std::size_t> parents(1, 0);
+		std::vector<std::size_t> firstChildren;
+		for(std::size_t i = 0; i < nodes.size(); ++i)
+		{
+			firstChildren.push_back(nodes.size());
+			std::size_t childCount = decomposition.childCount(nodes[i]);
+			for(std::size_t child = 0; child < childCount; ++child)
+			{
+				nodes.push_back(
+						decomposition.childAtPosition(nodes[i], child));
+				parents.push_back(i);
+			}
+		}
+		firstChildren.push_back(nodes.size());
+
+		std::vector<std::unique_ptr<ISolution> > parts(nodes.size());
+		// children of every node whose combine has not finished yet
+		std::vector<std::atomic<std::size_t> > remaining(nodes.size());
+		for(std::size_t i = 0; i < nodes.size(); ++i)
+			remaining[i] = firstChildren[i + 1] - firstChildren[i];
+
+		// task 2i extracts the part of node i, task 2i + 1 combines it
+		TaskQueue queue;
+		queue.schedule(0);
+		queue.run(std::min<std::size_t>(threadCount, nodes.size()),
+			[&](std::size_t task)
+			{
+				std::size_t i = task / 2;
+				std::size_t first = firstChildren[i];
+				std::size_t last = firstChildren[i + 1];
+
+				if(task % 2 == 0)
+				{
+					parts[i].reset(extractor.extractNode(
+								nodes[i],
+								decomposition,
+								tables,
+								i ? parts[parents[i]].get() : nullptr,
+								instance));
+
+					if(first == last)
+						queue.schedule(task + 1);
+					for(std::size_t child = first; child < last; ++child)
+						queue.schedule(2 * child);
+					return;
+				}
+
+				// the parts stay owned here until combine has returned, so
+				// that they are deleted if it throws
+				std::vector<ISolution *> childResults;
+				childResults.reserve(last - first);
+				for(std::size_t child = first; child < last; ++child)
+					childResults.push_back(parts[child].get());
+
+				ISolution *combined = extractor.combine(
+						nodes[i],
+						decomposition,
+						tables,
+						parts[i].get(),
+						childResults,
+						instance);
+
+				for(std::size_t child = first; child < last; ++child)
+					parts[child].release();
+				parts[i].release();
+				parts[i].reset(combined);
+
+				if(i && --remaining[parents[i]] == 0)
+					queue.schedule(2 * parents[i] + 1);
+			});
+
+		return parts[0].release();
+	}
+
+} // namespace sharp
+
+#endif // SHARP_PARALLELSOLUTIONEXTRACTION_H_
@@ -0,0 +1,330 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <sharp/PerfCounters.hpp>
+
+#include "util/output.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#ifdef HAVE_LINUX_PERF_EVENT_H
+	#include <linux/perf_event.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#endif
+
+namespace sharp
+{
+	using std::size_t;
+	using std::string;
+	using std::make_pair;
+	using std::endl;
+	using std::ios;
+
+	namespace
+	{
+		// The counters of the calling thread, opened as one group so that
+		// a single read returns all of them.
+		class CounterGroup
+		{
+		public:
+			CounterGroup();
+			~CounterGroup();
+
+			bool available() const { return size_ != 0; }
+
+			// reads the raw counts into counts, indexed by counter
+			bool read(
+					long long *counts,
+					unsigned long long &enabled,
+					unsigned long long &running) const;
+
+		private:
+			CounterGroup(const CounterGroup &) = delete;
+			CounterGroup &operator=(const CounterGroup &) = delete;
+
+			int fds_[PerfCounters::COUNTER_COUNT];
+			// counter of each group position
+			int counters_[PerfCounters::COUNTER_COUNT];
+			size_t size_;
+		};
+
+#ifdef HAVE_LINUX_PERF_EVENT_H
+		void configure(PerfCounters::Counter counter, perf_event_attr &attr)
+		{
+			const std::uint64_t readMiss =
+				(PERF_COUNT_HW_CACHE_OP_READ << 8)
+				| (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+			switch(counter)
+			{
+			case PerfCounters::CYCLES:
+				attr.type = PERF_TYPE_HARDWARE;
+				attr.config = PERF_COUNT_HW_CPU_CYCLES;
+				break;
+			case PerfCounters::INSTRUCTIONS:
+				attr.type = PERF_TYPE_HARDWARE;
+				attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+				break;
+			case PerfCounters::LLC_MISSES:
+				attr.type = PERF_TYPE_HW_CACHE;
+				attr.config = PERF_COUNT_HW_CACHE_LL | readMiss;
+				break;
+			case PerfCounters::DTLB_MISSES:
+				attr.type = PERF_TYPE_HW_CACHE;
+				attr.config = PERF_COUNT_HW_CACHE_DTLB | readMiss;
+				break;
+			case PerfCounters::BRANCH_MISSES:
+				attr.type = PERF_TYPE_HARDWARE;
+				attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+				break;
+			case PerfCounters::COUNTER_COUNT:
+			default:
+				break;
+			}
+		}
+
+		int openCounter(PerfCounters::Counter counter, int groupFd)
+		{
+			perf_event_attr attr;
+			std::memset(&attr, 0, sizeof(attr));
+			attr.size = sizeof(attr);
+			configure(counter, attr);
+			attr.read_format = PERF_FORMAT_GROUP
+				| PERF_FORMAT_TOTAL_TIME_ENABLED
+				| PERF_FORMAT_TOTAL_TIME_RUNNING;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+
+			// this thread, any CPU
+			return static_cast<int>(
+					syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0));
+		}
+#endif
+
+		CounterGroup::CounterGroup() : size_(0)
+		{
+#ifdef HAVE_LINUX_PERF_EVENT_H
+			for(size_t i = 0; i < PerfCounters::COUNTER_COUNT; ++i)
+			{
+				int fd = openCounter(static_cast<PerfCounters::Counter>(i),
+						size_ ? fds_[0] : -1);
+				if(fd < 0)
+					continue;
+				fds_[size_] = fd;
+				counters_[size_] = static_cast<int>(i);
+				++size_;
+			}
+#endif
+		}
+
+		CounterGroup::~CounterGroup()
+		{
+#ifdef HAVE_LINUX_PERF_EVENT_H
+			// close the members before the leader
+			while(size_)
+				close(fds_[--size_]);
+#endif
+		}
+
+		bool CounterGroup::read(
+				long long *counts,
+				unsigned long long &enabled,
+				unsigned long long &running) const
+		{
+			for(size_t i = 0; i < PerfCounters::COUNTER_COUNT; ++i)
+				counts[i] = -1;
+			enabled = running = 0;
+
+#ifdef HAVE_LINUX_PERF_EVENT_H
+			if(!size_)
+				return false;
+
+			// nr, time enabled, time running, one value per counter
+			std::uint64_t buffer[3 + PerfCounters::COUNTER_COUNT];
+			ssize_t bytes = ::read(fds_[0], buffer, sizeof(buffer));
+			if(bytes < static_cast<ssize_t>(3 * sizeof(std::uint64_t))
+					|| buffer[0] != size_)
+				return false;
+
+			enabled = buffer[1];
+			running = buffer[2];
+			for(size_t i = 0; i < size_; ++i)
+				counts[counters_[i]] = static_cast<long long>(buffer[3 + i]);
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		const CounterGroup &threadCounters()
+		{
+			thread_local CounterGroup counters;
+			return counters;
+		}
+
+	} // namespace
+
+	PerfCounters::Sample::Sample()
+		: started_(false), enabled_(0), running_(0)
+	{
+		for(size_t i = 0; i < COUNTER_COUNT; ++i)
+			counts_[i] = -1;
+	}
+
+	void PerfCounters::Sample::start()
+	{
+		started_ = threadCounters().read(counts_, enabled_, running_);
+	}
+
+	bool PerfCounters::Sample::stop(Values &values) const
+	{
+		long long counts[COUNTER_COUNT];
+		unsigned long long enabled, running;
+		if(!started_ || !threadCounters().read(counts, enabled, running))
+			return false;
+
+		// the group was not scheduled on the PMU during the sample
+		unsigned long long enabledDelta = enabled - enabled_;
+		unsigned long long runningDelta = running - running_;
+		if(runningDelta == 0)
+			return false;
+
+		// extrapolate if the group shared the PMU with other events
+		double scale = static_cast<double>(enabledDelta) / runningDelta;
+		for(size_t i = 0; i < COUNTER_COUNT; ++i)
+			values.counts[i] = counts[i] < 0 || counts_[i] < 0
+				? -1
+				: static_cast<long long>((counts[i] - counts_[i]) * scale);
+		return true;
+	}
+
+	PerfCounters::Summary::Summary() : samples(0)
+	{
+		for(size_t i = 0; i < COUNTER_COUNT; ++i)
+		{
+			counts[i] = 0;
+			counted[i] = false;
+		}
+	}
+
+	PerfCounters::PerfCounters() : enabled_(false) { }
+
+	void PerfCounters::enable(bool enabled)
+	{
+		enabled_ = enabled;
+	}
+
+	bool PerfCounters::available()
+	{
+		return threadCounters().available();
+	}
+
+	const char *PerfCounters::counterName(Counter counter)
+	{
+		switch(counter)
+		{
+		case CYCLES: return "cycles";
+		case INSTRUCTIONS: return "instructions";
+		case LLC_MISSES: return "LLC misses";
+		case DTLB_MISSES: return "dTLB misses";
+		case BRANCH_MISSES: return "branch misses";
+		case COUNTER_COUNT:
+		default: return "unknown";
+		}
+	}
+
+	void PerfCounters::record(
+			const string &pass,
+			const string &kind,
+			const Values &values)
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+		Summary &summary = summaries_[make_pair(pass, kind)];
+		++summary.samples;
+		for(size_t i = 0; i < COUNTER_COUNT; ++i)
+			if(values.counts[i] >= 0)
+			{
+				summary.counts[i] += values.counts[i];
+				summary.counted[i] = true;
+			}
+	}
+
+	void PerfCounters::record(
+			const string &pass,
+			const string &kind,
+			const Sample &sample)
+	{
+		Values values;
+		if(sample.stop(values))
+			record(pass, kind, values);
+	}
+
+	void PerfCounters::print(std::ostream &out, bool csv) const
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+		if(summaries_.empty()) return;
+
+		StreamFormatGuard format(out);
+		out.setf(ios::fixed, ios::floatfield);
+		out.precision(2);
+
+		if(csv)
+			out << "pass,kind,samples,cycles,instructions,ipc,llcmisses,"
+				<< "dtlbmisses,branchmisses" << endl;
+		else
+			out << "perf counters (sampling thread only, work handed to "
+				<< "other threads is not counted):" << endl;
+
+		for(const auto &entry : summaries_)
+		{
+			const Summary &summary = entry.second;
+			bool ipc = summary.counted[CYCLES] && summary.counted[INSTRUCTIONS]
+				&& summary.counts[CYCLES] > 0;
+
+			if(csv)
+			{
+				out << entry.first.first << ","
+					<< entry.first.second << ","
+					<< summary.samples;
+				for(size_t i = 0; i < COUNTER_COUNT; ++i)
+				{
+					out << ",";
+					if(summary.counted[i])
+						out << summary.counts[i];
+					if(i == INSTRUCTIONS)
+					{
+						out << ",";
+						if(ipc)
+							out << summary.counts[INSTRUCTIONS]
+								/ static_cast<double>(summary.counts[CYCLES]);
+					}
+				}
+				out << endl;
+				continue;
+			}
+
+			out << entry.first.first << " " << entry.first.second << ": "
+				<< summary.samples << " samples";
+			for(size_t i = 0; i < COUNTER_COUNT; ++i)
+				if(summary.counted[i])
+					out << ", " << summary.counts[i] << " "
+						<< counterName(static_cast<Counter>(i));
+			if(ipc)
+				out << ", "
+					<< summary.counts[INSTRUCTIONS]
+						/ static_cast<double>(summary.counts[CYCLES])
+					<< " IPC";
+			out << endl;
+		}
+	}
+
+	void PerfCounters::clear()
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+		summaries_.clear();
+	}
+
+} // namespace sharp
@@ -0,0 +1,151 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include "SemiJoinReducer.hpp"
+
+#include "HashIndex.hpp"
+#include "util/concurrent.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+#include <cstdint>
+
+namespace sharp
+{
+	using htd::vertex_t;
+	using htd::ITreeDecomposition;
+
+	using std::size_t;
+	using std::vector;
+	using std::pair;
+	using std::make_pair;
+
+	SemiJoinReducer::SemiJoinReducer(
+			const ITupleProjection &projection,
+			unsigned int threadCount)
+		: projection_(projection),
+		  threadCount_(threadCount ? threadCount : 1)
+	{ }
+
+	SemiJoinReducer::~SemiJoinReducer() { }
+
+	size_t SemiJoinReducer::reduce(
+			const ITreeDecomposition &td,
+			INodeTupleSetMap &tuples) const
+	{
+		// edges in breadth-first order, so that the edges out of the child
+		// of edge i are consecutive, starting at firstEdges[i]
+		vector<pair<vertex_t, size_t> > edges;
+		vector<size_t> firstEdges;
+		size_t rootEdges = td.childCount(td.root());
+		for(size_t childIndex = 0; childIndex < rootEdges; ++childIndex)
+			edges.push_back(make_pair(td.root(), childIndex));
+		for(size_t i = 0; i < edges.size(); ++i)
+		{
+			vertex_t child = td.childAtPosition(edges[i].first, edges[i].second);
+			firstEdges.push_back(edges.size());
+			size_t childCount = td.childCount(child);
+			for(size_t childIndex = 0; childIndex < childCount; ++childIndex)
+				edges.push_back(make_pair(child, childIndex));
+		}
+		firstEdges.push_back(edges.size());
+
+		if(edges.empty())
+			return 0;
+
+		// An edge is reduced as soon as the edge into its parent is done,
+		// so that subtrees do not wait for each other.
+		vector<size_t> removedPerEdge(edges.size(), 0);
+		// edges that are ready or being reduced
+		std::atomic<size_t> active(rootEdges);
+		TaskQueue queue;
+		for(size_t i = 0; i < rootEdges; ++i)
+			queue.schedule(i);
+		queue.run(std::min<size_t>(threadCount_, edges.size()), [&](size_t i)
+		{
+			vertex_t parent = edges[i].first;
+			vertex_t child = td.childAtPosition(parent, edges[i].second);
+			if(tuples.contains(parent) && tuples.contains(child))
+			{
+				// an edge that is reduced on its own gets all threads for
+				// hashing
+				unsigned int innerThreads = active == 1 ? threadCount_ : 1;
+				removedPerEdge[i] = this->reduce(
+						parent,
+						edges[i].second,
+						td,
+						tuples[parent],
+						tuples[child],
+						innerThreads);
+			}
+
+			active += firstEdges[i + 1] - firstEdges[i];
+			for(size_t next = firstEdges[i]; next < firstEdges[i + 1]; ++next)
+				queue.schedule(next);
+			--active;
+		});
+
+		size_t removed = 0;
+		for(size_t count : removedPerEdge)
+			removed += count;
+		return removed;
+	}
+
+	size_t SemiJoinReducer::reduce(
+			vertex_t parent,
+			size_t childIndex,
+			const ITreeDecomposition &td,
+			ITupleSet &parentTuples,
+			ITupleSet &childTuples,
+			unsigned int threadCount) const
+	{
+		vertex_t child = td.childAtPosition(parent, childIndex);
+		HashIndex::TupleVector parents = HashIndex::gather(parentTuples);
+		HashIndex::TupleVector children = HashIndex::gather(childTuples);
+
+		vector<size_t> parentHashes = HashIndex::hashAll(parents,
+				[&](const ITuple &tuple)
+				{
+					return projection_.projectionHash(parent, child, tuple, td);
+				},
+				threadCount);
+		HashIndex index(parents, parentHashes);
+
+		vector<size_t> hashes = HashIndex::hashAll(children,
+				[&](const ITuple &tuple)
+				{
+					return projection_.projectionHash(child, parent, tuple, td);
+				},
+				threadCount);
+		HashJoin::KeyEqual equal =
+			[&](const ITuple &parentTuple, const ITuple &childTuple)
+			{
+				return projection_.projectionsEqual(
+						parent, parentTuple, child, childTuple, td);
+			};
+
+		size_t removed = 0;
+		vector<bool> keep(children.size(), false);
+		for(size_t i = 0; i < children.size(); ++i)
+		{
+			index.probe(*children[i], hashes[i], equal,
+					[&](const ITuple &) { keep[i] = true; });
+			if(!keep[i]) ++removed;
+		}
+
+		if(!removed)
+			return 0;
+		childTuples.retain(keep);
+
+		// siblings share the parent, but each one only touches the links
+		// into itself
+		if(parentTuples.hasOrigins())
+			parentTuples.remapOrigins(childIndex,
+					ITupleSet::retainedPositions(keep));
+		return removed;
+	}
+
+} // namespace sharp
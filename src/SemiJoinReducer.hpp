@@ -0,0 +1,52 @@
+#ifndef SHARP_SEMIJOINREDUCER_H_
+#define SHARP_SEMIJOINREDUCER_H_
+
+#include <sharp/global>
+
+#include <sharp/ITupleProjection.hpp>
+#include <sharp/ITupleSet.hpp>
+#include <sharp/INodeTupleSetMap.hpp>
+
+#include <htd/main.hpp>
+
+#include <cstddef>
+
+namespace sharp
+{
+	// Top-down semi-join pass (as in Yannakakis' algorithm) that removes
+	// every tuple without a matching tuple in the parent node. A node is
+	// reduced as soon as its parent is, so that different subtrees are
+	// reduced concurrently. Nodes whose own or whose parent's tuple set has
+	// been erased are skipped. Provenance links of the parent are updated
+	// to the new positions of the child tuples.
+	class SHARP_LOCAL SemiJoinReducer
+	{
+	public:
+		SemiJoinReducer(
+				const ITupleProjection &projection,
+				unsigned int threadCount);
+
+		~SemiJoinReducer();
+
+		// returns the number of removed tuples
+		std::size_t reduce(
+				const htd::ITreeDecomposition &decomposition,
+				INodeTupleSetMap &tuples) const;
+
+	private:
+		std::size_t reduce(
+				htd::vertex_t parent,
+				std::size_t childIndex,
+				const htd::ITreeDecomposition &decomposition,
+				ITupleSet &parentTuples,
+				ITupleSet &childTuples,
+				unsigned int threadCount) const;
+
+		const ITupleProjection &projection_;
+		unsigned int threadCount_;
+
+	}; // class SemiJoinReducer
+
+} // namespace sharp
+
+#endif // SHARP_SEMIJOINREDUCER_H_
@@ -0,0 +1,37 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include "SingleSolutionCursor.hpp"
+
+namespace sharp
+{
+	using std::size_t;
+
+	SingleSolutionCursor::SingleSolutionCursor(ISolution *solution)
+		: solution_(solution)
+	{ }
+
+	SingleSolutionCursor::~SingleSolutionCursor()
+	{
+		delete solution_;
+	}
+
+	ISolution *SingleSolutionCursor::next()
+	{
+		ISolution *solution = solution_;
+		solution_ = nullptr;
+		return solution;
+	}
+
+	size_t SingleSolutionCursor::skip(size_t count)
+	{
+		if(!count || !solution_)
+			return 0;
+
+		delete solution_;
+		solution_ = nullptr;
+		return 1;
+	}
+
+} // namespace sharp
@@ -0,0 +1,28 @@
+#ifndef SHARP_SINGLESOLUTIONCURSOR_H_
+#define SHARP_SINGLESOLUTIONCURSOR_H_
+
+#include <sharp/ISolutionCursor.hpp>
+
+#include <cstddef>
+
+namespace sharp
+{
+	// Cursor over at most one solution, which it owns until it is
+	// returned. A null solution gives an empty cursor.
+	class SHARP_LOCAL SingleSolutionCursor : public ISolutionCursor
+	{
+	public:
+		SingleSolutionCursor(ISolution *solution);
+		virtual ~SingleSolutionCursor() override;
+
+		virtual ISolution *next() override;
+		virtual std::size_t skip(std::size_t count) override;
+
+	private:
+		ISolution *solution_;
+
+	}; // class SingleSolutionCursor
+
+} // namespace sharp
+
+#endif // SHARP_SINGLESOLUTIONCURSOR_H_
@@ -0,0 +1,52 @@
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include "StreamingTreeTupleAlgorithm.hpp"
+
+#include "TupleStreamSink.hpp"
+
+namespace sharp
+{
+	using htd::vertex_t;
+	using htd::ITreeDecomposition;
+	using htd::ILabelingFunction;
+
+	using std::vector;
+
+	StreamingTreeTupleAlgorithm::StreamingTreeTupleAlgorithm(
+			const ITreeTupleAlgorithm &algorithm1,
+			const ITreeTupleStreamAlgorithm &algorithm2)
+		: algorithm1_(algorithm1), algorithm2_(algorithm2)
+	{ }
+
+	StreamingTreeTupleAlgorithm::~StreamingTreeTupleAlgorithm() { }
+
+	vector<const ILabelingFunction *>
+	StreamingTreeTupleAlgorithm::preprocessOperations() const
+	{
+		return algorithm1_.preprocessOperations();
+	}
+
+	void StreamingTreeTupleAlgorithm::evaluateNode(
+			vertex_t node,
+			const ITreeDecomposition &decomposition,
+			INodeTupleSetMap &tuples,
+			const IInstance &instance,
+			ITupleSet &outputTuples) const
+	{
+		TupleStreamSink sink(algorithm2_, node, decomposition, tuples,
+				instance, outputTuples);
+
+		algorithm1_.evaluateNode(node, decomposition, tuples, instance, sink);
+		algorithm2_.finishNode(node, decomposition, tuples, instance,
+				outputTuples);
+	}
+
+	bool StreamingTreeTupleAlgorithm::needAllTupleSets() const
+	{
+		return algorithm1_.needAllTupleSets()
+			|| algorithm2_.needAllTupleSets();
+	}
+
+} // namespace sharp
@@ -0,0 +1,42 @@
+#ifndef SHARP_STREAMINGTREETUPLEALGORITHM_H_
+#define SHARP_STREAMINGTREETUPLEALGORITHM_H_
+
+#include <sharp/global>
+
+#include <sharp/ITreeTupleAlgorithm.hpp>
+#include <sharp/ITreeTupleStreamAlgorithm.hpp>
+
+namespace sharp
+{
+	// Interleaves two algorithms without materializing the output of the
+	// first one: its tuples are fed into the second one as they are
+	// emitted (cf. InterleavedTreeTupleAlgorithm).
+	class SHARP_LOCAL StreamingTreeTupleAlgorithm : public ITreeTupleAlgorithm
+	{
+		const ITreeTupleAlgorithm &algorithm1_;
+		const ITreeTupleStreamAlgorithm &algorithm2_;
+
+	public:
+		StreamingTreeTupleAlgorithm(
+				const ITreeTupleAlgorithm &algorithm1,
+				const ITreeTupleStreamAlgorithm &algorithm2);
+
+		virtual ~StreamingTreeTupleAlgorithm() override;
+
+		virtual std::vector<const htd::ILabelingFunction *>
+			preprocessOperations() const override;
+
+		virtual void evaluateNode(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				INodeTupleSetMap &tuples,
+				const IInstance &instance,
+				ITupleSet &outputTuples) const override;
+
+		virtual bool needAllTupleSets() const override;
+
+	}; // class StreamingTreeTupleAlgorithm
+
+} // namespace sharp
+
+#endif // SHARP_STREAMINGTREETUPLEALGORITHM_H_
@@ -0,0 +1,39 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include "TableOwningSolutionCursor.hpp"
+
+#include <utility>
+
+namespace sharp
+{
+	using htd::ITreeDecomposition;
+
+	using std::size_t;
+	using std::unique_ptr;
+
+	TableOwningSolutionCursor::TableOwningSolutionCursor(
+			unique_ptr<ISolutionCursor> cursor,
+			unique_ptr<INodeTableMap> tables,
+			unique_ptr<INodeTableMap> topDownTables,
+			unique_ptr<ITreeDecomposition> decomposition)
+		: decomposition_(std::move(decomposition)),
+		  tables_(std::move(tables)),
+		  topDownTables_(std::move(topDownTables)),
+		  cursor_(std::move(cursor))
+	{ }
+
+	TableOwningSolutionCursor::~TableOwningSolutionCursor() { }
+
+	ISolution *TableOwningSolutionCursor::next()
+	{
+		return cursor_->next();
+	}
+
+	size_t TableOwningSolutionCursor::skip(size_t count)
+	{
+		return cursor_->skip(count);
+	}
+
+} // namespace sharp
@@ -0,0 +1,43 @@
+#ifndef SHARP_TABLEOWNINGSOLUTIONCURSOR_H_
+#define SHARP_TABLEOWNINGSOLUTIONCURSOR_H_
+
+#include <sharp/ISolutionCursor.hpp>
+#include <sharp/INodeTableMap.hpp>
+
+#include <htd/main.hpp>
+
+#include <memory>
+#include <cstddef>
+
+namespace sharp
+{
+	// Returned by IterativeTreeSolver::enumerate: forwards to the cursor
+	// of the extractor and keeps the node tables (and the decomposition,
+	// if the solver computed it) alive for as long as that cursor needs
+	// them.
+	class SHARP_LOCAL TableOwningSolutionCursor : public ISolutionCursor
+	{
+	public:
+		TableOwningSolutionCursor(
+				std::unique_ptr<ISolutionCursor> cursor,
+				std::unique_ptr<INodeTableMap> tables,
+				std::unique_ptr<INodeTableMap> topDownTables,
+				std::unique_ptr<htd::ITreeDecomposition> decomposition);
+
+		virtual ~TableOwningSolutionCursor() override;
+
+		virtual ISolution *next() override;
+		virtual std::size_t skip(std::size_t count) override;
+
+	private:
+		// declared in reverse order of destruction: the cursor goes first
+		std::unique_ptr<htd::ITreeDecomposition> decomposition_;
+		std::unique_ptr<INodeTableMap> tables_;
+		std::unique_ptr<INodeTableMap> topDownTables_;
+		std::unique_ptr<ISolutionCursor> cursor_;
+
+	}; // class TableOwningSolutionCursor
+
+} // namespace sharp
+
+#endif // SHARP_TABLEOWNINGSOLUTIONCURSOR_H_
@@ -0,0 +1,70 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <sharp/TupleRange.hpp>
+
+#include "util/concurrent.hpp"
+
+#include <stdexcept>
+
+namespace sharp
+{
+	using std::size_t;
+	using std::vector;
+	using std::shared_ptr;
+
+	TupleRange::TupleRange()
+		: tuples_(nullptr), size_(0)
+	{ }
+
+	TupleRange::TupleRange(const ITuple * const *tuples, size_t size)
+		: tuples_(tuples), size_(size)
+	{ }
+
+	TupleRange::TupleRange(const shared_ptr<const Storage> &storage)
+		: storage_(storage),
+		  tuples_(storage->empty() ? nullptr : &(*storage)[0]),
+		  size_(storage->size())
+	{ }
+
+	TupleRange::~TupleRange() { }
+
+	TupleRange TupleRange::subrange(size_t begin, size_t end) const
+	{
+		if(begin > end || end > size_)
+			throw std::out_of_range("Invalid subrange of tuple range.");
+
+		TupleRange range(*this);
+		range.tuples_ = tuples_ + begin;
+		range.size_ = end - begin;
+		return range;
+	}
+
+	vector<TupleRange> TupleRange::split(size_t count) const
+	{
+		if(count == 0)
+			throw std::invalid_argument("Cannot split into zero ranges.");
+		if(count > size_) count = size_;
+
+		vector<TupleRange> parts;
+		parts.reserve(count);
+		size_t base = count ? size_ / count : 0;
+		size_t extra = count ? size_ % count : 0;
+		for(size_t i = 0, begin = 0; i < count; ++i)
+		{
+			size_t end = begin + base + (i < extra ? 1 : 0);
+			parts.push_back(subrange(begin, end));
+			begin = end;
+		}
+		return parts;
+	}
+
+	void TupleRange::forEachPart(
+			const vector<TupleRange> &parts,
+			const std::function<void(const TupleRange &)> &f)
+	{
+		runConcurrently(parts.size(), [&](size_t i) { f(parts[i]); });
+	}
+
+} // namespace sharp
@@ -4,6 +4,7 @@
 
 #include "TupleSet.hpp"
 #include <cassert>
+#include <stdexcept>
 
 namespace sharp
 {
@@ -11,6 +12,9 @@ namespace sharp
 	using std::size_t;
 	using std::pair;
 	using std::make_pair;
+	using std::uint32_t;
+
+	const uint32_t ITupleSet::NO_ORIGIN;
 
 	TupleSet::TupleSet() { }
 
@@ -25,7 +29,7 @@ namespace sharp
 		//FIXME: double inserts
 		set_.push_back(tuple);
 		return make_pair(iterator(new Enum(
-						set_.begin() + set_.size() - 2, set_.end())), true);
+						set_.end() - 1, set_.end())), true);
 	}
 
 	ITuple* TupleSet::operator[](int pos)
@@ -37,6 +41,9 @@ namespace sharp
 	{
 		assert(pos < set_.size());
 		set_.erase(set_.begin() + pos);
+		for(vector<uint32_t> &origins : origins_)
+			if(pos < origins.size())
+				origins.erase(origins.begin() + pos);
 	}
 
 	TupleSet::size_type TupleSet::erase(const ITuple &tuple)
@@ -46,8 +53,18 @@ namespace sharp
 		for(size_t i = 0; i < set_.size(); ++i)
 			if(set_[i] == (ITuple *)&tuple)
 			{
+				size_t last = set_.size() - 1;
 				std::swap(*(set_.begin() + i), *(set_.end() - 1));
 				set_.pop_back();
+				for(vector<uint32_t> &origins : origins_)
+				{
+					if(i < origins.size())
+						origins[i] = last < origins.size()
+							? origins[last]
+							: uint32_t(NO_ORIGIN);
+					if(origins.size() > last)
+						origins.resize(last);
+				}
 				//set_.erase(set_.begin() + i);
 				++ret;
 				break;
@@ -120,4 +137,83 @@ namespace sharp
 				new ConstEnum(set_.begin() + i, set_.end()));
 	}
 
+	void TupleSet::retain(const vector<bool> &keep)
+	{
+		if(keep.size() != set_.size())
+			throw std::invalid_argument("Argument 'keep' must have one "
+					"entry per tuple!");
+
+		size_t kept = 0;
+		for(size_t i = 0; i < set_.size(); ++i)
+		{
+			if(keep[i])
+				set_[kept++] = set_[i];
+			else
+				delete set_[i];
+		}
+		set_.resize(kept);
+
+		for(vector<uint32_t> &origins : origins_)
+		{
+			size_t keptOrigins = 0;
+			for(size_t i = 0; i < origins.size(); ++i)
+				if(keep[i])
+					origins[keptOrigins++] = origins[i];
+			origins.resize(keptOrigins);
+		}
+	}
+
+	void TupleSet::setOrigin(
+			size_type pos,
+			size_type childPosition,
+			uint32_t origin)
+	{
+		if(pos >= set_.size())
+			throw std::out_of_range("No tuple at the given position.");
+
+		if(origins_.size() <= childPosition)
+			origins_.resize(childPosition + 1);
+		vector<uint32_t> &origins = origins_[childPosition];
+		if(origins.size() <= pos)
+			origins.resize(set_.size(), uint32_t(NO_ORIGIN));
+		origins[pos] = origin;
+	}
+
+	uint32_t TupleSet::origin(size_type pos, size_type childPosition) const
+	{
+		if(childPosition >= origins_.size()
+				|| pos >= origins_[childPosition].size())
+			return NO_ORIGIN;
+		return origins_[childPosition][pos];
+	}
+
+	bool TupleSet::hasOrigins() const
+	{
+		return !origins_.empty();
+	}
+
+	void TupleSet::remapOrigins(
+			size_type childPosition,
+			const vector<uint32_t> &newPositions)
+	{
+		if(childPosition >= origins_.size())
+			return;
+
+		for(uint32_t &origin : origins_[childPosition])
+			if(origin != NO_ORIGIN)
+				origin = origin < newPositions.size()
+					? newPositions[origin]
+					: uint32_t(NO_ORIGIN);
+	}
+
+	ITuple * const *TupleSet::data()
+	{
+		return set_.data();
+	}
+
+	const ITuple * const *TupleSet::data() const
+	{
+		return set_.data();
+	}
+
 } // namespace sharp
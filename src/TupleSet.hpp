@@ -6,6 +6,7 @@
 #include <sharp/ITupleSet.hpp>
 
 #include <vector>
+#include <cstdint>
 
 namespace sharp
 {
@@ -30,9 +31,29 @@ namespace sharp
 		virtual const_iterator begin() const;
 		virtual const_iterator end() const;
 		virtual const_iterator find(const ITuple &tuple) const;
+
+		virtual void retain(const std::vector<bool> &keep);
+
+		virtual void setOrigin(
+				size_type pos,
+				size_type childPosition,
+				std::uint32_t origin);
+		virtual std::uint32_t origin(
+				size_type pos,
+				size_type childPosition) const;
+		virtual bool hasOrigins() const;
+		virtual void remapOrigins(
+				size_type childPosition,
+				const std::vector<std::uint32_t> &newPositions);
+
+		virtual ITuple * const *data();
+		virtual const ITuple * const *data() const;
 		
 	private:
 		std::vector<ITuple *> set_;
+		// one array of provenance links per child, possibly shorter than
+		// set_ if the last tuples have no links
+		std::vector<std::vector<std::uint32_t> > origins_;
 
 		typedef std::vector<ITuple *>::iterator internal_iterator;
 		typedef std::vector<ITuple *>::const_iterator
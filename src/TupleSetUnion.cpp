@@ -0,0 +1,163 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include "TupleSetUnion.hpp"
+
+#include <stdexcept>
+
+namespace sharp
+{
+	using std::vector;
+	using std::size_t;
+	using std::pair;
+
+	TupleSetUnion::TupleSetUnion(const vector<ITupleSet *> &sets)
+		: sets_(sets)
+	{ }
+
+	TupleSetUnion::~TupleSetUnion()
+	{
+		for(ITupleSet *set : sets_)
+			delete set;
+	}
+
+	pair<TupleSetUnion::iterator, bool> TupleSetUnion::insert(ITuple *)
+	{
+		throw std::logic_error("Cannot insert into a tuple set union.");
+	}
+
+	TupleSetUnion::size_type TupleSetUnion::erase(const ITuple &)
+	{
+		throw std::logic_error("Cannot erase from a tuple set union.");
+	}
+
+	void TupleSetUnion::erase(const size_t)
+	{
+		throw std::logic_error("Cannot erase from a tuple set union.");
+	}
+
+	ITuple* TupleSetUnion::operator[](int pos)
+	{
+		for(ITupleSet *set : sets_)
+		{
+			int size = static_cast<int>(set->size());
+			if(pos < size) return (*set)[pos];
+			pos -= size;
+		}
+		throw std::out_of_range("Tuple set union index out of range.");
+	}
+
+	IEnumerator<ITuple> *TupleSetUnion::enumerate()
+	{
+		vector<IEnumerator<ITuple> *> parts;
+		parts.reserve(sets_.size());
+		for(ITupleSet *set : sets_)
+			parts.push_back(set->enumerate());
+		return new Enum(parts);
+	}
+
+	TupleSetUnion::iterator TupleSetUnion::begin()
+	{
+		return iterator(this->enumerate());
+	}
+
+	TupleSetUnion::iterator TupleSetUnion::end()
+	{
+		return iterator(new Enum());
+	}
+
+	TupleSetUnion::iterator TupleSetUnion::find(const ITuple &tuple)
+	{
+		// continue with the remaining sets after the one containing tuple
+		for(size_t i = 0; i < sets_.size(); ++i)
+		{
+			if(!sets_[i]->contains(tuple)) continue;
+
+			vector<IEnumerator<ITuple> *> parts;
+			parts.push_back(new Enumerator<ITuple, iterator>(
+						sets_[i]->find(tuple), sets_[i]->end()));
+			for(size_t j = i + 1; j < sets_.size(); ++j)
+				parts.push_back(sets_[j]->enumerate());
+			return iterator(new Enum(parts));
+		}
+
+		return this->end();
+	}
+
+	TupleSetUnion::size_type TupleSetUnion::size() const
+	{
+		size_type size = 0;
+		for(const ITupleSet *set : sets_)
+			size += set->size();
+		return size;
+	}
+
+	bool TupleSetUnion::contains(const ITuple &tuple) const
+	{
+		for(const ITupleSet *set : sets_)
+			if(set->contains(tuple))
+				return true;
+		return false;
+	}
+
+	IConstEnumerator<ITuple> *TupleSetUnion::enumerate() const
+	{
+		vector<IConstEnumerator<ITuple> *> parts;
+		parts.reserve(sets_.size());
+		for(const ITupleSet *set : sets_)
+			parts.push_back(set->enumerate());
+		return new ConstEnum(parts);
+	}
+
+	TupleSetUnion::const_iterator TupleSetUnion::begin() const
+	{
+		return const_iterator(this->enumerate());
+	}
+
+	TupleSetUnion::const_iterator TupleSetUnion::end() const
+	{
+		return const_iterator(new ConstEnum());
+	}
+
+	TupleSetUnion::const_iterator TupleSetUnion::find(
+			const ITuple &tuple) const
+	{
+		for(size_t i = 0; i < sets_.size(); ++i)
+		{
+			const ITupleSet *set = sets_[i];
+			if(!set->contains(tuple)) continue;
+
+			vector<IConstEnumerator<ITuple> *> parts;
+			parts.push_back(new ConstEnumerator<ITuple, const_iterator>(
+						set->find(tuple), set->end()));
+			for(size_t j = i + 1; j < sets_.size(); ++j)
+				parts.push_back(
+						static_cast<const ITupleSet *>(sets_[j])->enumerate());
+			return const_iterator(new ConstEnum(parts));
+		}
+
+		return this->end();
+	}
+
+	std::uint32_t TupleSetUnion::origin(
+			size_type pos,
+			size_type childPosition) const
+	{
+		for(const ITupleSet *set : sets_)
+		{
+			if(pos < set->size()) return set->origin(pos, childPosition);
+			pos -= set->size();
+		}
+		return NO_ORIGIN;
+	}
+
+	bool TupleSetUnion::hasOrigins() const
+	{
+		for(const ITupleSet *set : sets_)
+			if(set->hasOrigins())
+				return true;
+		return false;
+	}
+
+} // namespace sharp
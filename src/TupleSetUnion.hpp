@@ -0,0 +1,50 @@
+#ifndef SHARP_TUPLESETUNION_H_
+#define SHARP_TUPLESETUNION_H_
+
+#include <sharp/ITupleSet.hpp>
+
+#include <vector>
+
+namespace sharp
+{
+	// Read-only view that presents several tuple sets as one, in the order
+	// they are given. The view owns the sets; tuples are neither copied nor
+	// deduplicated, and insert and erase throw.
+	class SHARP_LOCAL TupleSetUnion : public ITupleSet
+	{
+	public:
+		TupleSetUnion(const std::vector<ITupleSet *> &sets);
+		virtual ~TupleSetUnion();
+
+		virtual std::pair<iterator, bool> insert(ITuple *tuple);
+		virtual size_type erase(const ITuple &tuple);
+		virtual void erase(const size_t pos);
+		virtual IEnumerator<ITuple> *enumerate();
+		virtual iterator begin();
+		virtual iterator end();
+		virtual iterator find(const ITuple &tuple);
+
+		virtual size_type size() const;
+		virtual ITuple* operator[](int pos);
+		virtual bool contains(const ITuple &tuple) const;
+		virtual IConstEnumerator<ITuple> *enumerate() const;
+		virtual const_iterator begin() const;
+		virtual const_iterator end() const;
+		virtual const_iterator find(const ITuple &tuple) const;
+
+		virtual std::uint32_t origin(
+				size_type pos,
+				size_type childPosition) const;
+		virtual bool hasOrigins() const;
+
+	private:
+		std::vector<ITupleSet *> sets_;
+
+		typedef ConcatEnumerator<ITuple> Enum;
+		typedef ConcatConstEnumerator<ITuple> ConstEnum;
+
+	}; // class TupleSetUnion
+
+} // namespace sharp
+
+#endif // SHARP_TUPLESETUNION_H_
@@ -0,0 +1,114 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include "TupleStreamSink.hpp"
+
+#include <stdexcept>
+
+namespace sharp
+{
+	using htd::vertex_t;
+	using htd::ITreeDecomposition;
+
+	using std::size_t;
+	using std::pair;
+	using std::make_pair;
+
+	TupleStreamSink::TupleStreamSink(
+			const ITreeTupleStreamAlgorithm &algorithm,
+			vertex_t node,
+			const ITreeDecomposition &decomposition,
+			INodeTupleSetMap &tuples,
+			const IInstance &instance,
+			ITupleSet &outputTuples)
+		: algorithm_(algorithm),
+		  node_(node),
+		  decomposition_(decomposition),
+		  tuples_(tuples),
+		  instance_(instance),
+		  outputTuples_(outputTuples),
+		  count_(0)
+	{ }
+
+	TupleStreamSink::~TupleStreamSink() { }
+
+	pair<TupleStreamSink::iterator, bool> TupleStreamSink::insert(
+			ITuple *tuple)
+	{
+		if(!tuple)
+			throw std::invalid_argument("Argument 'tuple' cannot be null!");
+
+		++count_;
+		algorithm_.evaluateTuple(node_, decomposition_, tuples_, instance_,
+				tuple, outputTuples_);
+		return make_pair(iterator(), true);
+	}
+
+	TupleStreamSink::size_type TupleStreamSink::erase(const ITuple &)
+	{
+		throw std::logic_error("Cannot erase from a streamed tuple set.");
+	}
+
+	void TupleStreamSink::erase(const size_t)
+	{
+		throw std::logic_error("Cannot erase from a streamed tuple set.");
+	}
+
+	ITuple* TupleStreamSink::operator[](int)
+	{
+		throw std::logic_error("Cannot access a streamed tuple set.");
+	}
+
+	IEnumerator<ITuple> *TupleStreamSink::enumerate()
+	{
+		throw std::logic_error("Cannot enumerate a streamed tuple set.");
+	}
+
+	TupleStreamSink::iterator TupleStreamSink::begin()
+	{
+		return iterator(this->enumerate());
+	}
+
+	TupleStreamSink::iterator TupleStreamSink::end()
+	{
+		return iterator(this->enumerate());
+	}
+
+	TupleStreamSink::iterator TupleStreamSink::find(const ITuple &)
+	{
+		throw std::logic_error("Cannot search a streamed tuple set.");
+	}
+
+	TupleStreamSink::size_type TupleStreamSink::size() const
+	{
+		return count_;
+	}
+
+	bool TupleStreamSink::contains(const ITuple &) const
+	{
+		throw std::logic_error("Cannot search a streamed tuple set.");
+	}
+
+	IConstEnumerator<ITuple> *TupleStreamSink::enumerate() const
+	{
+		throw std::logic_error("Cannot enumerate a streamed tuple set.");
+	}
+
+	TupleStreamSink::const_iterator TupleStreamSink::begin() const
+	{
+		return const_iterator(this->enumerate());
+	}
+
+	TupleStreamSink::const_iterator TupleStreamSink::end() const
+	{
+		return const_iterator(this->enumerate());
+	}
+
+	TupleStreamSink::const_iterator TupleStreamSink::find(
+			const ITuple &) const
+	{
+		throw std::logic_error("Cannot search a streamed tuple set.");
+	}
+
+} // namespace sharp
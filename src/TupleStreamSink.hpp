@@ -0,0 +1,59 @@
+#ifndef SHARP_TUPLESTREAMSINK_H_
+#define SHARP_TUPLESTREAMSINK_H_
+
+#include <sharp/ITupleSet.hpp>
+#include <sharp/ITreeTupleStreamAlgorithm.hpp>
+#include <sharp/INodeTupleSetMap.hpp>
+#include <sharp/IInstance.hpp>
+
+#include <htd/main.hpp>
+
+namespace sharp
+{
+	// Output set handed to the first algorithm of a streaming interleaved
+	// algorithm: every inserted tuple is passed on to the stream algorithm
+	// right away. The sink does not keep tuples, so it cannot be read.
+	class SHARP_LOCAL TupleStreamSink : public ITupleSet
+	{
+	public:
+		TupleStreamSink(
+				const ITreeTupleStreamAlgorithm &algorithm,
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				INodeTupleSetMap &tuples,
+				const IInstance &instance,
+				ITupleSet &outputTuples);
+
+		virtual ~TupleStreamSink();
+
+		virtual std::pair<iterator, bool> insert(ITuple *tuple);
+		virtual size_type erase(const ITuple &tuple);
+		virtual void erase(const size_t pos);
+		virtual IEnumerator<ITuple> *enumerate();
+		virtual iterator begin();
+		virtual iterator end();
+		virtual iterator find(const ITuple &tuple);
+
+		// number of tuples passed on so far
+		virtual size_type size() const;
+		virtual ITuple* operator[](int pos);
+		virtual bool contains(const ITuple &tuple) const;
+		virtual IConstEnumerator<ITuple> *enumerate() const;
+		virtual const_iterator begin() const;
+		virtual const_iterator end() const;
+		virtual const_iterator find(const ITuple &tuple) const;
+
+	private:
+		const ITreeTupleStreamAlgorithm &algorithm_;
+		htd::vertex_t node_;
+		const htd::ITreeDecomposition &decomposition_;
+		INodeTupleSetMap &tuples_;
+		const IInstance &instance_;
+		ITupleSet &outputTuples_;
+		size_type count_;
+
+	}; // class TupleStreamSink
+
+} // namespace sharp
+
+#endif // SHARP_TUPLESTREAMSINK_H_
@@ -0,0 +1,91 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <sharp/WideBitTuple.hpp>
+
+#include <sharp/Hash.hpp>
+
+#include <typeinfo>
+
+namespace sharp
+{
+	using std::size_t;
+	using std::uint64_t;
+
+	namespace
+	{
+		size_t wordsFor(size_t width)
+		{
+			return (width + WideBitTuple::WORD_WIDTH - 1)
+				/ WideBitTuple::WORD_WIDTH;
+		}
+	}
+
+	WideBitTuple::WideBitTuple(size_t width)
+		: width_(width), words_(wordsFor(width), 0)
+	{ }
+
+	WideBitTuple::WideBitTuple(size_t width, const uint64_t *words)
+		: width_(width), words_(words, words + wordsFor(width))
+	{ }
+
+	WideBitTuple::~WideBitTuple() { }
+
+	void WideBitTuple::insert(size_t position, bool value)
+	{
+		++width_;
+		if(words_.size() < wordsFor(width_))
+			words_.push_back(0);
+
+		size_t word = position / WORD_WIDTH;
+		size_t shift = position % WORD_WIDTH;
+
+		// carry the top bit of every word into the next one, back to front
+		for(size_t i = words_.size() - 1; i > word; --i)
+			words_[i] = (words_[i] << 1) | (words_[i - 1] >> (WORD_WIDTH - 1));
+
+		uint64_t low = words_[word] & ((uint64_t(1) << shift) - 1);
+		uint64_t high = words_[word] & ~low;
+		words_[word] = low | (high << 1) | (uint64_t(value) << shift);
+	}
+
+	void WideBitTuple::erase(size_t position)
+	{
+		size_t word = position / WORD_WIDTH;
+		size_t shift = position % WORD_WIDTH;
+
+		uint64_t low = words_[word] & ((uint64_t(1) << shift) - 1);
+		uint64_t high = shift + 1 < WORD_WIDTH
+			? (words_[word] >> (shift + 1)) << shift
+			: 0;
+		words_[word] = low | high;
+
+		for(size_t i = word + 1; i < words_.size(); ++i)
+		{
+			words_[i - 1] |= words_[i] << (WORD_WIDTH - 1);
+			words_[i] >>= 1;
+		}
+
+		--width_;
+		if(words_.size() > wordsFor(width_))
+			words_.pop_back();
+	}
+
+	size_t WideBitTuple::hash() const
+	{
+		Hash h;
+		h.add(words_.data(), words_.size() * sizeof(uint64_t));
+		h.add(width_);
+		return h.get();
+	}
+
+	bool WideBitTuple::operator==(const ITuple &other) const
+	{
+		if(typeid(other) != typeid(*this)) return false;
+		const WideBitTuple &tmpother =
+			static_cast<const WideBitTuple &>(other);
+		return width_ == tmpother.width_ && words_ == tmpother.words_;
+	}
+
+} // namespace sharp
@@ -4,8 +4,12 @@
 
 #include "IterativeTreeSolver.hpp"
 #include "IterativeTreeTupleSolver.hpp"
+#include "ConcurrentTreeAlgorithm.hpp"
+#include "ConcurrentTreeTupleAlgorithm.hpp"
 #include "InterleavedTreeAlgorithm.hpp"
 #include "InterleavedTreeTupleAlgorithm.hpp"
+#include "StreamingTreeTupleAlgorithm.hpp"
+#include "TupleSetUnion.hpp"
 
 #include <sharp/create.hpp>
 
@@ -60,6 +64,16 @@ namespace sharp
 		return new IterativeTreeSolver(decomposer, algorithms, extractor);
 	}
 
+	ITreeSolver *create::treeSolver(
+			const ITreeDecompositionAlgorithm &decomposer,
+			const TreeAlgorithmVector &algorithms,
+			const TreeTopDownAlgorithmVector &topDownAlgorithms,
+			const ITreeSolutionExtractor &extractor)
+	{
+		return new IterativeTreeSolver(
+				decomposer, algorithms, topDownAlgorithms, extractor);
+	}
+
 	ITreeSolver *create::treeSolver(
 			const ITreeDecompositionAlgorithm &decomposer,
 			const ITreeTupleAlgorithm &algorithm)
@@ -107,6 +121,16 @@ namespace sharp
 		return new IterativeTreeTupleSolver(decomposer, algorithms, extractor);
 	}
 
+	ITreeSolver *create::treeSolver(
+			const ITreeDecompositionAlgorithm &decomposer,
+			const TreeTupleAlgorithmVector &algorithms,
+			const TreeTupleTopDownAlgorithmVector &topDownAlgorithms,
+			const ITreeTupleSolutionExtractor &extractor)
+	{
+		return new IterativeTreeTupleSolver(
+				decomposer, algorithms, topDownAlgorithms, extractor);
+	}
+
 	ITreeAlgorithm *create::treeAlgorithm(
 			const ITreeAlgorithm &algorithm1,
 			const ITreeAlgorithm &algorithm2)
@@ -114,6 +138,19 @@ namespace sharp
 		return new InterleavedTreeAlgorithm(algorithm1, algorithm2);
 	}
 
+	ITreeAlgorithm *create::treeAlgorithm(
+			const TreeAlgorithmVector &algorithms)
+	{
+		return new InterleavedTreeAlgorithm(algorithms);
+	}
+
+	ITreeAlgorithm *create::treeAlgorithm(
+			const TreeAlgorithmVector &algorithms,
+			const ITableCombiner &combiner)
+	{
+		return new ConcurrentTreeAlgorithm(algorithms, combiner);
+	}
+
 	ITreeTupleAlgorithm *create::treeTupleAlgorithm(
 			const ITreeTupleAlgorithm &algorithm1,
 			const ITreeTupleAlgorithm &algorithm2)
@@ -121,4 +158,29 @@ namespace sharp
 		return new InterleavedTreeTupleAlgorithm(algorithm1, algorithm2);
 	}
 
+	ITreeTupleAlgorithm *create::treeTupleAlgorithm(
+			const TreeTupleAlgorithmVector &algorithms)
+	{
+		return new InterleavedTreeTupleAlgorithm(algorithms);
+	}
+
+	ITreeTupleAlgorithm *create::treeTupleAlgorithm(
+			const TreeTupleAlgorithmVector &algorithms,
+			const ITupleSetCombiner &combiner)
+	{
+		return new ConcurrentTreeTupleAlgorithm(algorithms, combiner);
+	}
+
+	ITreeTupleAlgorithm *create::treeTupleAlgorithm(
+			const ITreeTupleAlgorithm &algorithm1,
+			const ITreeTupleStreamAlgorithm &algorithm2)
+	{
+		return new StreamingTreeTupleAlgorithm(algorithm1, algorithm2);
+	}
+
+	ITupleSet *create::tupleSetUnion(const std::vector<ITupleSet *> &sets)
+	{
+		return new TupleSetUnion(sets);
+	}
+
 } // namespace sharp
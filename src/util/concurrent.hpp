@@ -0,0 +1,163 @@
+#ifndef SHARP_UTIL_CONCURRENT_H_
+#define SHARP_UTIL_CONCURRENT_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstddef>
+
+namespace sharp
+{
+	// Calls f(i) for all i in [0, count), each on its own thread except
+	// for i = 0, which runs on the caller. The first exception thrown by
+	// any call is rethrown after all threads have finished.
+	template<typename F>
+	void runConcurrently(std::size_t count, F f)
+	{
+		std::vector<std::exception_ptr> errors(count);
+		auto task = [&](std::size_t i)
+		{
+			try { f(i); }
+			catch(...) { errors[i] = std::current_exception(); }
+		};
+
+		std::vector<std::thread> workers;
+		for(std::size_t i = 1; i < count; ++i)
+			workers.push_back(std::thread(task, i));
+		if(count) task(0);
+		for(std::thread &worker : workers)
+			worker.join();
+
+		for(std::exception_ptr &error : errors)
+			if(error) std::rethrow_exception(error);
+	}
+
+	// Calls f(i) for all i in [0, count) on at most threadCount threads,
+	// which fetch the next index as soon as they are done with the last
+	// one. Exceptions are handled as in runConcurrently.
+	template<typename F>
+	void forEachConcurrently(
+			std::size_t count,
+			unsigned int threadCount,
+			F f)
+	{
+		std::size_t threads = threadCount ? threadCount : 1;
+		if(threads > count) threads = count;
+
+		std::atomic<std::size_t> next(0);
+		runConcurrently(threads, [&](std::size_t)
+		{
+			for(std::size_t i = next++; i < count; i = next++)
+				f(i);
+		});
+	}
+
+	// Dependency-driven scheduling: run() keeps a fixed set of threads
+	// busy with the tasks that are ready, and a task makes the tasks that
+	// depend on it ready by scheduling them as soon as it is done. There
+	// is no barrier between unrelated tasks.
+	class TaskQueue
+	{
+	public:
+		TaskQueue() : pending_(0), failed_(false) { }
+
+		// makes task ready; may be called from within a running task
+		void schedule(std::size_t task)
+		{
+			std::lock_guard<std::mutex> guard(lock_);
+			if(failed_) return;
+			ready_.push_back(task);
+			++pending_;
+			wakeup_.notify_one();
+		}
+
+		// Calls f(task) for every scheduled task on at most threadCount
+		// threads, until no task is ready or running. After the first
+		// exception thrown by f no further tasks are started, and it is
+		// rethrown once the running ones are done.
+		template<typename F>
+		void run(std::size_t threadCount, F f)
+		{
+			runConcurrently(threadCount ? threadCount : 1, [&](std::size_t)
+			{
+				std::size_t task;
+				while(this->next(task))
+				{
+					try { f(task); }
+					catch(...)
+					{
+						this->finish(true);
+						throw;
+					}
+					this->finish(false);
+				}
+			});
+		}
+
+	private:
+		TaskQueue(const TaskQueue &) = delete;
+		TaskQueue &operator=(const TaskQueue &) = delete;
+
+		// waits for a ready task; false once all tasks are done
+		bool next(std::size_t &task)
+		{
+			std::unique_lock<std::mutex> guard(lock_);
+			wakeup_.wait(guard, [&]() { return !ready_.empty() || !pending_; });
+			if(ready_.empty()) return false;
+			task = ready_.front();
+			ready_.pop_front();
+			return true;
+		}
+
+		void finish(bool failed)
+		{
+			std::lock_guard<std::mutex> guard(lock_);
+			if(failed)
+			{
+				failed_ = true;
+				pending_ -= ready_.size();
+				ready_.clear();
+			}
+			if(--pending_ == 0)
+				wakeup_.notify_all();
+		}
+
+		std::mutex lock_;
+		std::condition_variable wakeup_;
+		std::deque<std::size_t> ready_;
+		// tasks that are ready or running
+		std::size_t pending_;
+		bool failed_;
+
+	}; // class TaskQueue
+
+	// below this many items, spawning threads does not pay off
+	const std::size_t PARALLEL_THRESHOLD = 1 << 14;
+
+	// Calls f(begin, end) on threadCount contiguous chunks of [0, count),
+	// each on its own thread. Small inputs are processed by the caller.
+	// Exceptions are handled as in runConcurrently.
+	template<typename F>
+	void parallelFor(std::size_t count, unsigned int threadCount, F f)
+	{
+		if(threadCount <= 1 || count < PARALLEL_THRESHOLD)
+		{
+			f(0, count);
+			return;
+		}
+
+		std::size_t chunk = (count + threadCount - 1) / threadCount;
+		runConcurrently((count + chunk - 1) / chunk, [&](std::size_t i)
+		{
+			f(i * chunk, std::min((i + 1) * chunk, count));
+		});
+	}
+
+} // namespace sharp
+
+#endif // SHARP_UTIL_CONCURRENT_H_
@@ -0,0 +1,69 @@
+#ifndef SHARP_UTIL_OUTPUT_H_
+#define SHARP_UTIL_OUTPUT_H_
+
+#include <ios>
+#include <string>
+
+namespace sharp
+{
+	// Restores the format flags and the precision of a stream that a
+	// report changes while printing.
+	class StreamFormatGuard
+	{
+	public:
+		explicit StreamFormatGuard(std::ios_base &stream)
+			: stream_(stream),
+			  flags_(stream.flags()),
+			  precision_(stream.precision())
+		{ }
+
+		~StreamFormatGuard()
+		{
+			stream_.flags(flags_);
+			stream_.precision(precision_);
+		}
+
+	private:
+		StreamFormatGuard(const StreamFormatGuard &) = delete;
+		StreamFormatGuard &operator=(const StreamFormatGuard &) = delete;
+
+		std::ios_base &stream_;
+		std::ios_base::fmtflags flags_;
+		std::streamsize precision_;
+
+	}; // class StreamFormatGuard
+
+	// text as the contents of a JSON string literal
+	inline std::string jsonEscape(const std::string &text)
+	{
+		static const char HEX[] = "0123456789abcdef";
+
+		std::string escaped;
+		escaped.reserve(text.size());
+		for(char c : text)
+		{
+			switch(c)
+			{
+			case '"': escaped += "\\\""; break;
+			case '\\': escaped += "\\\\"; break;
+			case '\n': escaped += "\\n"; break;
+			case '\r': escaped += "\\r"; break;
+			case '\t': escaped += "\\t"; break;
+			default:
+				if(static_cast<unsigned char>(c) < 0x20)
+				{
+					escaped += "\\u00";
+					escaped += HEX[(c >> 4) & 0xf];
+					escaped += HEX[c & 0xf];
+				}
+				else
+					escaped += c;
+				break;
+			}
+		}
+		return escaped;
+	}
+
+} // namespace sharp
+
+#endif // SHARP_UTIL_OUTPUT_H_
@@ -0,0 +1,303 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sharp/create.hpp>
+#include <sharp/ITreeSolutionEnumerator.hpp>
+
+#include "mocks/MockInstance.hpp"
+
+#include <htd/main.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+namespace
+{
+	using namespace sharp;
+	using sharp::test::MockInstance;
+
+	using std::size_t;
+
+	int liveTables = 0;
+
+	// number of solutions below the node
+	struct CountTable : public ITable
+	{
+		CountTable(size_t count) : count(count) { ++liveTables; }
+		virtual ~CountTable() override { --liveTables; }
+
+		size_t count;
+	};
+
+	struct NumberSolution : public ISolution
+	{
+		NumberSolution(size_t number) : number(number) { }
+
+		size_t number;
+	};
+
+	// leaves have two solutions, inner nodes the product of their children;
+	// a failing algorithm returns no table
+	class Counting : public ITreeAlgorithm
+	{
+	public:
+		Counting(bool fail = false) : fail_(fail) { }
+
+		virtual std::vector<const htd::ILabelingFunction *>
+			preprocessOperations() const override
+		{
+			return std::vector<const htd::ILabelingFunction *>();
+		}
+
+		virtual ITable *evaluateNode(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				INodeTableMap &tables,
+				const IInstance &) const override
+		{
+			if(fail_) return nullptr;
+
+			size_t count = 1;
+			size_t childCount = decomposition.childCount(node);
+			for(size_t i = 0; i < childCount; ++i)
+				count *= static_cast<const CountTable &>(tables[
+						decomposition.childAtPosition(node, i)]).count;
+			return new CountTable(childCount ? count : 2);
+		}
+
+		virtual bool needAllTables() const override { return false; }
+
+	private:
+		bool fail_;
+	};
+
+	class Extractor : public ITreeSolutionExtractor
+	{
+	public:
+		virtual ISolution *extractSolution(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &,
+				const INodeTableMap &tables,
+				const IInstance &) const override
+		{
+			return new NumberSolution(
+					static_cast<const CountTable &>(tables[node]).count);
+		}
+
+		virtual ISolution *emptySolution(const IInstance &) const override
+		{
+			return new NumberSolution(0);
+		}
+	};
+
+	// yields the solutions 1, ..., count of the root and counts how many
+	// it constructed
+	class Enumerator : public Extractor, public ITreeSolutionEnumerator
+	{
+	public:
+		Enumerator() : constructed(0) { }
+
+		virtual ISolutionCursor *enumerateSolutions(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &,
+				const INodeTableMap &tables,
+				const IInstance &) const override
+		{
+			return new Cursor(
+					static_cast<const CountTable &>(tables[node]),
+					constructed);
+		}
+
+		mutable size_t constructed;
+
+	private:
+		class Cursor : public ISolutionCursor
+		{
+		public:
+			Cursor(const CountTable &table, size_t &constructed)
+				: table_(table), constructed_(constructed), next_(1)
+			{ }
+
+			virtual ISolution *next() override
+			{
+				// reads the root table, which has to be alive
+				if(next_ > table_.count) return nullptr;
+				++constructed_;
+				return new NumberSolution(next_++);
+			}
+
+			virtual size_t skip(size_t count) override
+			{
+				size_t skipped = std::min(count, table_.count + 1 - next_);
+				next_ += skipped;
+				return skipped;
+			}
+
+		private:
+			const CountTable &table_;
+			size_t &constructed_;
+			size_t next_;
+		};
+	};
+
+	// a solver that only knows how to solve, with the number of the
+	// decomposition given, or 0 without one
+	class SolvingOnly : public ITreeSolver
+	{
+	public:
+		virtual htd::ITreeDecomposition *decompose(
+				const IInstance &, bool, unsigned int, bool) const override
+		{
+			return nullptr;
+		}
+
+		virtual ISolution *solve(const IInstance &) const override
+		{
+			return new NumberSolution(0);
+		}
+
+		virtual ISolution *solve(
+				const IInstance &,
+				const htd::ITreeDecomposition &decomposition) const override
+		{
+			return new NumberSolution(decomposition.vertexCount());
+		}
+	};
+
+	// root with three leaves: 8 solutions
+	std::unique_ptr<htd::ITreeDecomposition> decomposition()
+	{
+		htd::IMutableTreeDecomposition *td =
+			htd::TreeDecompositionFactory::instance().getTreeDecomposition();
+		htd::vertex_t root = td->insertRoot();
+		td->addChild(root);
+		td->addChild(root);
+		td->addChild(root);
+		return std::unique_ptr<htd::ITreeDecomposition>(td);
+	}
+
+	std::unique_ptr<ISolutionCursor> enumerate(
+			const htd::ITreeDecomposition &td,
+			const ITreeAlgorithm &algorithm,
+			const ITreeSolutionExtractor &extractor)
+	{
+		std::unique_ptr<htd::ITreeDecompositionAlgorithm> decomposer(
+				htd::TreeDecompositionAlgorithmFactory::instance()
+					.getTreeDecompositionAlgorithm());
+		std::unique_ptr<ITreeSolver> solver(
+				create::treeSolver(*decomposer, algorithm, extractor));
+
+		MockInstance instance;
+		return std::unique_ptr<ISolutionCursor>(
+				solver->enumerate(instance, td));
+	}
+
+	size_t numberOf(ISolution *solution)
+	{
+		std::unique_ptr<ISolution> owned(solution);
+		return owned ? static_cast<NumberSolution &>(*owned).number : 0;
+	}
+
+	TEST(SolutionEnumeration, YieldsSolutionsOneAtATime)
+	{
+		std::unique_ptr<htd::ITreeDecomposition> td = decomposition();
+		Counting counting;
+		Enumerator enumerator;
+		std::unique_ptr<ISolutionCursor> cursor =
+			enumerate(*td, counting, enumerator);
+		ASSERT_TRUE(cursor != nullptr);
+
+		// nothing is constructed before it is asked for
+		EXPECT_EQ(0u, enumerator.constructed);
+		EXPECT_EQ(1u, numberOf(cursor->next()));
+		EXPECT_EQ(2u, numberOf(cursor->next()));
+		EXPECT_EQ(2u, enumerator.constructed);
+	}
+
+	TEST(SolutionEnumeration, SkipsWithoutConstructing)
+	{
+		std::unique_ptr<htd::ITreeDecomposition> td = decomposition();
+		Counting counting;
+		Enumerator enumerator;
+		std::unique_ptr<ISolutionCursor> cursor =
+			enumerate(*td, counting, enumerator);
+
+		EXPECT_EQ(0u, cursor->skip(0));
+		EXPECT_EQ(3u, cursor->skip(3));
+		EXPECT_EQ(4u, numberOf(cursor->next()));
+		EXPECT_EQ(4u, cursor->skip(10));
+		EXPECT_TRUE(cursor->next() == nullptr);
+		EXPECT_EQ(0u, cursor->skip(1));
+		EXPECT_EQ(1u, enumerator.constructed);
+	}
+
+	TEST(SolutionEnumeration, ReleasesTheTablesWithTheCursor)
+	{
+		std::unique_ptr<htd::ITreeDecomposition> td = decomposition();
+		Counting counting;
+		Enumerator enumerator;
+		std::unique_ptr<ISolutionCursor> cursor =
+			enumerate(*td, counting, enumerator);
+
+		// only the root table is left after the pass
+		EXPECT_EQ(1, liveTables);
+		cursor.reset();
+		EXPECT_EQ(0, liveTables);
+	}
+
+	TEST(SolutionEnumeration, YieldsTheSingleSolutionOfOtherExtractors)
+	{
+		std::unique_ptr<htd::ITreeDecomposition> td = decomposition();
+		Counting counting;
+		Extractor extractor;
+		std::unique_ptr<ISolutionCursor> cursor =
+			enumerate(*td, counting, extractor);
+
+		EXPECT_EQ(8u, numberOf(cursor->next()));
+		EXPECT_TRUE(cursor->next() == nullptr);
+
+		cursor = enumerate(*td, counting, extractor);
+		EXPECT_EQ(0u, cursor->skip(0));
+		EXPECT_EQ(1u, cursor->skip(5));
+		EXPECT_TRUE(cursor->next() == nullptr);
+	}
+
+	TEST(SolutionEnumeration, YieldsTheEmptySolutionIfEvaluationFails)
+	{
+		std::unique_ptr<htd::ITreeDecomposition> td = decomposition();
+		Counting failing(true);
+		Enumerator enumerator;
+		std::unique_ptr<ISolutionCursor> cursor =
+			enumerate(*td, failing, enumerator);
+
+		std::unique_ptr<ISolution> solution(cursor->next());
+		ASSERT_TRUE(solution != nullptr);
+		EXPECT_EQ(0u, static_cast<NumberSolution &>(*solution).number);
+		EXPECT_TRUE(cursor->next() == nullptr);
+		EXPECT_EQ(0u, enumerator.constructed);
+	}
+
+	TEST(SolutionEnumeration, YieldsTheSolutionOfSolveByDefault)
+	{
+		std::unique_ptr<htd::ITreeDecomposition> td = decomposition();
+		SolvingOnly solver;
+		MockInstance instance;
+
+		std::unique_ptr<ISolutionCursor> cursor(
+				solver.enumerate(instance, *td));
+		EXPECT_EQ(4u, numberOf(cursor->next()));
+		EXPECT_TRUE(cursor->next() == nullptr);
+
+		cursor.reset(solver.enumerate(instance));
+		std::unique_ptr<ISolution> solution(cursor->next());
+		ASSERT_TRUE(solution != nullptr);
+		EXPECT_EQ(0u, static_cast<NumberSolution &>(*solution).number);
+		EXPECT_TRUE(cursor->next() == nullptr);
+	}
+
+} // namespace
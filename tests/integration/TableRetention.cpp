@@ -0,0 +1,232 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sharp/create.hpp>
+#include <sharp/ITableReader.hpp>
+
+#include "mocks/MockInstance.hpp"
+
+#include <htd/main.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace
+{
+	using namespace sharp;
+	using sharp::test::MockInstance;
+
+	typedef std::set<htd::vertex_t> Nodes;
+
+	struct PassTable : public ITable
+	{
+		PassTable(int pass) : pass(pass) { }
+
+		int pass;
+	};
+
+	// the tables present when the solution is extracted
+	struct TablesSolution : public ISolution
+	{
+		Nodes nodes;
+	};
+
+	Nodes present(
+			const htd::ITreeDecomposition &decomposition,
+			const INodeTableMap &tables)
+	{
+		Nodes nodes;
+		for(htd::vertex_t node = 1;
+				node <= decomposition.vertexCount(); ++node)
+			if(tables.contains(node))
+				nodes.insert(node);
+		return nodes;
+	}
+
+	// Returns a table tagged with its pass and remembers which tables the
+	// evaluation of the root could see.
+	class Pass : public ITreeAlgorithm
+	{
+	public:
+		Pass(int pass, bool needAllTables = false)
+			: pass_(pass), needAllTables_(needAllTables)
+		{ }
+
+		virtual std::vector<const htd::ILabelingFunction *>
+			preprocessOperations() const override
+		{
+			return std::vector<const htd::ILabelingFunction *>();
+		}
+
+		virtual ITable *evaluateNode(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				INodeTableMap &tables,
+				const IInstance &) const override
+		{
+			if(decomposition.isRoot(node))
+			{
+				std::lock_guard<std::mutex> guard(lock_);
+				atRoot = present(decomposition, tables);
+				for(htd::vertex_t other : atRoot)
+					passAtRoot[other] =
+						static_cast<const PassTable &>(tables[other]).pass;
+			}
+			return new PassTable(pass_);
+		}
+
+		virtual bool needAllTables() const override { return needAllTables_; }
+
+		mutable Nodes atRoot;
+		mutable std::map<htd::vertex_t, int> passAtRoot;
+
+	private:
+		int pass_;
+		bool needAllTables_;
+		mutable std::mutex lock_;
+	};
+
+	class ReadingPass : public Pass, public ITableReader
+	{
+	public:
+		ReadingPass(int pass, const Nodes &reads) : Pass(pass), reads_(reads)
+		{ }
+
+		virtual bool readsTable(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &) const override
+		{
+			return reads_.count(node) != 0;
+		}
+
+	private:
+		Nodes reads_;
+	};
+
+	class Extractor : public ITreeSolutionExtractor
+	{
+	public:
+		virtual ISolution *extractSolution(
+				htd::vertex_t,
+				const htd::ITreeDecomposition &decomposition,
+				const INodeTableMap &tables,
+				const IInstance &) const override
+		{
+			TablesSolution *solution = new TablesSolution();
+			solution->nodes = present(decomposition, tables);
+			return solution;
+		}
+
+		virtual ISolution *emptySolution(const IInstance &) const override
+		{
+			return nullptr;
+		}
+	};
+
+	class ReadingExtractor : public Extractor, public ITableReader
+	{
+	public:
+		ReadingExtractor(const Nodes &reads) : reads_(reads) { }
+
+		virtual bool readsTable(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &) const override
+		{
+			return reads_.count(node) != 0;
+		}
+
+	private:
+		Nodes reads_;
+	};
+
+	// root 1 with children 2 and 3; 2 has children 4 and 5, 5 has child 6
+	std::unique_ptr<htd::ITreeDecomposition> decomposition()
+	{
+		htd::IMutableTreeDecomposition *td =
+			htd::TreeDecompositionFactory::instance().getTreeDecomposition();
+		htd::vertex_t root = td->insertRoot();
+		htd::vertex_t a = td->addChild(root);
+		td->addChild(root);
+		td->addChild(a);
+		td->addChild(td->addChild(a));
+		return std::unique_ptr<htd::ITreeDecomposition>(td);
+	}
+
+	class TableRetention : public ::testing::TestWithParam<unsigned int>
+	{
+	protected:
+		Nodes solve(
+				const TreeAlgorithmVector &passes,
+				const ITreeSolutionExtractor &extractor)
+		{
+			std::unique_ptr<htd::ITreeDecomposition> td = decomposition();
+			std::unique_ptr<htd::ITreeDecompositionAlgorithm> decomposer(
+					htd::TreeDecompositionAlgorithmFactory::instance()
+						.getTreeDecompositionAlgorithm());
+			std::unique_ptr<ITreeSolver> solver(
+					create::treeSolver(*decomposer, passes, extractor));
+			solver->setThreadCount(GetParam());
+
+			MockInstance instance;
+			std::unique_ptr<TablesSolution> solution(
+					dynamic_cast<TablesSolution *>(
+						solver->solve(instance, *td)));
+			EXPECT_TRUE(solution != nullptr);
+			return solution ? solution->nodes : Nodes();
+		}
+	};
+
+	TEST_P(TableRetention, KeepsOnlyTheRootWithoutReaders)
+	{
+		Pass pass(1);
+		Extractor extractor;
+		EXPECT_EQ(Nodes({ 1 }), solve({ &pass }, extractor));
+		// the children of the root are still there while it is evaluated
+		EXPECT_EQ(Nodes({ 2, 3 }), pass.atRoot);
+	}
+
+	TEST_P(TableRetention, KeepsAllTablesIfAllTablesAreNeeded)
+	{
+		Pass pass(1, true);
+		Extractor extractor;
+		EXPECT_EQ(Nodes({ 1, 2, 3, 4, 5, 6 }), solve({ &pass }, extractor));
+	}
+
+	TEST_P(TableRetention, KeepsTheTablesThePassReads)
+	{
+		// the reader decides, not needAllTables()
+		ReadingPass pass(1, { 4, 6 });
+		Extractor extractor;
+		EXPECT_EQ(Nodes({ 1, 4, 6 }), solve({ &pass }, extractor));
+		EXPECT_EQ(Nodes({ 2, 3, 4, 6 }), pass.atRoot);
+	}
+
+	TEST_P(TableRetention, KeepsTheTablesTheExtractorReads)
+	{
+		Pass pass(1);
+		ReadingExtractor extractor({ 3, 5 });
+		EXPECT_EQ(Nodes({ 1, 3, 5 }), solve({ &pass }, extractor));
+	}
+
+	TEST_P(TableRetention, KeepsTheTablesOfEarlierPassesALaterPassReads)
+	{
+		Pass first(1);
+		ReadingPass second(2, { 6 });
+		Extractor extractor;
+		EXPECT_EQ(Nodes({ 1, 6 }), solve({ &first, &second }, extractor));
+
+		// the second pass still sees the table of the first one, and that
+		// of the root, which is never erased
+		EXPECT_EQ(Nodes({ 1, 2, 3, 6 }), second.atRoot);
+		EXPECT_EQ(1, second.passAtRoot[6]);
+	}
+
+	INSTANTIATE_TEST_CASE_P(Threads, TableRetention, ::testing::Values(1u, 4u));
+
+} // namespace
@@ -0,0 +1,367 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sharp/create.hpp>
+#include <sharp/ITableReader.hpp>
+#include <sharp/ITreeTopDownSolutionExtractor.hpp>
+
+#include "mocks/MockInstance.hpp"
+
+#include <htd/main.hpp>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace
+{
+	using namespace sharp;
+	using sharp::test::MockInstance;
+
+	struct DepthTable : public ITable
+	{
+		DepthTable(int depth) : depth(depth) { }
+
+		int depth;
+	};
+
+	struct DepthSolution : public ISolution
+	{
+		std::map<htd::vertex_t, int> depths;
+	};
+
+	class BottomUp : public ITreeAlgorithm
+	{
+	public:
+		virtual std::vector<const htd::ILabelingFunction *>
+			preprocessOperations() const override
+		{
+			return std::vector<const htd::ILabelingFunction *>();
+		}
+
+		virtual ITable *evaluateNode(
+				htd::vertex_t,
+				const htd::ITreeDecomposition &,
+				INodeTableMap &,
+				const IInstance &) const override
+		{
+			return new DepthTable(0);
+		}
+
+		virtual bool needAllTables() const override { return true; }
+	};
+
+	// Stores the depth of every node, computed from the table of its
+	// parent, and remembers which top-down tables were visible.
+	class TopDown : public ITreeTopDownAlgorithm
+	{
+	public:
+		TopDown(bool allTables) : allTables_(allTables) { }
+
+		virtual ITable *evaluateNode(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				const INodeTableMap &,
+				const INodeTableMap &topDownTables,
+				const IInstance &) const override
+		{
+			std::vector<htd::vertex_t> visible;
+			for(htd::vertex_t other = 1;
+					other <= decomposition.vertexCount(); ++other)
+				if(topDownTables.contains(other))
+					visible.push_back(other);
+
+			int depth = 0;
+			if(!decomposition.isRoot(node))
+				depth = dynamic_cast<const DepthTable &>(
+						topDownTables[decomposition.parent(node)]).depth + 1;
+
+			std::lock_guard<std::mutex> guard(lock_);
+			order.push_back(node);
+			visibleTables[node] = visible;
+			return new DepthTable(depth);
+		}
+
+		virtual bool needAllTables() const override { return allTables_; }
+
+		mutable std::vector<htd::vertex_t> order;
+		mutable std::map<htd::vertex_t, std::vector<htd::vertex_t> >
+			visibleTables;
+
+	private:
+		bool allTables_;
+		mutable std::mutex lock_;
+	};
+
+	class Extractor
+		: public ITreeSolutionExtractor,
+		  public ITreeTopDownSolutionExtractor
+	{
+	public:
+		virtual ISolution *extractSolution(
+				htd::vertex_t,
+				const htd::ITreeDecomposition &,
+				const INodeTableMap &,
+				const IInstance &) const override
+		{
+			return new DepthSolution();
+		}
+
+		virtual ISolution *extractSolution(
+				htd::vertex_t,
+				const htd::ITreeDecomposition &decomposition,
+				const INodeTableMap &,
+				const INodeTableMap &topDownTables,
+				const IInstance &) const override
+		{
+			DepthSolution *solution = new DepthSolution();
+			for(htd::vertex_t node = 1;
+					node <= decomposition.vertexCount(); ++node)
+				if(topDownTables.contains(node))
+					solution->depths[node] = dynamic_cast<const DepthTable &>(
+							topDownTables[node]).depth;
+			return solution;
+		}
+
+		virtual ISolution *emptySolution(const IInstance &) const override
+		{
+			return nullptr;
+		}
+	};
+
+	// declares the tables of the given nodes as read
+	class Reader : public ITableReader
+	{
+	public:
+		Reader(const std::set<htd::vertex_t> &reads) : reads_(reads) { }
+
+		virtual bool readsTable(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &) const override
+		{
+			return reads_.count(node) != 0;
+		}
+
+	private:
+		std::set<htd::vertex_t> reads_;
+	};
+
+	class ReadingTopDown : public TopDown, public Reader
+	{
+	public:
+		ReadingTopDown(const std::set<htd::vertex_t> &reads)
+			: TopDown(false), Reader(reads)
+		{ }
+	};
+
+	class ReadingExtractor : public Extractor, public Reader
+	{
+	public:
+		ReadingExtractor(const std::set<htd::vertex_t> &reads)
+			: Reader(reads)
+		{ }
+	};
+
+	// root 1 with children 2, 3, 4; 2 and 4 have two children each, one
+	// of which has another child
+	std::unique_ptr<htd::ITreeDecomposition> decomposition()
+	{
+		htd::IMutableTreeDecomposition *td =
+			htd::TreeDecompositionFactory::instance().getTreeDecomposition();
+		htd::vertex_t root = td->insertRoot();
+		htd::vertex_t a = td->addChild(root);
+		td->addChild(root);
+		htd::vertex_t b = td->addChild(root);
+		td->addChild(td->addChild(a));
+		td->addChild(a);
+		td->addChild(b);
+		td->addChild(td->addChild(b));
+		return std::unique_ptr<htd::ITreeDecomposition>(td);
+	}
+
+	std::unique_ptr<DepthSolution> solve(
+			const htd::ITreeDecomposition &td,
+			const TopDown &topDown,
+			unsigned int threadCount,
+			const Extractor &extractor = Extractor())
+	{
+		std::unique_ptr<htd::ITreeDecompositionAlgorithm> decomposer(
+				htd::TreeDecompositionAlgorithmFactory::instance()
+					.getTreeDecompositionAlgorithm());
+		BottomUp bottomUp;
+		std::unique_ptr<ITreeSolver> solver(create::treeSolver(
+					*decomposer,
+					TreeAlgorithmVector(1, &bottomUp),
+					TreeTopDownAlgorithmVector(1, &topDown),
+					extractor));
+		solver->setThreadCount(threadCount);
+
+		MockInstance instance;
+		return std::unique_ptr<DepthSolution>(dynamic_cast<DepthSolution *>(
+					solver->solve(instance, td)));
+	}
+
+	int depth(const htd::ITreeDecomposition &td, htd::vertex_t node)
+	{
+		return td.isRoot(node) ? 0 : depth(td, td.parent(node)) + 1;
+	}
+
+	class TopDownPass : public ::testing::TestWithParam<unsigned int> { };
+
+	TEST_P(TopDownPass, EvaluatesEveryNodeAfterItsParent)
+	{
+		std::unique_ptr<htd::ITreeDecomposition> td = decomposition();
+		TopDown topDown(false);
+		std::unique_ptr<DepthSolution> solution =
+			solve(*td, topDown, GetParam());
+		ASSERT_TRUE(solution != nullptr);
+
+		ASSERT_EQ(td->vertexCount(), topDown.order.size());
+		std::map<htd::vertex_t, std::size_t> position;
+		for(std::size_t i = 0; i < topDown.order.size(); ++i)
+			position[topDown.order[i]] = i;
+		ASSERT_EQ(td->vertexCount(), position.size());
+		for(htd::vertex_t node = 1; node <= td->vertexCount(); ++node)
+			if(!td->isRoot(node))
+			{
+				EXPECT_LT(position[td->parent(node)], position[node]);
+			}
+	}
+
+	TEST_P(TopDownPass, ShowsOnlyTheParentTable)
+	{
+		std::unique_ptr<htd::ITreeDecomposition> td = decomposition();
+		TopDown topDown(false);
+		std::unique_ptr<DepthSolution> solution =
+			solve(*td, topDown, GetParam());
+		ASSERT_TRUE(solution != nullptr);
+
+		for(htd::vertex_t node = 1; node <= td->vertexCount(); ++node)
+		{
+			std::vector<htd::vertex_t> expected;
+			if(!td->isRoot(node))
+				expected.push_back(td->parent(node));
+			EXPECT_EQ(expected, topDown.visibleTables[node]);
+		}
+
+		// the tables of inner nodes are dropped, those of leaves kept
+		for(htd::vertex_t node = 1; node <= td->vertexCount(); ++node)
+		{
+			if(td->childCount(node) == 0)
+			{
+				EXPECT_EQ(depth(*td, node), solution->depths[node]);
+			}
+			else
+			{
+				EXPECT_EQ(0u, solution->depths.count(node));
+			}
+		}
+	}
+
+	TEST_P(TopDownPass, ShowsEveryAncestorTableIfAllTablesAreNeeded)
+	{
+		std::unique_ptr<htd::ITreeDecomposition> td = decomposition();
+		TopDown topDown(true);
+		std::unique_ptr<DepthSolution> solution =
+			solve(*td, topDown, GetParam());
+		ASSERT_TRUE(solution != nullptr);
+
+		for(htd::vertex_t node = 1; node <= td->vertexCount(); ++node)
+		{
+			std::vector<htd::vertex_t> expected;
+			for(htd::vertex_t ancestor = node; !td->isRoot(ancestor); )
+			{
+				ancestor = td->parent(ancestor);
+				expected.insert(expected.begin(), ancestor);
+			}
+			std::vector<htd::vertex_t> visible = topDown.visibleTables[node];
+			std::sort(expected.begin(), expected.end());
+			EXPECT_EQ(expected, visible);
+		}
+
+		ASSERT_EQ(td->vertexCount(), solution->depths.size());
+		for(htd::vertex_t node = 1; node <= td->vertexCount(); ++node)
+			EXPECT_EQ(depth(*td, node), solution->depths[node]);
+	}
+
+	TEST_P(TopDownPass, KeepsTheTablesThePassReads)
+	{
+		std::unique_ptr<htd::ITreeDecomposition> td = decomposition();
+		// the root and node 5, which has a child
+		ReadingTopDown topDown({ 1, 5 });
+		std::unique_ptr<DepthSolution> solution =
+			solve(*td, topDown, GetParam());
+		ASSERT_TRUE(solution != nullptr);
+
+		for(htd::vertex_t node = 1; node <= td->vertexCount(); ++node)
+		{
+			std::vector<htd::vertex_t> expected;
+			if(!td->isRoot(node))
+			{
+				expected.push_back(td->parent(node));
+				if(!td->isRoot(td->parent(node)))
+					expected.push_back(1);
+			}
+			std::sort(expected.begin(), expected.end());
+			EXPECT_EQ(expected, topDown.visibleTables[node]);
+		}
+
+		for(htd::vertex_t node = 1; node <= td->vertexCount(); ++node)
+		{
+			if(td->childCount(node) == 0 || node == 1 || node == 5)
+			{
+				EXPECT_EQ(depth(*td, node), solution->depths[node]);
+			}
+			else
+			{
+				EXPECT_EQ(0u, solution->depths.count(node));
+			}
+		}
+	}
+
+	TEST_P(TopDownPass, KeepsTheTablesTheExtractorReads)
+	{
+		std::unique_ptr<htd::ITreeDecomposition> td = decomposition();
+		TopDown topDown(false);
+		ReadingExtractor extractor({ 2, 4 });
+		std::unique_ptr<DepthSolution> solution =
+			solve(*td, topDown, GetParam(), extractor);
+		ASSERT_TRUE(solution != nullptr);
+
+		// the pass sees its parent and the retained ancestors
+		for(htd::vertex_t node = 1; node <= td->vertexCount(); ++node)
+		{
+			std::vector<htd::vertex_t> expected;
+			for(htd::vertex_t ancestor = node; !td->isRoot(ancestor); )
+			{
+				ancestor = td->parent(ancestor);
+				if(ancestor == td->parent(node) || ancestor == 2
+						|| ancestor == 4)
+					expected.push_back(ancestor);
+			}
+			std::sort(expected.begin(), expected.end());
+			EXPECT_EQ(expected, topDown.visibleTables[node]);
+		}
+
+		for(htd::vertex_t node = 1; node <= td->vertexCount(); ++node)
+		{
+			if(td->childCount(node) == 0 || node == 2 || node == 4)
+			{
+				EXPECT_EQ(depth(*td, node), solution->depths[node]);
+			}
+			else
+			{
+				EXPECT_EQ(0u, solution->depths.count(node));
+			}
+		}
+	}
+
+	INSTANTIATE_TEST_CASE_P(Threads, TopDownPass, ::testing::Values(1u, 4u));
+
+} // namespace
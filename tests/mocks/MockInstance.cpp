@@ -0,0 +1,16 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include "MockInstance.hpp"
+
+namespace sharp { namespace test {
+
+	MockInstance::~MockInstance() { }
+
+	htd::IHypergraph *MockInstance::toHypergraph() const
+	{
+		return nullptr;
+	}
+
+}} // namespace sharp::test
@@ -0,0 +1,20 @@
+#ifndef SHARP_TEST_MOCK_MOCKINSTANCE_H_
+#define SHARP_TEST_MOCK_MOCKINSTANCE_H_
+
+#include <sharp/IInstance.hpp>
+
+namespace sharp { namespace test {
+
+	// instance without a hypergraph, for solvers that never decompose it
+	class MockInstance : public IInstance
+	{
+	public:
+		virtual ~MockInstance() override;
+
+		virtual htd::IHypergraph *toHypergraph() const override;
+
+	}; // class MockInstance
+
+}} // namespace sharp::test
+
+#endif // SHARP_TEST_MOCK_MOCKINSTANCE_H_
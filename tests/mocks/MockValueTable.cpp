@@ -0,0 +1,21 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include "MockValueTable.hpp"
+
+namespace sharp { namespace test {
+
+	std::atomic<int> MockValueTable::liveTables(0);
+
+	MockValueTable::MockValueTable(int value) : value(value)
+	{
+		++liveTables;
+	}
+
+	MockValueTable::~MockValueTable()
+	{
+		--liveTables;
+	}
+
+}} // namespace sharp::test
@@ -0,0 +1,25 @@
+#ifndef SHARP_TEST_MOCK_MOCKVALUETABLE_H_
+#define SHARP_TEST_MOCK_MOCKVALUETABLE_H_
+
+#include <sharp/ITable.hpp>
+
+#include <atomic>
+
+namespace sharp { namespace test {
+
+	// table holding a single value
+	struct MockValueTable : public ITable
+	{
+		MockValueTable(int value);
+		virtual ~MockValueTable() override;
+
+		int value;
+
+		// number of tables constructed but not deleted yet
+		static std::atomic<int> liveTables;
+
+	}; // struct MockValueTable
+
+}} // namespace sharp::test
+
+#endif // SHARP_TEST_MOCK_MOCKVALUETABLE_H_
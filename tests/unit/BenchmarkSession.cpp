@@ -0,0 +1,299 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sharp/BenchmarkSession.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+	using sharp::BenchmarkSession;
+	using sharp::NodeProfiler;
+	using sharp::PerfCounters;
+
+	using std::size_t;
+	using std::int64_t;
+	using std::string;
+	using std::vector;
+
+	typedef BenchmarkSession::Event Event;
+	typedef BenchmarkSession::ScopedTimer ScopedTimer;
+
+	vector<string> lines(const string &text)
+	{
+		vector<string> lines;
+		std::istringstream in(text);
+		for(string line; std::getline(in, line); )
+			lines.push_back(line);
+		return lines;
+	}
+
+	bool startsWith(const string &text, const string &prefix)
+	{
+		return text.compare(0, prefix.size(), prefix) == 0;
+	}
+
+	bool endsWith(const string &text, const string &suffix)
+	{
+		return text.size() >= suffix.size()
+			&& text.compare(text.size() - suffix.size(), suffix.size(),
+					suffix) == 0;
+	}
+
+	// timestamps start and end around outer, which runs inner twice, on
+	// the calling thread; another thread runs outer on node 7
+	void record(BenchmarkSession &session)
+	{
+		session.registerTimestamp("start");
+		{
+			ScopedTimer outer(session, "outer");
+			for(int i = 0; i < 2; ++i)
+				ScopedTimer inner(&session, "join", "inner", i);
+		}
+		std::thread([&session]
+		{
+			ScopedTimer outer(&session, "evaluation", "outer", 7);
+		}).join();
+		session.registerTimestamp("end");
+	}
+
+	NodeProfiler::Entry leaf()
+	{
+		NodeProfiler::Entry entry;
+		entry.pass = "pass";
+		entry.node = 1;
+		entry.type = NodeProfiler::LEAF;
+		entry.bagSize = 1;
+		entry.childCount = 0;
+		entry.inputTuples = 0;
+		entry.outputTuples = 1;
+		entry.seconds = 1;
+		entry.allocatedBytes = -1;
+		return entry;
+	}
+
+	TEST(BenchmarkSession, RecordsEventsPerThread)
+	{
+		BenchmarkSession session;
+		record(session);
+
+		vector<BenchmarkSession::ThreadEvents> threads = session.events();
+		ASSERT_EQ(2u, threads.size());
+		EXPECT_EQ(0u, threads[0].thread);
+		EXPECT_EQ(1u, threads[1].thread);
+
+		const vector<Event> &events = threads[0].events;
+		ASSERT_EQ(5u, events.size());
+		EXPECT_EQ(BenchmarkSession::TIMESTAMP, events[0].type);
+		EXPECT_EQ("start", events[0].name);
+		EXPECT_EQ(string("timestamp"), events[0].category);
+		EXPECT_EQ(events[0].begin, events[0].end);
+		EXPECT_EQ(BenchmarkSession::TIMER, events[1].type);
+		EXPECT_EQ("outer", events[1].name);
+		EXPECT_EQ(string("timer"), events[1].category);
+		EXPECT_EQ(BenchmarkSession::NO_NODE, events[1].node);
+		EXPECT_EQ(0u, events[1].depth);
+		for(size_t i = 2; i < 4; ++i)
+		{
+			EXPECT_EQ("inner", events[i].name);
+			EXPECT_EQ(string("join"), events[i].category);
+			EXPECT_EQ(int64_t(i - 2), events[i].node);
+			EXPECT_EQ(1u, events[i].depth);
+			// nested in outer
+			EXPECT_LE(events[1].begin, events[i].begin);
+			EXPECT_LE(events[i].begin, events[i].end);
+			EXPECT_LE(events[i].end, events[1].end);
+		}
+		EXPECT_EQ("end", events[4].name);
+		EXPECT_EQ(0u, events[4].depth);
+		EXPECT_LE(events[1].end, events[4].begin);
+
+		ASSERT_EQ(1u, threads[1].events.size());
+		EXPECT_EQ(7, threads[1].events[0].node);
+		EXPECT_EQ(0u, threads[1].events[0].depth);
+	}
+
+	TEST(BenchmarkSession, TimesInNanoseconds)
+	{
+		BenchmarkSession session;
+		{
+			ScopedTimer timer(session, "sleep");
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		}
+		vector<BenchmarkSession::ThreadEvents> threads = session.events();
+		ASSERT_EQ(1u, threads.size());
+		const Event &event = threads[0].events[0];
+		EXPECT_GE(event.end - event.begin, 2000000);
+		EXPECT_LE(event.end, session.now());
+		// sleeping takes no CPU time worth mentioning
+		EXPECT_LT(event.threadCpu, event.end - event.begin);
+	}
+
+	TEST(BenchmarkSession, RecordsNothingWithoutASession)
+	{
+		BenchmarkSession session;
+		{
+			ScopedTimer timer(nullptr, "evaluation", "pass", 1);
+		}
+		EXPECT_TRUE(session.events().empty());
+		std::ostringstream out;
+		session.print(out, false);
+		EXPECT_EQ("", out.str());
+	}
+
+	TEST(BenchmarkSession, PrintsTimestampsAndTimers)
+	{
+		BenchmarkSession session;
+		record(session);
+
+		std::ostringstream out;
+		session.print(out, false);
+		vector<string> printed = lines(out.str());
+		ASSERT_EQ(4u, printed.size());
+		EXPECT_EQ("0.00s (usr),\t0.00s (sys),\t0.00s (wall) - start",
+				printed[0]);
+		EXPECT_TRUE(printed[1].find("s (usr),\t") != string::npos);
+		EXPECT_TRUE(printed[1].find("s (sys),\t") != string::npos);
+		EXPECT_TRUE(endsWith(printed[1], "s (wall) - end"));
+		// timers by their path, over all threads
+		EXPECT_TRUE(startsWith(printed[2], "2 calls,\t"));
+		EXPECT_TRUE(endsWith(printed[2], "s (thread cpu) - outer"));
+		EXPECT_TRUE(startsWith(printed[3], "2 calls,\t"));
+		EXPECT_TRUE(endsWith(printed[3], "s (thread cpu) - outer/inner"));
+	}
+
+	TEST(BenchmarkSession, PrintsTimestampsAndTimersAsCsv)
+	{
+		BenchmarkSession session;
+		record(session);
+
+		std::ostringstream out;
+		session.print(out, true);
+		vector<string> printed = lines(out.str());
+		ASSERT_EQ(6u, printed.size());
+		EXPECT_EQ("usr,sys,cpu,wall,description", printed[0]);
+		EXPECT_EQ("0.00,0.00,0.00,0.00,start", printed[1]);
+		EXPECT_TRUE(endsWith(printed[2], ",end"));
+		EXPECT_EQ(4u, size_t(std::count(
+						printed[2].begin(), printed[2].end(), ',')));
+		EXPECT_EQ("calls,wall,cpu,timer", printed[3]);
+		EXPECT_TRUE(startsWith(printed[4], "2,"));
+		EXPECT_TRUE(endsWith(printed[4], ",outer"));
+		EXPECT_TRUE(startsWith(printed[5], "2,"));
+		EXPECT_TRUE(endsWith(printed[5], ",outer/inner"));
+	}
+
+	TEST(BenchmarkSession, AppendsTheReportsOfItsStatistics)
+	{
+		BenchmarkSession session;
+		session.registerTimestamp("start");
+
+		session.nodeProfiler().record(leaf());
+
+		PerfCounters::Values values;
+		for(long long &count : values.counts)
+			count = 10;
+		session.perfCounters().record("pass", "leaf", values);
+
+		std::ostringstream out;
+		session.print(out, false);
+		vector<string> printed = lines(out.str());
+		ASSERT_EQ(6u, printed.size());
+		EXPECT_TRUE(endsWith(printed[0], "- start"));
+		EXPECT_EQ("node profile:", printed[1]);
+		EXPECT_TRUE(startsWith(printed[2], "type leaf: 1 nodes"));
+		EXPECT_TRUE(startsWith(printed[3], "bagsize 1: 1 nodes"));
+		EXPECT_TRUE(startsWith(printed[4], "perf counters"));
+		EXPECT_TRUE(startsWith(printed[5], "pass leaf: 1 samples"));
+	}
+
+	TEST(BenchmarkSession, RestoresTheStreamFormat)
+	{
+		BenchmarkSession session;
+		record(session);
+
+		std::ostringstream out;
+		out.precision(3);
+		session.print(out, false);
+		out.str("");
+		out << 0.125 << " " << 1.0;
+		EXPECT_EQ("0.125 1", out.str());
+	}
+
+	TEST(BenchmarkSession, ClearsEventsButKeepsSettings)
+	{
+		BenchmarkSession session;
+		session.setNodeTiming(true);
+		session.nodeProfiler().enable(true);
+		record(session);
+		session.nodeProfiler().record(leaf());
+
+		session.clear();
+		EXPECT_TRUE(session.events().empty());
+		EXPECT_TRUE(session.nodeProfiler().entries().empty());
+		EXPECT_TRUE(session.nodeTiming());
+		EXPECT_TRUE(session.nodeProfiler().enabled());
+
+		// threads that recorded before start over with a new buffer
+		session.registerTimestamp("again");
+		vector<BenchmarkSession::ThreadEvents> threads = session.events();
+		ASSERT_EQ(1u, threads.size());
+		EXPECT_EQ(0u, threads[0].thread);
+		ASSERT_EQ(1u, threads[0].events.size());
+		EXPECT_EQ("again", threads[0].events[0].name);
+	}
+
+	TEST(BenchmarkSession, KeepsSeparateSessionsApart)
+	{
+		BenchmarkSession first, second;
+		first.registerTimestamp("first");
+		second.registerTimestamp("second");
+		first.registerTimestamp("first again");
+
+		vector<BenchmarkSession::ThreadEvents> threads = first.events();
+		ASSERT_EQ(1u, threads.size());
+		ASSERT_EQ(2u, threads[0].events.size());
+		EXPECT_EQ("first again", threads[0].events[1].name);
+		threads = second.events();
+		ASSERT_EQ(1u, threads.size());
+		ASSERT_EQ(1u, threads[0].events.size());
+	}
+
+	TEST(BenchmarkSession, ActivatesSessionsPerThread)
+	{
+		EXPECT_TRUE(BenchmarkSession::current() == nullptr);
+
+		BenchmarkSession outer, inner;
+		inner.setNodeTiming(true);
+		{
+			BenchmarkSession::Activation activateOuter(outer);
+			EXPECT_EQ(&outer, BenchmarkSession::current());
+			EXPECT_TRUE(BenchmarkSession::currentDetailed() == nullptr);
+			{
+				BenchmarkSession::Activation activateInner(inner);
+				EXPECT_EQ(&inner, BenchmarkSession::current());
+				EXPECT_EQ(&inner, BenchmarkSession::currentDetailed());
+
+				BenchmarkSession *other = &inner;
+				std::thread([&other]
+				{
+					other = BenchmarkSession::current();
+				}).join();
+				EXPECT_TRUE(other == nullptr);
+			}
+			EXPECT_EQ(&outer, BenchmarkSession::current());
+		}
+		EXPECT_TRUE(BenchmarkSession::current() == nullptr);
+	}
+
+} // namespace
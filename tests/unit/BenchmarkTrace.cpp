@@ -0,0 +1,181 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sharp/BenchmarkSession.hpp>
+
+#include "util/output.hpp"
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+namespace
+{
+	using sharp::BenchmarkSession;
+	using sharp::jsonEscape;
+
+	using std::int64_t;
+	using std::string;
+	using std::vector;
+
+	typedef BenchmarkSession::Event Event;
+	typedef BenchmarkSession::ScopedTimer ScopedTimer;
+
+	vector<string> lines(const string &text)
+	{
+		vector<string> lines;
+		std::istringstream in(text);
+		for(string line; std::getline(in, line); )
+			lines.push_back(line);
+		return lines;
+	}
+
+	// nanoseconds as trace event microseconds
+	string microseconds(int64_t nanoseconds)
+	{
+		std::ostringstream out;
+		out.setf(std::ios::fixed, std::ios::floatfield);
+		out.precision(3);
+		out << nanoseconds / 1e3;
+		return out.str();
+	}
+
+	string metadata(const string &name, unsigned int thread,
+			const string &value)
+	{
+		std::ostringstream out;
+		out << " {\"name\": \"" << name << "\", \"ph\": \"M\", \"pid\": 1, "
+			<< "\"tid\": " << thread << ", \"args\": {\"name\": \""
+			<< value << "\"}}";
+		return out.str();
+	}
+
+	string timestamp(const string &name, unsigned int thread,
+			const Event &event)
+	{
+		return " {\"name\": \"" + name + "\", \"cat\": \"timestamp\", "
+			"\"ph\": \"i\", \"ts\": " + microseconds(event.begin)
+			+ ", \"s\": \"p\", \"pid\": 1, \"tid\": " + std::to_string(thread)
+			+ ", \"args\": {\"threadCpu\": " + microseconds(event.threadCpu)
+			+ "}}";
+	}
+
+	string timer(const string &name, const string &category,
+			unsigned int thread, const string &node, const Event &event)
+	{
+		return " {\"name\": \"" + name + "\", \"cat\": \"" + category
+			+ "\", \"ph\": \"X\", \"ts\": " + microseconds(event.begin)
+			+ ", \"dur\": " + microseconds(event.end - event.begin)
+			+ ", \"pid\": 1, \"tid\": " + std::to_string(thread)
+			+ ", \"args\": {" + node + "\"threadCpu\": "
+			+ microseconds(event.threadCpu) + "}}";
+	}
+
+	TEST(BenchmarkTrace, WritesOneTrackPerThread)
+	{
+		BenchmarkSession session;
+		session.registerTimestamp("start");
+		{
+			ScopedTimer outer(session, "outer");
+			ScopedTimer inner(&session, "join", "inner", 3);
+		}
+		std::thread([&session]
+		{
+			ScopedTimer evaluation(&session, "evaluation", "pass", 7);
+		}).join();
+
+		vector<BenchmarkSession::ThreadEvents> threads = session.events();
+		ASSERT_EQ(2u, threads.size());
+		ASSERT_EQ(3u, threads[0].events.size());
+		ASSERT_EQ(1u, threads[1].events.size());
+
+		std::ostringstream out;
+		session.printTrace(out);
+		vector<string> printed = lines(out.str());
+		ASSERT_EQ(9u, printed.size());
+		EXPECT_EQ("{\"displayTimeUnit\": \"ns\", \"traceEvents\": [",
+				printed[0]);
+		EXPECT_EQ(metadata("process_name", 0, "sharp") + ",", printed[1]);
+		EXPECT_EQ(metadata("thread_name", 0, "thread 0") + ",", printed[2]);
+		EXPECT_EQ(timestamp("start", 0, threads[0].events[0]) + ",",
+				printed[3]);
+		EXPECT_EQ(timer("outer", "timer", 0, "", threads[0].events[1]) + ",",
+				printed[4]);
+		EXPECT_EQ(timer("inner", "join", 0, "\"node\": 3, ",
+					threads[0].events[2]) + ",",
+				printed[5]);
+		EXPECT_EQ(metadata("thread_name", 1, "thread 1") + ",", printed[6]);
+		EXPECT_EQ(timer("pass", "evaluation", 1, "\"node\": 7, ",
+					threads[1].events[0]),
+				printed[7]);
+		EXPECT_EQ("]}", printed[8]);
+	}
+
+	TEST(BenchmarkTrace, WritesAnEmptySession)
+	{
+		BenchmarkSession session;
+		std::ostringstream out;
+		session.printTrace(out);
+		EXPECT_EQ("{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n"
+				+ metadata("process_name", 0, "sharp") + "\n]}\n",
+				out.str());
+	}
+
+	TEST(BenchmarkTrace, LeavesOutRunningTimers)
+	{
+		BenchmarkSession session;
+		ScopedTimer running(session, "running");
+		session.registerTimestamp("inside");
+
+		std::ostringstream out;
+		session.printTrace(out);
+		vector<string> printed = lines(out.str());
+		ASSERT_EQ(5u, printed.size());
+		EXPECT_EQ(metadata("thread_name", 0, "thread 0") + ",", printed[2]);
+		EXPECT_EQ(timestamp("inside", 0, session.events()[0].events[1]),
+				printed[3]);
+	}
+
+	TEST(BenchmarkTrace, EscapesEventNames)
+	{
+		BenchmarkSession session;
+		session.registerTimestamp("a \"quoted\"\\path\n");
+
+		std::ostringstream out;
+		session.printTrace(out);
+		vector<string> printed = lines(out.str());
+		ASSERT_EQ(5u, printed.size());
+		EXPECT_EQ(timestamp("a \\\"quoted\\\"\\\\path\\n", 0,
+					session.events()[0].events[0]),
+				printed[3]);
+	}
+
+	TEST(BenchmarkTrace, EscapesControlCharacters)
+	{
+		EXPECT_EQ("plain", jsonEscape("plain"));
+		EXPECT_EQ("\\\"\\\\\\n\\r\\t", jsonEscape("\"\\\n\r\t"));
+		EXPECT_EQ("\\u0000\\u0001\\u001f ~",
+				jsonEscape(string("\0\x01\x1f ~", 5)));
+		// bytes of UTF-8 sequences are kept
+		EXPECT_EQ("\xc3\xa4", jsonEscape("\xc3\xa4"));
+	}
+
+	TEST(BenchmarkTrace, RestoresTheStreamFormat)
+	{
+		BenchmarkSession session;
+		session.registerTimestamp("start");
+
+		std::ostringstream out;
+		out.precision(2);
+		session.printTrace(out);
+		out.str("");
+		out << 1.5 << " " << 1.0 / 3;
+		EXPECT_EQ("1.5 0.33", out.str());
+	}
+
+} // namespace
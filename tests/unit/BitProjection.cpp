@@ -0,0 +1,202 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sharp/BitProjection.hpp>
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+	using sharp::BitProjection;
+
+	using std::size_t;
+	using std::uint64_t;
+	using std::vector;
+
+	bool bit(const uint64_t *row, size_t position)
+	{
+		return (row[position / 64] >> (position % 64)) & 1u;
+	}
+
+	vector<uint64_t> randomRows(size_t rowCount, size_t words, unsigned seed)
+	{
+		std::mt19937_64 random(seed);
+		vector<uint64_t> rows(rowCount * words);
+		for(uint64_t &word : rows)
+			word = random();
+		return rows;
+	}
+
+	// bit by bit reference of project()
+	vector<uint64_t> referenceProject(
+			const vector<size_t> &positions,
+			const BitProjection &projection,
+			const vector<uint64_t> &source,
+			size_t rowCount)
+	{
+		size_t sourceWords = projection.sourceWordCount();
+		size_t targetWords = projection.targetWordCount();
+		vector<uint64_t> target(rowCount * targetWords, 0);
+		for(size_t row = 0; row < rowCount; ++row)
+			for(size_t i = 0; i < positions.size(); ++i)
+				if(positions[i] != BitProjection::NONE
+						&& bit(&source[row * sourceWords], positions[i]))
+					target[row * targetWords + i / 64] |=
+						uint64_t(1) << (i % 64);
+		return target;
+	}
+
+	void expectProjects(const vector<size_t> &positions, size_t sourceWidth)
+	{
+		BitProjection projection(positions, sourceWidth);
+		// more rows than a block, and not a multiple of it
+		size_t rowCount = 1000;
+		vector<uint64_t> source = randomRows(
+				rowCount, projection.sourceWordCount(), 42);
+
+		vector<uint64_t> target(rowCount * projection.targetWordCount());
+		projection.project(source.data(), rowCount, target.data());
+		EXPECT_EQ(referenceProject(positions, projection, source, rowCount),
+				target);
+	}
+
+	TEST(BitProjection, ForgetsPositions)
+	{
+		expectProjects({ 0, 1, 3, 4, 5, 9 }, 10);
+	}
+
+	TEST(BitProjection, ReordersPositions)
+	{
+		expectProjects({ 5, 6, 0, 1, 2, 9, 3 }, 10);
+	}
+
+	TEST(BitProjection, ProjectsFragmentedMonotoneMaps)
+	{
+		// more than two runs in order: the pext/pdep path where BMI2 is
+		// available, the run loop otherwise
+		expectProjects({ 0, 2, 4, 5, 6, 9, 11, 20, 40, 63 }, 64);
+		expectProjects({
+					1, 3, BitProjection::NONE, 7, 8, BitProjection::NONE,
+					12, 13, 30 },
+				31);
+	}
+
+	TEST(BitProjection, ProjectsFullWords)
+	{
+		vector<size_t> identity;
+		for(size_t i = 0; i < 64; ++i)
+			identity.push_back(i);
+		expectProjects(identity, 64);
+	}
+
+	TEST(BitProjection, ProjectsAcrossWords)
+	{
+		// runs crossing word boundaries on both sides
+		vector<size_t> positions;
+		for(size_t i = 10; i < 140; ++i)
+			if(i % 17 != 0)
+				positions.push_back(i);
+		positions.push_back(BitProjection::NONE);
+		positions.push_back(3);
+		expectProjects(positions, 150);
+	}
+
+	TEST(BitProjection, ClearsIntroducedPositions)
+	{
+		expectProjects({ BitProjection::NONE, 0, 1, BitProjection::NONE, 2 }, 3);
+	}
+
+	TEST(BitProjection, ExtendsWithEveryAssignment)
+	{
+		vector<size_t> positions = {
+			0, BitProjection::NONE, 1, 2,
+			BitProjection::NONE, BitProjection::NONE, 3
+		};
+		BitProjection projection(positions, 4);
+		ASSERT_EQ(8u, projection.extensionFactor());
+
+		size_t rowCount = 300;
+		vector<uint64_t> source = randomRows(rowCount, 1, 7);
+		vector<uint64_t> target(rowCount * projection.extensionFactor());
+		projection.extend(source.data(), rowCount, target.data());
+
+		vector<uint64_t> projected =
+			referenceProject(positions, projection, source, rowCount);
+		for(size_t combination = 0; combination < 8; ++combination)
+		{
+			uint64_t introduced =
+				(uint64_t(combination & 1u) << 1)
+				| (uint64_t((combination >> 1) & 1u) << 4)
+				| (uint64_t((combination >> 2) & 1u) << 5);
+			for(size_t row = 0; row < rowCount; ++row)
+				ASSERT_EQ(projected[row] | introduced,
+						target[combination * rowCount + row]);
+		}
+	}
+
+	TEST(BitProjection, ExtendsAcrossWords)
+	{
+		vector<size_t> positions;
+		for(size_t i = 0; i < 70; ++i)
+			positions.push_back(i);
+		positions.push_back(BitProjection::NONE);
+		positions.insert(positions.begin() + 3, BitProjection::NONE);
+		BitProjection projection(positions, 70);
+		ASSERT_EQ(2u, projection.targetWordCount());
+		ASSERT_EQ(4u, projection.extensionFactor());
+
+		size_t rowCount = 10;
+		vector<uint64_t> source = randomRows(rowCount, 2, 3);
+		vector<uint64_t> target(
+				rowCount * projection.extensionFactor() * 2);
+		projection.extend(source.data(), rowCount, target.data());
+
+		vector<uint64_t> projected =
+			referenceProject(positions, projection, source, rowCount);
+		for(size_t combination = 0; combination < 4; ++combination)
+			for(size_t row = 0; row < rowCount; ++row)
+			{
+				const uint64_t *extended =
+					&target[(combination * rowCount + row) * 2];
+				EXPECT_EQ(projected[row * 2]
+						| (uint64_t(combination & 1u) << 3), extended[0]);
+				EXPECT_EQ(projected[row * 2 + 1]
+						| (uint64_t(combination >> 1) << (71 - 64)),
+						extended[1]);
+			}
+	}
+
+	TEST(BitProjection, RejectsSourcePositionsOutOfRange)
+	{
+		EXPECT_THROW(BitProjection({ 0, 4 }, 4), std::invalid_argument);
+		EXPECT_THROW(BitProjection({ 2, 3, 4 }, 4), std::invalid_argument);
+	}
+
+	TEST(BitProjection, RejectsTooManyIntroducedPositionsOnExtend)
+	{
+		vector<size_t> positions(32, BitProjection::NONE);
+		BitProjection projection(positions, 0);
+
+		// projecting is fine, only the extension is limited
+		uint64_t source = 0;
+		uint64_t target = 1;
+		projection.project(&source, 1, &target);
+		EXPECT_EQ(0u, target);
+		EXPECT_THROW(projection.extend(&source, 1, &target),
+				std::invalid_argument);
+	}
+
+	TEST(BitProjection, MapsPositionsOfBags)
+	{
+		EXPECT_EQ(vector<size_t>({ 2, BitProjection::NONE, 0 }),
+				BitProjection::positionMap({ 4, 7, 9 }, { 9, 5, 4 }));
+	}
+
+} // namespace
@@ -0,0 +1,131 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sharp/BitTuple.hpp>
+#include <sharp/WideBitTuple.hpp>
+
+#include <random>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+	using sharp::BitTuple;
+	using sharp::WideBitTuple;
+	using sharp::ITuple;
+
+	using std::size_t;
+	using std::uint64_t;
+	using std::vector;
+
+	vector<bool> bitsOf(const BitTuple &tuple)
+	{
+		vector<bool> bits;
+		for(size_t i = 0; i < BitTuple::MAX_WIDTH; ++i)
+			bits.push_back(tuple.get(i));
+		return bits;
+	}
+
+	vector<bool> bitsOf(const WideBitTuple &tuple)
+	{
+		vector<bool> bits;
+		for(size_t i = 0; i < tuple.width(); ++i)
+			bits.push_back(tuple.get(i));
+		return bits;
+	}
+
+	TEST(BitTuple, SetsAndGetsBits)
+	{
+		BitTuple tuple;
+		tuple.set(0, true);
+		tuple.set(63, true);
+		tuple.set(5, true);
+		tuple.set(5, false);
+		EXPECT_EQ((uint64_t(1) << 63) | 1u, tuple.bits());
+		EXPECT_TRUE(tuple.get(63));
+		EXPECT_FALSE(tuple.get(5));
+	}
+
+	TEST(BitTuple, InsertsAndErasesAtEveryPosition)
+	{
+		std::mt19937_64 random(1);
+		for(size_t position = 0; position < BitTuple::MAX_WIDTH; ++position)
+		{
+			BitTuple tuple(random());
+			vector<bool> expected = bitsOf(tuple);
+
+			tuple.insert(position, true);
+			expected.insert(expected.begin() + position, true);
+			expected.pop_back();
+			EXPECT_EQ(expected, bitsOf(tuple)) << "insert at " << position;
+
+			tuple.erase(position);
+			expected.erase(expected.begin() + position);
+			expected.push_back(false);
+			EXPECT_EQ(expected, bitsOf(tuple)) << "erase at " << position;
+		}
+	}
+
+	TEST(BitTuple, ComparesAndHashesByBits)
+	{
+		BitTuple a(0x1234), b(0x1234), c(0x1235);
+		EXPECT_TRUE(a == b);
+		EXPECT_FALSE(a == c);
+		EXPECT_EQ(a.hash(), b.hash());
+
+		uint64_t bits = a.bits();
+		WideBitTuple wide(64, &bits);
+		EXPECT_FALSE(a == wide);
+	}
+
+	TEST(BitTuple, GathersRows)
+	{
+		BitTuple a(3), b(5), c(7);
+		const ITuple *tuples[] = { &a, &b, &c };
+		uint64_t rows[3];
+		BitTuple::gather(tuples, 3, rows);
+		EXPECT_EQ(3u, rows[0]);
+		EXPECT_EQ(5u, rows[1]);
+		EXPECT_EQ(7u, rows[2]);
+	}
+
+	TEST(WideBitTuple, InsertsAndErasesAcrossWords)
+	{
+		std::mt19937_64 random(2);
+		uint64_t words[3] = { random(), random(), random() };
+		for(size_t width : { 63u, 64u, 127u, 128u, 150u })
+			for(size_t position = 0; position <= width; ++position)
+			{
+				WideBitTuple tuple(width, words);
+				vector<bool> expected = bitsOf(tuple);
+
+				tuple.insert(position, position % 2 == 0);
+				expected.insert(expected.begin() + position,
+						position % 2 == 0);
+				ASSERT_EQ(width + 1, tuple.width());
+				ASSERT_EQ((width + 64) / 64, tuple.wordCount());
+				ASSERT_EQ(expected, bitsOf(tuple))
+					<< "insert at " << position << " of " << width;
+
+				tuple.erase(position);
+				expected.erase(expected.begin() + position);
+				ASSERT_EQ(width, tuple.width());
+				ASSERT_EQ(expected, bitsOf(tuple))
+					<< "erase at " << position << " of " << width;
+			}
+	}
+
+	TEST(WideBitTuple, ComparesAndHashesByWidthAndBits)
+	{
+		uint64_t words[2] = { 1, 0 };
+		WideBitTuple a(70, words), b(70, words), c(71, words);
+		EXPECT_TRUE(a == b);
+		EXPECT_EQ(a.hash(), b.hash());
+		EXPECT_FALSE(a == c);
+	}
+
+} // namespace
@@ -0,0 +1,178 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sharp/create.hpp>
+
+#include "NodeTableMap.hpp"
+#include "mocks/MockInstance.hpp"
+#include "mocks/MockValueTable.hpp"
+
+#include <htd/main.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+	using namespace sharp;
+	using sharp::test::MockInstance;
+	using sharp::test::MockValueTable;
+
+	using std::vector;
+
+	// lets every algorithm wait until a number of them have started
+	class Rendezvous
+	{
+	public:
+		Rendezvous(int count) : waiting_(count) { }
+
+		// false if the others did not arrive in time
+		bool arrive()
+		{
+			std::unique_lock<std::mutex> guard(lock_);
+			if(--waiting_ == 0) arrived_.notify_all();
+			return arrived_.wait_for(guard, std::chrono::seconds(10),
+					[this] { return waiting_ == 0; });
+		}
+
+	private:
+		int waiting_;
+		std::mutex lock_;
+		std::condition_variable arrived_;
+	};
+
+	enum Result { VALUE, NO_TABLE, FAILURE };
+
+	class Algorithm : public ITreeAlgorithm
+	{
+	public:
+		Algorithm(int value, Result result = VALUE,
+				Rendezvous *rendezvous = nullptr)
+			: met(false),
+			  value_(value),
+			  result_(result),
+			  rendezvous_(rendezvous)
+		{ }
+
+		virtual vector<const htd::ILabelingFunction *>
+			preprocessOperations() const override
+		{
+			return vector<const htd::ILabelingFunction *>();
+		}
+
+		virtual ITable *evaluateNode(
+				htd::vertex_t,
+				const htd::ITreeDecomposition &,
+				INodeTableMap &,
+				const IInstance &) const override
+		{
+			if(rendezvous_) met = rendezvous_->arrive();
+			switch(result_)
+			{
+			case NO_TABLE:
+				return nullptr;
+			case FAILURE:
+				throw std::runtime_error("failed");
+			default:
+				return new MockValueTable(value_);
+			}
+		}
+
+		virtual bool needAllTables() const override { return false; }
+
+		mutable bool met;
+
+	private:
+		int value_;
+		Result result_;
+		Rendezvous *rendezvous_;
+	};
+
+	// concatenates the digits of the outputs
+	class Concatenation : public ITableCombiner
+	{
+	public:
+		virtual ITable *combine(
+				htd::vertex_t,
+				const htd::ITreeDecomposition &,
+				const INodeTableMap &,
+				const IInstance &,
+				const vector<ITable *> &outputs) const override
+		{
+			int value = 0;
+			for(ITable *output : outputs)
+			{
+				value = value * 10
+					+ static_cast<MockValueTable *>(output)->value;
+				delete output;
+			}
+			return new MockValueTable(value);
+		}
+	};
+
+	std::unique_ptr<ITable> evaluate(const ITreeAlgorithm &algorithm)
+	{
+		std::unique_ptr<htd::IMutableTreeDecomposition> td(
+				htd::TreeDecompositionFactory::instance()
+					.getTreeDecomposition());
+		NodeTableMap tables;
+		MockInstance instance;
+		return std::unique_ptr<ITable>(
+				algorithm.evaluateNode(td->insertRoot(), *td, tables, instance));
+	}
+
+	TEST(ConcurrentTreeAlgorithm, RunsAlgorithmsAtTheSameTime)
+	{
+		Rendezvous rendezvous(3);
+		Algorithm a(1, VALUE, &rendezvous);
+		Algorithm b(2, VALUE, &rendezvous);
+		Algorithm c(3, VALUE, &rendezvous);
+		Concatenation combiner;
+		std::unique_ptr<ITreeAlgorithm> algorithm(
+				create::treeAlgorithm({ &a, &b, &c }, combiner));
+
+		std::unique_ptr<ITable> table = evaluate(*algorithm);
+		EXPECT_TRUE(a.met && b.met && c.met);
+		ASSERT_TRUE(table != nullptr);
+		// combined in the order of the algorithms
+		EXPECT_EQ(123, static_cast<MockValueTable &>(*table).value);
+	}
+
+	TEST(ConcurrentTreeAlgorithm, DropsTheNodeIfAnAlgorithmHasNoTable)
+	{
+		Algorithm a(1), none(2, NO_TABLE), c(3);
+		Concatenation combiner;
+		std::unique_ptr<ITreeAlgorithm> algorithm(
+				create::treeAlgorithm({ &a, &none, &c }, combiner));
+
+		EXPECT_TRUE(evaluate(*algorithm) == nullptr);
+		EXPECT_EQ(0, MockValueTable::liveTables);
+	}
+
+	TEST(ConcurrentTreeAlgorithm, RethrowsFailuresOfAlgorithms)
+	{
+		Algorithm a(1), failing(2, FAILURE), c(3);
+		Concatenation combiner;
+		std::unique_ptr<ITreeAlgorithm> algorithm(
+				create::treeAlgorithm({ &a, &failing, &c }, combiner));
+
+		EXPECT_THROW(evaluate(*algorithm), std::runtime_error);
+		EXPECT_EQ(0, MockValueTable::liveTables);
+	}
+
+	TEST(ConcurrentTreeAlgorithm, RejectsAnEmptyListOfAlgorithms)
+	{
+		Concatenation combiner;
+		EXPECT_THROW(
+				delete create::treeAlgorithm(TreeAlgorithmVector(), combiner),
+				std::invalid_argument);
+	}
+
+} // namespace
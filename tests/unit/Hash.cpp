@@ -0,0 +1,101 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sharp/Hash.hpp>
+#include <sharp/BitTuple.hpp>
+
+#include <random>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+	using sharp::Hash;
+	using sharp::BitTuple;
+
+	using std::size_t;
+	using std::uint64_t;
+	using std::vector;
+
+	size_t hashBytes(const void *data, size_t size)
+	{
+		Hash hash;
+		hash.add(data, size);
+		return hash.get();
+	}
+
+	TEST(Hash, HashesRowsLikeTheScalarHash)
+	{
+		std::mt19937_64 random(1);
+		for(size_t wordCount : { 1u, 2u, 3u, 5u })
+			// fewer rows than lanes, and a remainder after full lanes
+			for(size_t rowCount : { 0u, 1u, 7u, 8u, 101u })
+			{
+				vector<uint64_t> rows(rowCount * wordCount);
+				for(uint64_t &word : rows)
+					word = random();
+
+				vector<size_t> hashes(rowCount + 1, 0);
+				Hash::hashRows(rows.data(), wordCount, rowCount, hashes.data());
+				for(size_t row = 0; row < rowCount; ++row)
+					ASSERT_EQ(hashBytes(&rows[row * wordCount], wordCount * 8),
+							hashes[row])
+						<< "row " << row << " of " << rowCount
+						<< " with " << wordCount << " words";
+				// nothing written past the last row
+				EXPECT_EQ(0u, hashes[rowCount]);
+			}
+	}
+
+	TEST(Hash, HashesBitTuplesLikeRows)
+	{
+		uint64_t rows[3] = { 0, 0x123456789ABCDEF0u, ~uint64_t(0) };
+		size_t hashes[3];
+		Hash::hashRows(rows, 1, 3, hashes);
+		for(size_t i = 0; i < 3; ++i)
+			EXPECT_EQ(hashes[i], BitTuple(rows[i]).hash());
+	}
+
+	TEST(Hash, HashesTheByteCountOfBuffers)
+	{
+		const unsigned char bytes[12] =
+			{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 0, 0 };
+		EXPECT_EQ(hashBytes(bytes, 10), hashBytes(bytes, 10));
+		// trailing zero bytes still change the hash
+		EXPECT_NE(hashBytes(bytes, 10), hashBytes(bytes, 11));
+		EXPECT_NE(hashBytes(bytes, 11), hashBytes(bytes, 12));
+		EXPECT_NE(hashBytes(bytes, 0), hashBytes(bytes + 10, 1));
+	}
+
+	TEST(Hash, DependsOnTheOrderOfWords)
+	{
+		Hash a, b;
+		a.add(static_cast<size_t>(1));
+		a.add(static_cast<size_t>(2));
+		b.add(static_cast<size_t>(2));
+		b.add(static_cast<size_t>(1));
+		EXPECT_NE(a.get(), b.get());
+
+		b.reset();
+		b.add(static_cast<size_t>(1));
+		b.add(static_cast<size_t>(2));
+		EXPECT_EQ(a.get(), b.get());
+	}
+
+	TEST(Hash, IgnoresTheOrderOfUnorderedWords)
+	{
+		Hash a, b;
+		a.addUnordered(static_cast<size_t>(1));
+		a.addUnordered(static_cast<size_t>(2));
+		a.incorporateUnordered();
+		b.addUnordered(static_cast<size_t>(2));
+		b.addUnordered(static_cast<size_t>(1));
+		b.incorporateUnordered();
+		EXPECT_EQ(a.get(), b.get());
+	}
+
+} // namespace
@@ -0,0 +1,179 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sharp/HashJoin.hpp>
+#include <sharp/BitTuple.hpp>
+#include <sharp/Hash.hpp>
+
+#include "TupleSet.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include <utility>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+	using sharp::HashJoin;
+	using sharp::BitTuple;
+	using sharp::ITuple;
+	using sharp::ITupleSet;
+	using sharp::TupleSet;
+
+	using std::size_t;
+	using std::uint64_t;
+	using std::vector;
+
+	typedef std::pair<uint64_t, uint64_t> Pair;
+
+	// tuples join on their low bits
+	const uint64_t KEY_MASK = 0xFF;
+
+	uint64_t bitsOf(const ITuple &tuple)
+	{
+		return static_cast<const BitTuple &>(tuple).bits();
+	}
+
+	HashJoin join()
+	{
+		return HashJoin(
+				[](const ITuple &tuple)
+				{
+					sharp::Hash hash;
+					hash.add(static_cast<size_t>(bitsOf(tuple) & KEY_MASK));
+					return hash.get();
+				},
+				[](const ITuple &lhs, const ITuple &rhs)
+				{
+					return (bitsOf(lhs) & KEY_MASK)
+						== (bitsOf(rhs) & KEY_MASK);
+				});
+	}
+
+	void fill(TupleSet &set, size_t size, unsigned seed)
+	{
+		std::mt19937_64 random(seed);
+		for(size_t i = 0; i < size; ++i)
+			set.insert(new BitTuple(random()));
+	}
+
+	vector<Pair> nestedLoopJoin(const ITupleSet &left, const ITupleSet &right)
+	{
+		vector<Pair> pairs;
+		left.forEach([&](const ITuple &l)
+		{
+			right.forEach([&](const ITuple &r)
+			{
+				if((bitsOf(l) & KEY_MASK) == (bitsOf(r) & KEY_MASK))
+					pairs.push_back(Pair(bitsOf(l), bitsOf(r)));
+			});
+		});
+		std::sort(pairs.begin(), pairs.end());
+		return pairs;
+	}
+
+	vector<Pair> swapped(vector<Pair> pairs)
+	{
+		for(Pair &pair : pairs)
+			std::swap(pair.first, pair.second);
+		std::sort(pairs.begin(), pairs.end());
+		return pairs;
+	}
+
+	vector<Pair> hashJoin(
+			const ITupleSet &left,
+			const ITupleSet &right,
+			unsigned int threadCount)
+	{
+		HashJoin hashJoin = join();
+		hashJoin.setThreadCount(threadCount);
+
+		std::mutex lock;
+		vector<Pair> pairs;
+		hashJoin.join(left, right, [&](const ITuple &l, const ITuple &r)
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			pairs.push_back(Pair(bitsOf(l), bitsOf(r)));
+		});
+		std::sort(pairs.begin(), pairs.end());
+		return pairs;
+	}
+
+	TEST(HashJoin, MatchesNestedLoopJoin)
+	{
+		TupleSet left, right;
+		fill(left, 300, 1);
+		fill(right, 500, 2);
+
+		vector<Pair> expected = nestedLoopJoin(left, right);
+		ASSERT_FALSE(expected.empty());
+		EXPECT_EQ(expected, hashJoin(left, right, 1));
+		// indexes the smaller side, but still passes left tuples first
+		EXPECT_EQ(nestedLoopJoin(right, left), hashJoin(right, left, 1));
+	}
+
+	TEST(HashJoin, MatchesNestedLoopJoinWhenPartitioned)
+	{
+		// large enough for the partitioned join
+		TupleSet left, right;
+		fill(left, 8000, 3);
+		fill(right, 8500, 4);
+
+		vector<Pair> expected = nestedLoopJoin(left, right);
+		EXPECT_EQ(expected, hashJoin(left, right, 4));
+		EXPECT_EQ(expected, hashJoin(left, right, 3));
+		EXPECT_EQ(swapped(expected), hashJoin(right, left, 4));
+	}
+
+	TEST(HashJoin, JoinsEmptySets)
+	{
+		TupleSet left, right;
+		fill(left, 100, 5);
+		EXPECT_TRUE(hashJoin(left, right, 1).empty());
+		EXPECT_TRUE(hashJoin(right, left, 4).empty());
+	}
+
+	TEST(HashJoin, JoinsMoreThanTwoChildren)
+	{
+		TupleSet a, b, c;
+		fill(a, 200, 6);
+		fill(b, 50, 7);
+		fill(c, 100, 8);
+
+		vector<vector<uint64_t> > expected;
+		a.forEach([&](const ITuple &x)
+		{
+			b.forEach([&](const ITuple &y)
+			{
+				c.forEach([&](const ITuple &z)
+				{
+					uint64_t key = bitsOf(x) & KEY_MASK;
+					if((bitsOf(y) & KEY_MASK) == key
+							&& (bitsOf(z) & KEY_MASK) == key)
+						expected.push_back({ bitsOf(x), bitsOf(y), bitsOf(z) });
+				});
+			});
+		});
+		std::sort(expected.begin(), expected.end());
+		ASSERT_FALSE(expected.empty());
+
+		vector<vector<uint64_t> > combinations;
+		join().join({ &a, &b, &c }, [&](const vector<const ITuple *> &tuples)
+		{
+			ASSERT_EQ(3u, tuples.size());
+			combinations.push_back({
+					bitsOf(*tuples[0]),
+					bitsOf(*tuples[1]),
+					bitsOf(*tuples[2]) });
+		});
+		std::sort(combinations.begin(), combinations.end());
+		EXPECT_EQ(expected, combinations);
+	}
+
+} // namespace
@@ -0,0 +1,133 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sharp/HashStatistics.hpp>
+
+#include "TupleSet.hpp"
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace
+{
+	using sharp::HashStatistics;
+	using sharp::ITuple;
+	using sharp::TupleSet;
+
+	using std::size_t;
+	using std::string;
+	using std::vector;
+
+	typedef HashStatistics::Entry Entry;
+
+	// tuple with a given hash value, equal to tuples with the same id
+	class HashedTuple : public ITuple
+	{
+	public:
+		HashedTuple(size_t id, size_t hash) : id_(id), hash_(hash) { }
+
+		virtual size_t hash() const override { return hash_; }
+
+		virtual bool operator==(const ITuple &other) const override
+		{
+			return id_ == static_cast<const HashedTuple &>(other).id_;
+		}
+
+	private:
+		size_t id_;
+		size_t hash_;
+	};
+
+	TEST(HashStatistics, AnalyzesHashValues)
+	{
+		// buckets of 4: { 0, 4, 4 }, { 1 }, { }, { 7 }
+		Entry entry = HashStatistics::analyze("h", { 0, 1, 4, 4, 7 }, 4);
+		EXPECT_EQ("h", entry.name);
+		EXPECT_EQ(5u, entry.elements);
+		EXPECT_EQ(4u, entry.distinctHashes);
+		EXPECT_EQ(1u, entry.collisions);
+		EXPECT_EQ(4u, entry.buckets);
+		EXPECT_EQ(3u, entry.occupiedBuckets);
+		EXPECT_EQ(3u, entry.maxProbeLength);
+		// (1 + 2 + 3) + 1 + 1 probes for 5 lookups
+		EXPECT_DOUBLE_EQ(8.0 / 5, entry.meanProbeLength);
+		EXPECT_DOUBLE_EQ(5.0 / 4, entry.loadFactor());
+		EXPECT_DOUBLE_EQ(4.0 / 5, entry.distinctRatio());
+	}
+
+	TEST(HashStatistics, PicksAPowerOfTwoOfBuckets)
+	{
+		EXPECT_EQ(8u, HashStatistics::analyze("h", { 1, 2, 3, 4, 5 }).buckets);
+		EXPECT_EQ(4u, HashStatistics::analyze("h", { 1, 2, 3, 4 }).buckets);
+
+		Entry empty = HashStatistics::analyze("h", vector<size_t>());
+		EXPECT_EQ(1u, empty.buckets);
+		EXPECT_EQ(0u, empty.occupiedBuckets);
+		EXPECT_DOUBLE_EQ(0.0, empty.meanProbeLength);
+		EXPECT_DOUBLE_EQ(1.0, empty.distinctRatio());
+	}
+
+	TEST(HashStatistics, CountsOnlyUnequalTuplesAsCollisions)
+	{
+		TupleSet tuples;
+		tuples.insert(new HashedTuple(1, 10));
+		// equal to the first one
+		tuples.insert(new HashedTuple(1, 10));
+		// unequal, same hash
+		tuples.insert(new HashedTuple(2, 10));
+		tuples.insert(new HashedTuple(3, 10));
+		tuples.insert(new HashedTuple(4, 11));
+
+		Entry entry = HashStatistics::analyze("tuples", tuples, 2);
+		EXPECT_EQ(5u, entry.elements);
+		EXPECT_EQ(2u, entry.distinctHashes);
+		EXPECT_EQ(2u, entry.collisions);
+		EXPECT_EQ(2u, entry.occupiedBuckets);
+		EXPECT_EQ(4u, entry.maxProbeLength);
+	}
+
+	TEST(HashStatistics, RecordsAndPrintsEntries)
+	{
+		HashStatistics statistics;
+		EXPECT_FALSE(statistics.enabled());
+		statistics.enable(true);
+		EXPECT_TRUE(statistics.enabled());
+
+		std::ostringstream nothing;
+		statistics.print(nothing, false);
+		EXPECT_EQ("", nothing.str());
+
+		statistics.record(HashStatistics::analyze("a", { 0, 1, 4, 4, 7 }, 4));
+		statistics.record(HashStatistics::analyze("b", { 2 }, 1));
+		ASSERT_EQ(2u, statistics.entries().size());
+		EXPECT_EQ("b", statistics.entries()[1].name);
+
+		std::ostringstream csv;
+		statistics.print(csv, true);
+		EXPECT_EQ(
+				"name,elements,distinct,collisions,buckets,occupied,"
+				"load,maxprobe,meanprobe\n"
+				"a,5,4,1,4,3,1.25,3,1.60\n"
+				"b,1,1,0,1,1,1.00,1,1.00\n",
+				csv.str());
+
+		std::ostringstream text;
+		statistics.print(text, false);
+		EXPECT_EQ(
+				"hash statistics:\n"
+				"a: 5 elements, 80.00% distinct hashes, 1 collisions, "
+				"load 1.25, probe length 1.60 (mean) 3 (max)\n"
+				"b: 1 elements, 100.00% distinct hashes, 0 collisions, "
+				"load 1.00, probe length 1.00 (mean) 1 (max)\n",
+				text.str());
+
+		statistics.clear();
+		EXPECT_TRUE(statistics.entries().empty());
+	}
+
+} // namespace
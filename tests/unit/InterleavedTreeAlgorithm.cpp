@@ -0,0 +1,145 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sharp/create.hpp>
+
+#include "NodeTableMap.hpp"
+#include "mocks/MockInstance.hpp"
+#include "mocks/MockValueTable.hpp"
+
+#include <htd/main.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+	using namespace sharp;
+	using sharp::test::MockInstance;
+	using sharp::test::MockValueTable;
+
+	using std::vector;
+
+	const htd::vertex_t NODE = 1;
+	const htd::vertex_t CHILD = 2;
+
+	// appends digit to the value of the node's previous table, or returns
+	// no table if digit is negative
+	class Stage : public ITreeAlgorithm
+	{
+	public:
+		Stage(int digit, bool needAllTables = false)
+			: calls(0), digit_(digit), needAllTables_(needAllTables)
+		{ }
+
+		virtual vector<const htd::ILabelingFunction *>
+			preprocessOperations() const override
+		{
+			return vector<const htd::ILabelingFunction *>();
+		}
+
+		virtual ITable *evaluateNode(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &,
+				INodeTableMap &tables,
+				const IInstance &) const override
+		{
+			++calls;
+			// the tables of other nodes are passed through
+			childValue = valueOf(tables, CHILD);
+			if(digit_ < 0) return nullptr;
+
+			int previous = tables.contains(node) ? valueOf(tables, node) : 0;
+			return new MockValueTable(previous * 10 + digit_);
+		}
+
+		virtual bool needAllTables() const override { return needAllTables_; }
+
+		mutable int calls;
+		mutable int childValue;
+
+	private:
+		static int valueOf(const INodeTableMap &tables, htd::vertex_t node)
+		{
+			return static_cast<const MockValueTable &>(tables[node]).value;
+		}
+
+		int digit_;
+		bool needAllTables_;
+	};
+
+	// evaluates NODE with a child table of value 42
+	std::unique_ptr<MockValueTable> evaluate(const ITreeAlgorithm &algorithm)
+	{
+		std::unique_ptr<htd::IMutableTreeDecomposition> td(
+				htd::TreeDecompositionFactory::instance()
+					.getTreeDecomposition());
+		NodeTableMap tables;
+		tables.insert(CHILD, new MockValueTable(42));
+		MockInstance instance;
+
+		std::unique_ptr<MockValueTable> table(static_cast<MockValueTable *>(
+					algorithm.evaluateNode(NODE, *td, tables, instance)));
+		EXPECT_FALSE(tables.contains(NODE));
+		return table;
+	}
+
+	TEST(InterleavedTreeAlgorithm, ShowsEveryStageThePreviousTable)
+	{
+		Stage a(1), b(2), c(3), d(4);
+		std::unique_ptr<ITreeAlgorithm> algorithm(
+				create::treeAlgorithm({ &a, &b, &c, &d }));
+
+		std::unique_ptr<MockValueTable> table = evaluate(*algorithm);
+		ASSERT_TRUE(table != nullptr);
+		EXPECT_EQ(1234, table->value);
+		for(const Stage *stage : { &a, &b, &c, &d })
+		{
+			EXPECT_EQ(1, stage->calls);
+			EXPECT_EQ(42, stage->childValue);
+		}
+	}
+
+	TEST(InterleavedTreeAlgorithm, FlattensNestedAlgorithms)
+	{
+		Stage a(1), b(2), c(3);
+		std::unique_ptr<ITreeAlgorithm> inner(create::treeAlgorithm(a, b));
+		std::unique_ptr<ITreeAlgorithm> outer(create::treeAlgorithm(*inner, c));
+		std::unique_ptr<ITreeAlgorithm> twice(
+				create::treeAlgorithm({ inner.get(), outer.get() }));
+
+		EXPECT_EQ(123, evaluate(*outer)->value);
+		EXPECT_EQ(12123, evaluate(*twice)->value);
+	}
+
+	TEST(InterleavedTreeAlgorithm, StopsAtAStageWithoutTable)
+	{
+		Stage a(1), none(-1), c(3);
+		std::unique_ptr<ITreeAlgorithm> algorithm(
+				create::treeAlgorithm({ &a, &none, &c }));
+
+		EXPECT_TRUE(evaluate(*algorithm) == nullptr);
+		EXPECT_EQ(1, none.calls);
+		EXPECT_EQ(0, c.calls);
+	}
+
+	TEST(InterleavedTreeAlgorithm, NeedsAllTablesIfAStageDoes)
+	{
+		Stage a(1), b(2), c(3, true);
+		std::unique_ptr<ITreeAlgorithm> some(create::treeAlgorithm({ &a, &c }));
+		std::unique_ptr<ITreeAlgorithm> none(create::treeAlgorithm({ &a, &b }));
+		EXPECT_TRUE(some->needAllTables());
+		EXPECT_FALSE(none->needAllTables());
+	}
+
+	TEST(InterleavedTreeAlgorithm, RejectsAnEmptyListOfStages)
+	{
+		EXPECT_THROW(delete create::treeAlgorithm(TreeAlgorithmVector()),
+				std::invalid_argument);
+	}
+
+} // namespace
@@ -0,0 +1,112 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sharp/MultisetHash.hpp>
+#include <sharp/Hash.hpp>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+	using sharp::MultisetHash;
+	using sharp::Hash;
+
+	using std::size_t;
+	using std::uint64_t;
+	using std::vector;
+
+	MultisetHash hashOf(const vector<uint64_t> &elements)
+	{
+		MultisetHash hash;
+		hash.add(elements.begin(), elements.end());
+		return hash;
+	}
+
+	TEST(MultisetHash, IgnoresTheOrderOfElements)
+	{
+		vector<uint64_t> elements = { 1, 5, 5, 9, 100, 3 };
+		MultisetHash expected = hashOf(elements);
+
+		std::mt19937_64 random(1);
+		for(size_t i = 0; i < 10; ++i)
+		{
+			std::shuffle(elements.begin(), elements.end(), random);
+			EXPECT_TRUE(expected == hashOf(elements));
+			EXPECT_EQ(expected.get(), hashOf(elements).get());
+		}
+	}
+
+	TEST(MultisetHash, CountsRepeatedElements)
+	{
+		// xor alone would cancel the pair, the sum and count do not
+		EXPECT_NE(hashOf({ 1 }).get(), hashOf({ 1, 5, 5 }).get());
+		EXPECT_NE(hashOf({ 5 }).get(), hashOf({ 5, 5 }).get());
+		EXPECT_NE(hashOf({ }).get(), hashOf({ 0 }).get());
+		EXPECT_EQ(3u, hashOf({ 1, 5, 5 }).size());
+	}
+
+	TEST(MultisetHash, CombinesAndSubtractsSubsets)
+	{
+		MultisetHash a = hashOf({ 1, 2, 3 });
+		MultisetHash b = hashOf({ 3, 4 });
+
+		MultisetHash combined = a;
+		combined += b;
+		EXPECT_TRUE(hashOf({ 1, 2, 3, 3, 4 }) == combined);
+
+		combined -= a;
+		EXPECT_TRUE(b == combined);
+
+		combined.subtract(4);
+		EXPECT_TRUE(hashOf({ 3 }) == combined);
+
+		vector<uint64_t> rest = { 3 };
+		combined.subtract(rest.begin(), rest.end());
+		EXPECT_TRUE(MultisetHash() == combined);
+		EXPECT_EQ(0u, combined.size());
+	}
+
+	TEST(MultisetHash, HasFewCollisionsOnSmallSets)
+	{
+		// every subset of { 0, ..., 11 }
+		std::set<size_t> hashes;
+		for(uint64_t subset = 0; subset < (1u << 12); ++subset)
+		{
+			MultisetHash hash;
+			for(uint64_t element = 0; element < 12; ++element)
+				if(subset & (uint64_t(1) << element))
+					hash.add(element);
+			hashes.insert(hash.get());
+		}
+		EXPECT_EQ(size_t(1) << 12, hashes.size());
+	}
+
+	TEST(MultisetHash, FeedsUnorderedElementsIntoHash)
+	{
+		Hash a, b;
+		a.add(static_cast<size_t>(7));
+		a.addUnordered(hashOf({ 1, 2 }));
+		a.addUnordered(static_cast<size_t>(3));
+		a.incorporateUnordered();
+
+		b.add(static_cast<size_t>(7));
+		b.addUnordered(static_cast<size_t>(3));
+		b.addUnordered(static_cast<size_t>(2));
+		b.addUnordered(static_cast<size_t>(1));
+		EXPECT_EQ(hashOf({ 1, 2, 3 }).get(), b.getUnordered());
+		b.incorporateUnordered();
+		EXPECT_EQ(a.get(), b.get());
+
+		// incorporating starts a new multiset
+		EXPECT_EQ(MultisetHash().get(), b.getUnordered());
+	}
+
+} // namespace
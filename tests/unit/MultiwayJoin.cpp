@@ -0,0 +1,216 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sharp/MultiwayJoin.hpp>
+#include <sharp/BitTuple.hpp>
+#include <sharp/Hash.hpp>
+
+#include "TupleSet.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+	using sharp::MultiwayJoin;
+	using sharp::BitTuple;
+	using sharp::ITuple;
+	using sharp::ITupleSet;
+	using sharp::TupleSet;
+
+	using std::size_t;
+	using std::uint64_t;
+	using std::vector;
+
+	typedef vector<uint64_t> Combination;
+
+	uint64_t bitsOf(const ITuple &tuple)
+	{
+		return static_cast<const BitTuple &>(tuple).bits();
+	}
+
+	// tuples join on their low half
+	uint64_t keyOf(const ITuple &tuple)
+	{
+		return bitsOf(tuple) & 0xFFFFFFFF;
+	}
+
+	MultiwayJoin *join(
+			const vector<const ITupleSet *> &children,
+			unsigned int threadCount)
+	{
+		return new MultiwayJoin(children,
+				[](const ITuple &tuple)
+				{
+					sharp::Hash hash;
+					hash.add(static_cast<size_t>(keyOf(tuple)));
+					return hash.get();
+				},
+				[](const ITuple &lhs, const ITuple &rhs)
+				{
+					return keyOf(lhs) == keyOf(rhs);
+				},
+				threadCount);
+	}
+
+	// keyCount different keys, and a random high half to keep the tuples
+	// distinct
+	void fill(TupleSet &set, size_t size, uint64_t keyCount, unsigned seed)
+	{
+		std::mt19937_64 random(seed);
+		for(size_t i = 0; i < size; ++i)
+		{
+			uint64_t high = random() & ~uint64_t(0xFFFFFFFF);
+			set.insert(new BitTuple(high | (random() % keyCount)));
+		}
+	}
+
+	Combination bitsOf(const vector<const ITuple *> &tuples)
+	{
+		Combination bits;
+		for(const ITuple *tuple : tuples)
+			bits.push_back(bitsOf(*tuple));
+		return bits;
+	}
+
+	void nestedLoopJoin(
+			const vector<const ITupleSet *> &children,
+			Combination &prefix,
+			vector<Combination> &combinations)
+	{
+		if(prefix.size() == children.size())
+		{
+			combinations.push_back(prefix);
+			return;
+		}
+
+		children[prefix.size()]->forEach([&](const ITuple &tuple)
+		{
+			if(!prefix.empty() && (prefix[0] & 0xFFFFFFFF) != keyOf(tuple))
+				return;
+			prefix.push_back(bitsOf(tuple));
+			nestedLoopJoin(children, prefix, combinations);
+			prefix.pop_back();
+		});
+	}
+
+	vector<Combination> nestedLoopJoin(
+			const vector<const ITupleSet *> &children)
+	{
+		Combination prefix;
+		vector<Combination> combinations;
+		nestedLoopJoin(children, prefix, combinations);
+		std::sort(combinations.begin(), combinations.end());
+		return combinations;
+	}
+
+	vector<Combination> pulled(MultiwayJoin &join)
+	{
+		vector<Combination> combinations;
+		vector<const ITuple *> combination;
+		while(join.next(combination))
+			combinations.push_back(bitsOf(combination));
+		std::sort(combinations.begin(), combinations.end());
+		return combinations;
+	}
+
+	vector<Combination> pushed(const MultiwayJoin &join)
+	{
+		std::mutex lock;
+		vector<Combination> combinations;
+		join.forEach([&](const vector<const ITuple *> &combination)
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			combinations.push_back(bitsOf(combination));
+		});
+		std::sort(combinations.begin(), combinations.end());
+		return combinations;
+	}
+
+	TEST(MultiwayJoin, MatchesNestedLoopJoin)
+	{
+		TupleSet a, b, c, d;
+		fill(a, 120, 32, 1);
+		fill(b, 40, 32, 2);
+		fill(c, 200, 32, 3);
+		fill(d, 60, 8, 4);
+		vector<const ITupleSet *> children = { &a, &b, &c, &d };
+
+		vector<Combination> expected = nestedLoopJoin(children);
+		ASSERT_FALSE(expected.empty());
+
+		std::unique_ptr<MultiwayJoin> multiwayJoin(
+				join(children, 1));
+		EXPECT_EQ(expected, pulled(*multiwayJoin));
+		EXPECT_EQ(expected, pushed(*multiwayJoin));
+	}
+
+	TEST(MultiwayJoin, DrivesWithTheSmallestChild)
+	{
+		TupleSet a, b, c;
+		fill(a, 100, 64, 5);
+		fill(b, 30, 64, 6);
+		// fewer distinct keys than a
+		fill(c, 200, 4, 7);
+
+		std::unique_ptr<MultiwayJoin> multiwayJoin(
+				join({ &a, &b, &c }, 1));
+		EXPECT_EQ(vector<size_t>({ 1, 2, 0 }), multiwayJoin->order());
+	}
+
+	TEST(MultiwayJoin, StartsOverAfterReset)
+	{
+		TupleSet a, b;
+		fill(a, 50, 16, 8);
+		fill(b, 70, 16, 9);
+
+		std::unique_ptr<MultiwayJoin> multiwayJoin(join({ &a, &b }, 1));
+		vector<const ITuple *> combination;
+		ASSERT_TRUE(multiwayJoin->next(combination));
+		ASSERT_TRUE(multiwayJoin->next(combination));
+		multiwayJoin->reset();
+		EXPECT_EQ(nestedLoopJoin({ &a, &b }), pulled(*multiwayJoin));
+	}
+
+	TEST(MultiwayJoin, JoinsNothingWithAnEmptyChild)
+	{
+		TupleSet a, b, empty;
+		fill(a, 50, 16, 10);
+		fill(b, 70, 16, 11);
+
+		std::unique_ptr<MultiwayJoin> multiwayJoin(
+				join({ &a, &empty, &b }, 4));
+		EXPECT_TRUE(pulled(*multiwayJoin).empty());
+		EXPECT_TRUE(pushed(*multiwayJoin).empty());
+
+		std::unique_ptr<MultiwayJoin> noChildren(join({ }, 1));
+		EXPECT_TRUE(pulled(*noChildren).empty());
+		EXPECT_TRUE(pushed(*noChildren).empty());
+	}
+
+	TEST(MultiwayJoin, PushesTheSameCombinationsWithThreads)
+	{
+		// enough driver tuples for forEach() to split them between threads
+		TupleSet a, b, c;
+		fill(a, 17000, 16384, 12);
+		fill(b, 17000, 16384, 13);
+		fill(c, 20000, 16384, 14);
+
+		std::unique_ptr<MultiwayJoin> sequential(
+				join({ &a, &b, &c }, 1));
+		std::unique_ptr<MultiwayJoin> concurrent(
+				join({ &a, &b, &c }, 4));
+		vector<Combination> expected = pulled(*sequential);
+		ASSERT_FALSE(expected.empty());
+		EXPECT_EQ(expected, pushed(*concurrent));
+	}
+
+} // namespace
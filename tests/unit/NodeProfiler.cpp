@@ -0,0 +1,290 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sharp/NodeProfiler.hpp>
+#include <sharp/BitTuple.hpp>
+
+#include "NodeTableMap.hpp"
+#include "TupleSet.hpp"
+
+#include <htd/main.hpp>
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace
+{
+	using namespace sharp;
+
+	using std::size_t;
+	using std::string;
+	using std::vector;
+
+	typedef NodeProfiler::Entry Entry;
+
+	// a table that is no tuple set
+	struct OtherTable : public ITable { };
+
+	TupleSet *tuples(size_t count)
+	{
+		TupleSet *set = new TupleSet();
+		for(size_t i = 0; i < count; ++i)
+			set->insert(new BitTuple(i));
+		return set;
+	}
+
+	// root 1 with bag {1, 2} joins 2 and 3, which forgets 3 from its child
+	// 4 with bag {1, 2, 3}; 2 with bag {1, 2} introduces 2 into 5 with bag
+	// {1}, which exchanges vertex 4 with its child 6 with bag {4}
+	std::unique_ptr<htd::IMutableTreeDecomposition> decomposition()
+	{
+		std::unique_ptr<htd::IMutableTreeDecomposition> td(
+				htd::TreeDecompositionFactory::instance()
+					.getTreeDecomposition());
+		htd::vertex_t root = td->insertRoot();
+		htd::vertex_t introduce = td->addChild(root);
+		htd::vertex_t forget = td->addChild(root);
+		td->addChild(forget);
+		td->addChild(td->addChild(introduce));
+
+		td->mutableBagContent(1) = { 1, 2 };
+		td->mutableBagContent(2) = { 1, 2 };
+		td->mutableBagContent(3) = { 1, 2 };
+		td->mutableBagContent(4) = { 1, 2, 3 };
+		td->mutableBagContent(5) = { 1 };
+		td->mutableBagContent(6) = { 4 };
+		return td;
+	}
+
+	Entry entry(
+			const string &pass,
+			htd::vertex_t node,
+			NodeProfiler::NodeType type,
+			size_t bagSize,
+			double seconds,
+			long long allocatedBytes)
+	{
+		Entry entry;
+		entry.pass = pass;
+		entry.node = node;
+		entry.type = type;
+		entry.bagSize = bagSize;
+		entry.childCount = type == NodeProfiler::LEAF ? 0 : 1;
+		entry.inputTuples = node;
+		entry.outputTuples = 2 * node;
+		entry.seconds = seconds;
+		entry.allocatedBytes = allocatedBytes;
+		return entry;
+	}
+
+	// a leaf and a forget node with heap figures, and an unmeasured forget
+	// node
+	void record(NodeProfiler &profiler)
+	{
+		profiler.record(entry("first", 3, NodeProfiler::LEAF, 2, 0.5, 100));
+		profiler.record(entry("first", 2, NodeProfiler::FORGET, 1, 0.25, 20));
+		profiler.record(entry("se\"cond", 1, NodeProfiler::FORGET, 2, 1, -1));
+	}
+
+	TEST(NodeProfiler, ClassifiesNodesByTheirBags)
+	{
+		std::unique_ptr<htd::IMutableTreeDecomposition> td = decomposition();
+		EXPECT_EQ(NodeProfiler::JOIN, NodeProfiler::classify(1, *td));
+		EXPECT_EQ(NodeProfiler::INTRODUCE, NodeProfiler::classify(2, *td));
+		EXPECT_EQ(NodeProfiler::FORGET, NodeProfiler::classify(3, *td));
+		EXPECT_EQ(NodeProfiler::LEAF, NodeProfiler::classify(4, *td));
+		EXPECT_EQ(NodeProfiler::EXCHANGE, NodeProfiler::classify(5, *td));
+
+		// an unchanged bag counts as an exchange as well
+		td->mutableBagContent(6) = { 1 };
+		EXPECT_EQ(NodeProfiler::EXCHANGE, NodeProfiler::classify(5, *td));
+
+		EXPECT_EQ(string("leaf"), NodeProfiler::typeName(NodeProfiler::LEAF));
+		EXPECT_EQ(string("introduce"),
+				NodeProfiler::typeName(NodeProfiler::INTRODUCE));
+		EXPECT_EQ(string("forget"),
+				NodeProfiler::typeName(NodeProfiler::FORGET));
+		EXPECT_EQ(string("exchange"),
+				NodeProfiler::typeName(NodeProfiler::EXCHANGE));
+		EXPECT_EQ(string("join"), NodeProfiler::typeName(NodeProfiler::JOIN));
+	}
+
+	TEST(NodeProfiler, CountsTheTuplesOfTheInputTables)
+	{
+		std::unique_ptr<htd::IMutableTreeDecomposition> td = decomposition();
+		NodeTableMap tables;
+		tables.insert(1, tuples(7));
+		tables.insert(2, tuples(3));
+		tables.insert(3, new OtherTable());
+		tables.insert(4, tuples(5));
+
+		// the children bottom-up, where other tables count as empty
+		Entry root = NodeProfiler::begin("pass", 1, *td, tables, false);
+		EXPECT_EQ("pass", root.pass);
+		EXPECT_EQ(1u, root.node);
+		EXPECT_EQ(NodeProfiler::JOIN, root.type);
+		EXPECT_EQ(2u, root.bagSize);
+		EXPECT_EQ(2u, root.childCount);
+		EXPECT_EQ(3u, root.inputTuples);
+		EXPECT_EQ(0u, root.outputTuples);
+		EXPECT_LT(root.allocatedBytes, 0);
+
+		// missing child tables are skipped
+		EXPECT_EQ(0u, NodeProfiler::begin("pass", 2, *td, tables, false)
+				.inputTuples);
+
+		// the parent top-down, if there is one with a table
+		EXPECT_EQ(7u, NodeProfiler::begin("pass", 2, *td, tables, true)
+				.inputTuples);
+		EXPECT_EQ(0u, NodeProfiler::begin("pass", 1, *td, tables, true)
+				.inputTuples);
+		EXPECT_EQ(0u, NodeProfiler::begin("pass", 6, *td, tables, true)
+				.inputTuples);
+	}
+
+	TEST(NodeProfiler, RecordsEvaluations)
+	{
+		std::unique_ptr<htd::IMutableTreeDecomposition> td = decomposition();
+		NodeTableMap tables;
+		tables.insert(4, tuples(5));
+
+		NodeProfiler profiler;
+		EXPECT_FALSE(profiler.enabled());
+		profiler.enable(true);
+		EXPECT_TRUE(profiler.enabled());
+
+		Entry forget = NodeProfiler::begin("pass", 3, *td, tables, false);
+		NodeProfiler::Probe probe;
+		probe.start(false);
+		EXPECT_LT(probe.allocatedBytes(), 0);
+		std::unique_ptr<ITable> table(tuples(2));
+		profiler.end(forget, probe, table.get());
+
+		Entry leaf = NodeProfiler::begin("pass", 4, *td, tables, false);
+		probe.start(true);
+		profiler.end(leaf, probe, nullptr);
+
+		vector<Entry> entries = profiler.entries();
+		ASSERT_EQ(2u, entries.size());
+		EXPECT_EQ(3u, entries[0].node);
+		EXPECT_EQ(5u, entries[0].inputTuples);
+		EXPECT_EQ(2u, entries[0].outputTuples);
+		EXPECT_GE(entries[0].seconds, 0);
+		EXPECT_LT(entries[0].allocatedBytes, 0);
+		EXPECT_EQ(4u, entries[1].node);
+		EXPECT_EQ(0u, entries[1].outputTuples);
+		// measured if the C library reports the heap
+		EXPECT_EQ(NodeProfiler::heapUsage() >= 0,
+				entries[1].allocatedBytes >= 0);
+
+		profiler.clear();
+		EXPECT_TRUE(profiler.entries().empty());
+	}
+
+	TEST(NodeProfiler, PrintsEntriesAsCsv)
+	{
+		NodeProfiler profiler;
+		record(profiler);
+
+		std::ostringstream out;
+		profiler.printCsv(out);
+		EXPECT_EQ(
+				"pass,node,type,bagsize,children,tuplesin,tuplesout,"
+					"seconds,bytes\n"
+				"first,3,leaf,2,0,3,6,0.500000,100\n"
+				"first,2,forget,1,1,2,4,0.250000,20\n"
+				"se\"cond,1,forget,2,1,1,2,1.000000,\n",
+				out.str());
+	}
+
+	TEST(NodeProfiler, PrintsEntriesAsJson)
+	{
+		NodeProfiler profiler;
+		std::ostringstream empty;
+		profiler.printJson(empty);
+		EXPECT_EQ("[\n]\n", empty.str());
+
+		record(profiler);
+		std::ostringstream out;
+		profiler.printJson(out);
+		EXPECT_EQ(
+				"[\n"
+				" {\"pass\": \"first\", \"node\": 3, \"type\": \"leaf\", "
+					"\"bagSize\": 2, \"children\": 0, \"tuplesIn\": 3, "
+					"\"tuplesOut\": 6, \"seconds\": 0.500000, "
+					"\"bytes\": 100},\n"
+				" {\"pass\": \"first\", \"node\": 2, \"type\": \"forget\", "
+					"\"bagSize\": 1, \"children\": 1, \"tuplesIn\": 2, "
+					"\"tuplesOut\": 4, \"seconds\": 0.250000, "
+					"\"bytes\": 20},\n"
+				" {\"pass\": \"se\\\"cond\", \"node\": 1, \"type\": \"forget\", "
+					"\"bagSize\": 2, \"children\": 1, \"tuplesIn\": 1, "
+					"\"tuplesOut\": 2, \"seconds\": 1.000000, "
+					"\"bytes\": null}\n"
+				"]\n",
+				out.str());
+	}
+
+	TEST(NodeProfiler, SummarizesByTypeAndBagSize)
+	{
+		NodeProfiler profiler;
+		std::ostringstream empty;
+		profiler.printSummary(empty, false);
+		EXPECT_EQ("", empty.str());
+
+		record(profiler);
+		std::ostringstream text;
+		profiler.printSummary(text, false);
+		EXPECT_EQ(
+				"node profile:\n"
+				"type leaf: 1 nodes, 0.500000s (total), 0.500000s (mean), "
+					"0.500000s (max), 3 tuples in, 6 tuples out, "
+					"100 bytes allocated (1 nodes measured)\n"
+				"type forget: 2 nodes, 1.250000s (total), 0.625000s (mean), "
+					"1.000000s (max), 3 tuples in, 6 tuples out, "
+					"20 bytes allocated (1 nodes measured)\n"
+				"bagsize 1: 1 nodes, 0.250000s (total), 0.250000s (mean), "
+					"0.250000s (max), 2 tuples in, 4 tuples out, "
+					"20 bytes allocated (1 nodes measured)\n"
+				"bagsize 2: 2 nodes, 1.500000s (total), 0.750000s (mean), "
+					"1.000000s (max), 4 tuples in, 8 tuples out, "
+					"100 bytes allocated (1 nodes measured)\n",
+				text.str());
+
+		// without any heap figures the bytes are left out
+		profiler.clear();
+		profiler.record(entry("pass", 1, NodeProfiler::JOIN, 3, 2, -1));
+		std::ostringstream csv;
+		profiler.printSummary(csv, true);
+		EXPECT_EQ(
+				"group,key,nodes,seconds,mean,max,tuplesin,tuplesout,bytes\n"
+				"type,join,1,2.000000,2.000000,2.000000,1,2,\n"
+				"bagsize,3,1,2.000000,2.000000,2.000000,1,2,\n",
+				csv.str());
+	}
+
+	TEST(NodeProfiler, RestoresTheStreamFormat)
+	{
+		NodeProfiler profiler;
+		record(profiler);
+
+		std::ostringstream out;
+		out.precision(2);
+		profiler.printCsv(out);
+		profiler.printJson(out);
+		profiler.printSummary(out, false);
+		std::ostringstream tail;
+		tail.precision(2);
+		tail << 0.125;
+		out.str("");
+		out << 0.125;
+		EXPECT_EQ(tail.str(), out.str());
+	}
+
+} // namespace
@@ -0,0 +1,136 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include "NodeTableMap.hpp"
+#include "NodeTableMapOverlay.hpp"
+#include "mocks/MockValueTable.hpp"
+
+#include <stdexcept>
+
+namespace
+{
+	using sharp::INodeTableMap;
+	using sharp::NodeTableMap;
+	using sharp::NodeTableMapOverlay;
+	using sharp::test::MockValueTable;
+
+	int valueOf(const INodeTableMap &tables, htd::vertex_t node)
+	{
+		return static_cast<const MockValueTable &>(tables[node]).value;
+	}
+
+	int mutableValueOf(INodeTableMap &tables, htd::vertex_t node)
+	{
+		return static_cast<MockValueTable &>(tables.at(node)).value;
+	}
+
+	// nodes 1 and 2 with tables of value 10 and 20
+	void fill(NodeTableMap &tables)
+	{
+		tables.insert(1, new MockValueTable(10));
+		tables.insert(2, new MockValueTable(20));
+	}
+
+	TEST(NodeTableMapOverlay, ReplacesAndRestoresTables)
+	{
+		NodeTableMap tables;
+		fill(tables);
+		MockValueTable replacement(11), other(12), added(30);
+
+		NodeTableMapOverlay overlay(tables, 1, replacement);
+		EXPECT_EQ(11, valueOf(overlay, 1));
+		EXPECT_EQ(20, valueOf(overlay, 2));
+
+		overlay.replace(1, other);
+		overlay.replace(3, added);
+		EXPECT_EQ(12, valueOf(overlay, 1));
+		EXPECT_TRUE(overlay.contains(3));
+		EXPECT_FALSE(tables.contains(3));
+
+		overlay.restore(1);
+		overlay.restore(3);
+		EXPECT_EQ(10, valueOf(overlay, 1));
+		EXPECT_FALSE(overlay.contains(3));
+		EXPECT_FALSE(overlay.contains(4));
+		EXPECT_THROW(valueOf(overlay, 4), std::logic_error);
+	}
+
+	TEST(NodeTableMapOverlay, WritesThroughToMutableTables)
+	{
+		NodeTableMap tables;
+		fill(tables);
+		MockValueTable replacement(11);
+
+		NodeTableMapOverlay overlay(tables, 1, replacement);
+		static_cast<MockValueTable &>(overlay.at(1)).value = 13;
+		static_cast<MockValueTable &>(overlay[2]).value = 23;
+		EXPECT_EQ(13, replacement.value);
+		EXPECT_EQ(23, valueOf(tables, 2));
+	}
+
+	TEST(NodeTableMapOverlay, RefusesWritesToReadOnlyTables)
+	{
+		NodeTableMap tables;
+		fill(tables);
+		const MockValueTable constReplacement(11);
+		MockValueTable replacement(12);
+
+		const INodeTableMap &constTables = tables;
+		NodeTableMapOverlay readOnly(constTables);
+		readOnly.replace(1, replacement);
+		EXPECT_EQ(12, mutableValueOf(readOnly, 1));
+		EXPECT_THROW(mutableValueOf(readOnly, 2), std::logic_error);
+		EXPECT_EQ(20, valueOf(readOnly, 2));
+		EXPECT_THROW(readOnly.clear(), std::logic_error);
+
+		NodeTableMapOverlay writable(tables);
+		writable.replace(1, constReplacement);
+		EXPECT_THROW(mutableValueOf(writable, 1), std::logic_error);
+		EXPECT_EQ(11, valueOf(writable, 1));
+		EXPECT_EQ(20, mutableValueOf(writable, 2));
+	}
+
+	TEST(NodeTableMapOverlay, FlattensOverlaysOfOverlays)
+	{
+		NodeTableMap tables;
+		fill(tables);
+		MockValueTable first(11), second(21);
+
+		NodeTableMapOverlay inner(tables, 1, first);
+		NodeTableMapOverlay outer(inner, 2, second);
+		EXPECT_EQ(11, mutableValueOf(outer, 1));
+		EXPECT_EQ(21, mutableValueOf(outer, 2));
+
+		// the outer overlay copied the replacements of the inner one
+		inner.restore(1);
+		EXPECT_EQ(10, valueOf(inner, 1));
+		EXPECT_EQ(11, valueOf(outer, 1));
+		outer.restore(1);
+		EXPECT_EQ(10, valueOf(outer, 1));
+
+		// copies of a const overlay are read-only
+		const NodeTableMapOverlay &constOuter = outer;
+		NodeTableMapOverlay copy(constOuter);
+		EXPECT_EQ(21, valueOf(copy, 2));
+		EXPECT_THROW(mutableValueOf(copy, 2), std::logic_error);
+		EXPECT_THROW(mutableValueOf(copy, 1), std::logic_error);
+	}
+
+	TEST(NodeTableMapOverlay, ClearsReplacementsAndTheOriginal)
+	{
+		NodeTableMap tables;
+		fill(tables);
+		MockValueTable replacement(11);
+
+		NodeTableMapOverlay overlay(tables, 3, replacement);
+		overlay.clear();
+		EXPECT_FALSE(overlay.contains(1));
+		EXPECT_FALSE(overlay.contains(3));
+		EXPECT_FALSE(tables.contains(1));
+		EXPECT_FALSE(tables.contains(2));
+	}
+
+} // namespace
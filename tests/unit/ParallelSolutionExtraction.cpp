@@ -0,0 +1,254 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sharp/ITreeSolutionExtractor.hpp>
+#include <sharp/ITreeParallelSolutionExtractor.hpp>
+
+#include "NodeTableMap.hpp"
+#include "ParallelSolutionExtraction.hpp"
+#include "mocks/MockInstance.hpp"
+#include "mocks/MockValueTable.hpp"
+
+#include <htd/main.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include <cstddef>
+
+namespace
+{
+	using namespace sharp;
+	using sharp::test::MockInstance;
+	using sharp::test::MockValueTable;
+
+	using std::size_t;
+	using std::vector;
+
+	std::atomic<int> liveSolutions(0);
+
+	// the sums of the table values on the path from the root to each
+	// node, in preorder
+	struct SumsSolution : public ISolution
+	{
+		SumsSolution() { ++liveSolutions; }
+		virtual ~SumsSolution() override { --liveSolutions; }
+
+		vector<int> sums;
+	};
+
+	// lets the extraction of a number of nodes wait for each other
+	class Rendezvous
+	{
+	public:
+		Rendezvous(int count) : waiting_(count) { }
+
+		// false if the others did not arrive in time
+		bool arrive()
+		{
+			std::unique_lock<std::mutex> guard(lock_);
+			if(--waiting_ == 0) arrived_.notify_all();
+			return arrived_.wait_for(guard, std::chrono::seconds(10),
+					[this] { return waiting_ == 0; });
+		}
+
+	private:
+		int waiting_;
+		std::mutex lock_;
+		std::condition_variable arrived_;
+	};
+
+	class Extractor
+		: public ITreeSolutionExtractor,
+		  public ITreeParallelSolutionExtractor
+	{
+	public:
+		Extractor(htd::vertex_t failing = 0, Rendezvous *rendezvous = nullptr)
+			: met(true), failing_(failing), rendezvous_(rendezvous)
+		{ }
+
+		// the sequential reference
+		virtual ISolution *extractSolution(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				const INodeTableMap &tables,
+				const IInstance &instance) const override
+		{
+			return sequential(node, decomposition, tables, instance, 0);
+		}
+
+		virtual ISolution *emptySolution(const IInstance &) const override
+		{
+			return new SumsSolution();
+		}
+
+		virtual ISolution *extractNode(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				const INodeTableMap &tables,
+				const ISolution *parentPart,
+				const IInstance &) const override
+		{
+			if(rendezvous_ && decomposition.childCount(node) == 0
+					&& !rendezvous_->arrive())
+				met = false;
+
+			SumsSolution *part = new SumsSolution();
+			part->sums.push_back(value(node, tables) + (parentPart
+					? static_cast<const SumsSolution *>(parentPart)->sums[0]
+					: 0));
+			return part;
+		}
+
+		virtual ISolution *combine(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &,
+				const INodeTableMap &,
+				ISolution *nodePart,
+				const vector<ISolution *> &childResults,
+				const IInstance &) const override
+		{
+			if(node == failing_) throw std::runtime_error("failed");
+
+			SumsSolution *combined = static_cast<SumsSolution *>(nodePart);
+			for(ISolution *child : childResults)
+			{
+				vector<int> &sums = static_cast<SumsSolution *>(child)->sums;
+				combined->sums.insert(combined->sums.end(),
+						sums.begin(), sums.end());
+				delete child;
+			}
+			return combined;
+		}
+
+		mutable std::atomic<bool> met;
+
+	private:
+		static int value(htd::vertex_t node, const INodeTableMap &tables)
+		{
+			return static_cast<const MockValueTable &>(tables[node]).value;
+		}
+
+		SumsSolution *sequential(
+				htd::vertex_t node,
+				const htd::ITreeDecomposition &decomposition,
+				const INodeTableMap &tables,
+				const IInstance &instance,
+				int sum) const
+		{
+			SumsSolution *solution = new SumsSolution();
+			sum += value(node, tables);
+			solution->sums.push_back(sum);
+			for(size_t i = 0; i < decomposition.childCount(node); ++i)
+			{
+				std::unique_ptr<SumsSolution> child(sequential(
+							decomposition.childAtPosition(node, i),
+							decomposition,
+							tables,
+							instance,
+							sum));
+				solution->sums.insert(solution->sums.end(),
+						child->sums.begin(), child->sums.end());
+			}
+			return solution;
+		}
+
+		htd::vertex_t failing_;
+		Rendezvous *rendezvous_;
+	};
+
+	// node i > 1 is a child of node (i + 1) / 3, so inner nodes have up to
+	// three children; every node gets a table
+	std::unique_ptr<htd::ITreeDecomposition> decomposition(
+			size_t size,
+			NodeTableMap &tables)
+	{
+		htd::IMutableTreeDecomposition *td =
+			htd::TreeDecompositionFactory::instance().getTreeDecomposition();
+		tables.insert(td->insertRoot(), new MockValueTable(1));
+		for(htd::vertex_t node = 2; node <= size; ++node)
+			tables.insert(td->addChild((node + 1) / 3),
+					new MockValueTable(int(node * 7 % 11)));
+		return std::unique_ptr<htd::ITreeDecomposition>(td);
+	}
+
+	vector<int> sumsOf(ISolution *solution)
+	{
+		std::unique_ptr<ISolution> owned(solution);
+		EXPECT_TRUE(owned != nullptr);
+		return owned ? static_cast<SumsSolution &>(*owned).sums : vector<int>();
+	}
+
+	class ParallelSolutionExtraction
+		: public ::testing::TestWithParam<unsigned int>
+	{ };
+
+	TEST_P(ParallelSolutionExtraction, MatchesSequentialExtraction)
+	{
+		Extractor extractor;
+		MockInstance instance;
+		for(size_t size : { 1, 2, 4, 40, 500 })
+		{
+			NodeTableMap tables;
+			std::unique_ptr<htd::ITreeDecomposition> td =
+				decomposition(size, tables);
+
+			vector<int> expected = sumsOf(extractor.extractSolution(
+						td->root(), *td, tables, instance));
+			EXPECT_EQ(size, expected.size());
+			EXPECT_EQ(expected, sumsOf(extractConcurrently(
+						extractor, *td, tables, instance, GetParam())));
+		}
+		EXPECT_EQ(0, liveSolutions);
+	}
+
+	TEST_P(ParallelSolutionExtraction, DeletesAllPartsIfCombineThrows)
+	{
+		MockInstance instance;
+		NodeTableMap tables;
+		std::unique_ptr<htd::ITreeDecomposition> td =
+			decomposition(40, tables);
+
+		// an inner node and the root
+		for(htd::vertex_t failing : { 4, 1 })
+		{
+			Extractor extractor(failing);
+			EXPECT_THROW(
+					delete extractConcurrently(
+						extractor, *td, tables, instance, GetParam()),
+					std::runtime_error);
+			EXPECT_EQ(0, liveSolutions);
+		}
+	}
+
+	INSTANTIATE_TEST_CASE_P(Threads, ParallelSolutionExtraction,
+			::testing::Values(1u, 4u));
+
+	TEST(ConcurrentSubtrees, AreExtractedAtTheSameTime)
+	{
+		MockInstance instance;
+		NodeTableMap tables;
+		// root 1 with the leaves 2 and 3, which only finish together
+		htd::IMutableTreeDecomposition *mutableTd =
+			htd::TreeDecompositionFactory::instance().getTreeDecomposition();
+		std::unique_ptr<htd::ITreeDecomposition> td(mutableTd);
+		htd::vertex_t root = mutableTd->insertRoot();
+		tables.insert(root, new MockValueTable(1));
+		tables.insert(mutableTd->addChild(root), new MockValueTable(2));
+		tables.insert(mutableTd->addChild(root), new MockValueTable(3));
+
+		Rendezvous rendezvous(2);
+		Extractor extractor(0, &rendezvous);
+		EXPECT_EQ(vector<int>({ 1, 3, 4 }), sumsOf(extractConcurrently(
+					extractor, *td, tables, instance, 2)));
+		EXPECT_TRUE(extractor.met);
+	}
+
+} // namespace
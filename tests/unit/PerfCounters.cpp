@@ -0,0 +1,158 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sharp/PerfCounters.hpp>
+
+#include <sstream>
+#include <string>
+
+namespace
+{
+	using sharp::PerfCounters;
+
+	using std::string;
+
+	// counts[i] = base * (i + 1)
+	PerfCounters::Values values(long long base)
+	{
+		PerfCounters::Values values;
+		for(int i = 0; i < PerfCounters::COUNTER_COUNT; ++i)
+			values.counts[i] = base * (i + 1);
+		return values;
+	}
+
+	string printed(const PerfCounters &counters, bool csv)
+	{
+		std::ostringstream out;
+		counters.print(out, csv);
+		return out.str();
+	}
+
+	TEST(PerfCounters, NamesTheCounters)
+	{
+		EXPECT_EQ(string("cycles"),
+				PerfCounters::counterName(PerfCounters::CYCLES));
+		EXPECT_EQ(string("instructions"),
+				PerfCounters::counterName(PerfCounters::INSTRUCTIONS));
+		EXPECT_EQ(string("LLC misses"),
+				PerfCounters::counterName(PerfCounters::LLC_MISSES));
+		EXPECT_EQ(string("dTLB misses"),
+				PerfCounters::counterName(PerfCounters::DTLB_MISSES));
+		EXPECT_EQ(string("branch misses"),
+				PerfCounters::counterName(PerfCounters::BRANCH_MISSES));
+	}
+
+	TEST(PerfCounters, SumsSamplesByPassAndKind)
+	{
+		PerfCounters counters;
+		EXPECT_FALSE(counters.enabled());
+		EXPECT_EQ("", printed(counters, false));
+
+		counters.record("second", "leaf", values(100));
+		counters.record("first", "join", values(10));
+		counters.record("first", "join", values(30));
+
+		EXPECT_EQ(
+				"perf counters (sampling thread only, work handed to other "
+					"threads is not counted):\n"
+				"first join: 2 samples, 40 cycles, 80 instructions, "
+					"120 LLC misses, 160 dTLB misses, 200 branch misses, "
+					"2.00 IPC\n"
+				"second leaf: 1 samples, 100 cycles, 200 instructions, "
+					"300 LLC misses, 400 dTLB misses, 500 branch misses, "
+					"2.00 IPC\n",
+				printed(counters, false));
+		EXPECT_EQ(
+				"pass,kind,samples,cycles,instructions,ipc,llcmisses,"
+					"dtlbmisses,branchmisses\n"
+				"first,join,2,40,80,2.00,120,160,200\n"
+				"second,leaf,1,100,200,2.00,300,400,500\n",
+				printed(counters, true));
+
+		counters.clear();
+		EXPECT_EQ("", printed(counters, true));
+	}
+
+	TEST(PerfCounters, LeavesOutCountersThatAreNotAvailable)
+	{
+		PerfCounters counters;
+		PerfCounters::Values some = values(10);
+		some.counts[PerfCounters::CYCLES] = -1;
+		some.counts[PerfCounters::DTLB_MISSES] = -1;
+		counters.record("pass", "extraction", some);
+
+		// a counter is shown if any sample has it
+		PerfCounters::Values none = values(1);
+		for(long long &count : none.counts)
+			count = -1;
+		none.counts[PerfCounters::BRANCH_MISSES] = 5;
+		counters.record("pass", "forget", none);
+		counters.record("pass", "forget", values(1));
+
+		EXPECT_EQ(
+				"perf counters (sampling thread only, work handed to other "
+					"threads is not counted):\n"
+				"pass extraction: 1 samples, 20 instructions, "
+					"30 LLC misses, 50 branch misses\n"
+				"pass forget: 2 samples, 1 cycles, 2 instructions, "
+					"3 LLC misses, 4 dTLB misses, 10 branch misses, "
+					"2.00 IPC\n",
+				printed(counters, false));
+		EXPECT_EQ(
+				"pass,kind,samples,cycles,instructions,ipc,llcmisses,"
+					"dtlbmisses,branchmisses\n"
+				"pass,extraction,1,,20,,30,,50\n"
+				"pass,forget,2,1,2,2.00,3,4,10\n",
+				printed(counters, true));
+	}
+
+	TEST(PerfCounters, RecordsOnlySamplesThatRan)
+	{
+		PerfCounters counters;
+		counters.enable(true);
+		EXPECT_TRUE(counters.enabled());
+
+		PerfCounters::Sample unstarted;
+		PerfCounters::Values unused;
+		EXPECT_FALSE(unstarted.stop(unused));
+		counters.record("pass", "leaf", unstarted);
+		EXPECT_EQ("", printed(counters, false));
+
+		// counters may be missing, e.g. in containers
+		PerfCounters::Sample sample;
+		sample.start();
+		volatile long long sum = 0;
+		for(int i = 0; i < 100000; ++i)
+			sum += i;
+		PerfCounters::Values counted;
+		if(sample.stop(counted))
+		{
+			EXPECT_TRUE(PerfCounters::available());
+			counters.record("pass", "leaf", sample);
+			EXPECT_NE("", printed(counters, false));
+		}
+		else
+		{
+			counters.record("pass", "leaf", sample);
+			EXPECT_EQ("", printed(counters, false));
+		}
+	}
+
+	TEST(PerfCounters, RestoresTheStreamFormat)
+	{
+		PerfCounters counters;
+		counters.record("pass", "leaf", values(3));
+
+		std::ostringstream out;
+		out.precision(3);
+		counters.print(out, false);
+		counters.print(out, true);
+		out.str("");
+		out << 1.5 << " " << 1.0 / 3;
+		EXPECT_EQ("1.5 0.333", out.str());
+	}
+
+} // namespace
@@ -0,0 +1,275 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sharp/ITupleProjection.hpp>
+#include <sharp/BitTuple.hpp>
+#include <sharp/Hash.hpp>
+
+#include "SemiJoinReducer.hpp"
+#include "TupleSet.hpp"
+
+#include <htd/main.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+	using namespace sharp;
+
+	using std::size_t;
+	using std::uint32_t;
+	using std::uint64_t;
+	using std::vector;
+
+	// tuples of all nodes match on their low byte, the rest tells them apart
+	uint64_t keyOf(const ITuple &tuple)
+	{
+		return static_cast<const BitTuple &>(tuple).bits() & 0xFF;
+	}
+
+	uint64_t idOf(const ITuple &tuple)
+	{
+		return static_cast<const BitTuple &>(tuple).bits() >> 8;
+	}
+
+	class Projection : public ITupleProjection
+	{
+	public:
+		virtual size_t projectionHash(
+				htd::vertex_t,
+				htd::vertex_t,
+				const ITuple &tuple,
+				const htd::ITreeDecomposition &) const override
+		{
+			Hash hash;
+			hash.add(static_cast<size_t>(keyOf(tuple)));
+			return hash.get();
+		}
+
+		virtual bool projectionsEqual(
+				htd::vertex_t,
+				const ITuple &tuple1,
+				htd::vertex_t,
+				const ITuple &tuple2,
+				const htd::ITreeDecomposition &) const override
+		{
+			return keyOf(tuple1) == keyOf(tuple2);
+		}
+	};
+
+	// Hashing the tuples of node 3 waits until those of node 4 are hashed
+	// and vice versa, so the edges into 3 and into 4 have to be reduced at
+	// the same time.
+	class MeetingProjection : public Projection
+	{
+	public:
+		MeetingProjection() : met(true), waiting_(2) { }
+
+		virtual size_t projectionHash(
+				htd::vertex_t node,
+				htd::vertex_t other,
+				const ITuple &tuple,
+				const htd::ITreeDecomposition &decomposition) const override
+		{
+			if((node == 3 || node == 4) && !arrived_[node - 3].exchange(true)
+					&& !this->arrive())
+				met = false;
+			return Projection::projectionHash(
+					node, other, tuple, decomposition);
+		}
+
+		mutable std::atomic<bool> met;
+
+	private:
+		// false if the other node did not arrive in time
+		bool arrive() const
+		{
+			std::unique_lock<std::mutex> guard(lock_);
+			if(--waiting_ == 0) arrivedAll_.notify_all();
+			return arrivedAll_.wait_for(guard, std::chrono::seconds(10),
+					[this] { return waiting_ == 0; });
+		}
+
+		mutable std::atomic<bool> arrived_[2] = { { false }, { false } };
+		mutable int waiting_;
+		mutable std::mutex lock_;
+		mutable std::condition_variable arrivedAll_;
+	};
+
+	// owns the tuple sets of the nodes
+	class Tables : public INodeTupleSetMap
+	{
+	public:
+		// adds a tuple with the given key and id to the set of node
+		TupleSet &add(htd::vertex_t node, uint64_t key, uint64_t id)
+		{
+			std::unique_ptr<TupleSet> &tuples = tables_[node];
+			if(!tuples) tuples.reset(new TupleSet());
+			tuples->insert(new BitTuple((id << 8) | key));
+			return *tuples;
+		}
+
+		// ids of the tuples of node, in order
+		vector<uint64_t> ids(htd::vertex_t node) const
+		{
+			vector<uint64_t> ids;
+			(*this)[node].forEach([&](const ITuple &tuple)
+			{
+				ids.push_back(idOf(tuple));
+			});
+			return ids;
+		}
+
+		virtual ITupleSet &operator[](htd::vertex_t node) override
+		{
+			return *tables_.at(node);
+		}
+
+		virtual ITupleSet &at(htd::vertex_t node) override
+		{
+			return *tables_.at(node);
+		}
+
+		virtual const ITupleSet &operator[](htd::vertex_t node) const override
+		{
+			return *tables_.at(node);
+		}
+
+		virtual const ITupleSet &at(htd::vertex_t node) const override
+		{
+			return *tables_.at(node);
+		}
+
+		virtual bool contains(htd::vertex_t node) const override
+		{
+			return tables_.count(node) != 0;
+		}
+
+		virtual void clear() override { tables_.clear(); }
+
+	private:
+		std::map<htd::vertex_t, std::unique_ptr<TupleSet> > tables_;
+	};
+
+	// root 1 with children 2 and 3; 2 has child 4
+	std::unique_ptr<htd::ITreeDecomposition> decomposition()
+	{
+		htd::IMutableTreeDecomposition *td =
+			htd::TreeDecompositionFactory::instance().getTreeDecomposition();
+		htd::vertex_t root = td->insertRoot();
+		htd::vertex_t a = td->addChild(root);
+		td->addChild(root);
+		td->addChild(a);
+		return std::unique_ptr<htd::ITreeDecomposition>(td);
+	}
+
+	class SemiJoinReduction : public ::testing::TestWithParam<unsigned int>
+	{ };
+
+	TEST_P(SemiJoinReduction, RemovesTuplesWithoutMatchInTheParent)
+	{
+		std::unique_ptr<htd::ITreeDecomposition> td = decomposition();
+		Tables tables;
+		tables.add(1, 1, 0);
+		tables.add(1, 2, 1);
+		tables.add(2, 1, 0);
+		tables.add(2, 3, 1);
+		tables.add(2, 2, 2);
+		tables.add(2, 1, 3);
+		tables.add(3, 5, 0);
+		// key 3 matches a tuple of node 2 that is removed first
+		tables.add(4, 3, 0);
+		tables.add(4, 1, 1);
+
+		Projection projection;
+		SemiJoinReducer reducer(projection, GetParam());
+		EXPECT_EQ(3u, reducer.reduce(*td, tables));
+
+		EXPECT_EQ(vector<uint64_t>({ 0, 1 }), tables.ids(1));
+		EXPECT_EQ(vector<uint64_t>({ 0, 2, 3 }), tables.ids(2));
+		EXPECT_EQ(vector<uint64_t>(), tables.ids(3));
+		EXPECT_EQ(vector<uint64_t>({ 1 }), tables.ids(4));
+
+		// nothing left to remove
+		EXPECT_EQ(0u, reducer.reduce(*td, tables));
+	}
+
+	TEST_P(SemiJoinReduction, SkipsErasedTupleSets)
+	{
+		std::unique_ptr<htd::ITreeDecomposition> td = decomposition();
+		Tables tables;
+		// node 2 is gone, so node 4 has nothing to match against
+		tables.add(1, 1, 0);
+		tables.add(3, 1, 0);
+		tables.add(3, 2, 1);
+		tables.add(4, 7, 0);
+
+		Projection projection;
+		SemiJoinReducer reducer(projection, GetParam());
+		EXPECT_EQ(1u, reducer.reduce(*td, tables));
+		EXPECT_EQ(vector<uint64_t>({ 0 }), tables.ids(3));
+		EXPECT_EQ(vector<uint64_t>({ 0 }), tables.ids(4));
+	}
+
+	TEST_P(SemiJoinReduction, RemapsTheLinksOfTheParent)
+	{
+		std::unique_ptr<htd::ITreeDecomposition> td = decomposition();
+		Tables tables;
+		tables.add(1, 1, 0);
+		TupleSet &root = tables.add(1, 2, 1);
+		tables.add(2, 1, 0);
+		tables.add(2, 3, 1);
+		tables.add(2, 2, 2);
+		TupleSet &a = tables.add(2, 1, 3);
+		tables.add(3, 5, 0);
+		tables.add(4, 3, 0);
+		tables.add(4, 1, 1);
+
+		// root tuples link into node 2 and 3, the last tuple of node 2
+		// into node 4
+		root.setOrigin(0, 0, 3);
+		root.setOrigin(1, 0, 2);
+		root.setOrigin(0, 1, 0);
+		a.setOrigin(3, 0, 1);
+
+		Projection projection;
+		SemiJoinReducer reducer(projection, GetParam());
+		EXPECT_EQ(3u, reducer.reduce(*td, tables));
+
+		EXPECT_EQ(2u, root.origin(0, 0));
+		EXPECT_EQ(1u, root.origin(1, 0));
+		EXPECT_EQ(ITupleSet::NO_ORIGIN, root.origin(0, 1));
+		ASSERT_EQ(3u, a.size());
+		EXPECT_EQ(0u, a.origin(2, 0));
+		EXPECT_EQ(ITupleSet::NO_ORIGIN, a.origin(0, 0));
+	}
+
+	INSTANTIATE_TEST_CASE_P(Threads, SemiJoinReduction,
+			::testing::Values(1u, 4u));
+
+	TEST(SemiJoinSubtrees, AreReducedWithoutWaitingForEachOther)
+	{
+		std::unique_ptr<htd::ITreeDecomposition> td = decomposition();
+		Tables tables;
+		for(htd::vertex_t node = 1; node <= 4; ++node)
+			tables.add(node, 1, 0);
+
+		// the edge into 4 follows the one into 2, not the one into 3
+		MeetingProjection projection;
+		SemiJoinReducer reducer(projection, 2);
+		EXPECT_EQ(0u, reducer.reduce(*td, tables));
+		EXPECT_TRUE(projection.met);
+	}
+
+} // namespace
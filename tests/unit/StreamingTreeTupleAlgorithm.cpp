@@ -0,0 +1,228 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sharp/create.hpp>
+#include <sharp/BitTuple.hpp>
+
+#include "TupleSet.hpp"
+#include "mocks/MockInstance.hpp"
+
+#include <htd/main.hpp>
+
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+	using namespace sharp;
+	using sharp::test::MockInstance;
+
+	using std::size_t;
+	using std::uint64_t;
+	using std::vector;
+
+	uint64_t bitsOf(const ITuple &tuple)
+	{
+		return static_cast<const BitTuple &>(tuple).bits();
+	}
+
+	// tuple sets of the children, by node
+	class Tables : public INodeTupleSetMap
+	{
+	public:
+		virtual ITupleSet &operator[](htd::vertex_t node) override
+		{
+			return *tables_.at(node);
+		}
+
+		virtual ITupleSet &at(htd::vertex_t node) override
+		{
+			return *tables_.at(node);
+		}
+
+		virtual const ITupleSet &operator[](htd::vertex_t node) const override
+		{
+			return *tables_.at(node);
+		}
+
+		virtual const ITupleSet &at(htd::vertex_t node) const override
+		{
+			return *tables_.at(node);
+		}
+
+		virtual bool contains(htd::vertex_t node) const override
+		{
+			return tables_.count(node) != 0;
+		}
+
+		virtual void clear() override { tables_.clear(); }
+
+	private:
+		std::map<htd::vertex_t, ITupleSet *> tables_;
+	};
+
+	// emits the tuples 0, ..., count - 1 and checks that its output cannot
+	// be read back
+	class Emitter : public ITreeTupleAlgorithm
+	{
+	public:
+		Emitter(uint64_t count) : count_(count) { }
+
+		virtual vector<const htd::ILabelingFunction *>
+			preprocessOperations() const override
+		{
+			return vector<const htd::ILabelingFunction *>();
+		}
+
+		virtual void evaluateNode(
+				htd::vertex_t,
+				const htd::ITreeDecomposition &,
+				INodeTupleSetMap &,
+				const IInstance &,
+				ITupleSet &outputTuples) const override
+		{
+			for(uint64_t i = 0; i < count_; ++i)
+			{
+				outputTuples.insert(new BitTuple(i));
+				EXPECT_EQ(i + 1, outputTuples.size());
+			}
+
+			BitTuple tuple(0);
+			EXPECT_THROW(outputTuples.contains(tuple), std::logic_error);
+			EXPECT_THROW(outputTuples.find(tuple), std::logic_error);
+			EXPECT_THROW(outputTuples.enumerate(), std::logic_error);
+			EXPECT_THROW(outputTuples[0], std::logic_error);
+			EXPECT_THROW(outputTuples.erase(0), std::logic_error);
+			EXPECT_THROW(outputTuples.insert(nullptr), std::invalid_argument);
+		}
+
+		virtual bool needAllTupleSets() const override { return false; }
+
+	private:
+		uint64_t count_;
+	};
+
+	// keeps the even tuples, then appends their number once the node is
+	// finished
+	class EvenFilter : public ITreeTupleStreamAlgorithm
+	{
+	public:
+		EvenFilter(bool needAllTupleSets)
+			: deleted(0), finished(0), needAllTupleSets_(needAllTupleSets)
+		{ }
+
+		virtual void evaluateTuple(
+				htd::vertex_t,
+				const htd::ITreeDecomposition &,
+				INodeTupleSetMap &,
+				const IInstance &,
+				ITuple *tuple,
+				ITupleSet &outputTuples) const override
+		{
+			// nothing is emitted after the node is finished
+			EXPECT_EQ(0u, finished);
+			if(bitsOf(*tuple) % 2 == 0)
+				outputTuples.insert(tuple);
+			else
+			{
+				delete tuple;
+				++deleted;
+			}
+		}
+
+		virtual void finishNode(
+				htd::vertex_t,
+				const htd::ITreeDecomposition &,
+				INodeTupleSetMap &,
+				const IInstance &,
+				ITupleSet &outputTuples) const override
+		{
+			++finished;
+			outputTuples.insert(new BitTuple(1000 + outputTuples.size()));
+		}
+
+		virtual bool needAllTupleSets() const override
+		{
+			return needAllTupleSets_;
+		}
+
+		mutable size_t deleted;
+		mutable size_t finished;
+
+	private:
+		bool needAllTupleSets_;
+	};
+
+	vector<uint64_t> bitsOf(const ITupleSet &tuples)
+	{
+		vector<uint64_t> bits;
+		tuples.forEach([&](const ITuple &tuple)
+		{
+			bits.push_back(bitsOf(tuple));
+		});
+		return bits;
+	}
+
+	TEST(StreamingTreeTupleAlgorithm, PassesEveryTupleToTheStreamAlgorithm)
+	{
+		std::unique_ptr<htd::IMutableTreeDecomposition> td(
+				htd::TreeDecompositionFactory::instance()
+					.getTreeDecomposition());
+		htd::vertex_t root = td->insertRoot();
+
+		Emitter emitter(7);
+		EvenFilter filter(false);
+		std::unique_ptr<ITreeTupleAlgorithm> algorithm(
+				create::treeTupleAlgorithm(emitter, filter));
+
+		Tables tables;
+		MockInstance instance;
+		TupleSet output;
+		algorithm->evaluateNode(root, *td, tables, instance, output);
+
+		EXPECT_EQ(vector<uint64_t>({ 0, 2, 4, 6, 1004 }), bitsOf(output));
+		EXPECT_EQ(3u, filter.deleted);
+		EXPECT_EQ(1u, filter.finished);
+	}
+
+	TEST(StreamingTreeTupleAlgorithm, FinishesNodesWithoutTuples)
+	{
+		std::unique_ptr<htd::IMutableTreeDecomposition> td(
+				htd::TreeDecompositionFactory::instance()
+					.getTreeDecomposition());
+		htd::vertex_t root = td->insertRoot();
+
+		Emitter emitter(0);
+		EvenFilter filter(false);
+		std::unique_ptr<ITreeTupleAlgorithm> algorithm(
+				create::treeTupleAlgorithm(emitter, filter));
+
+		Tables tables;
+		MockInstance instance;
+		TupleSet output;
+		algorithm->evaluateNode(root, *td, tables, instance, output);
+
+		EXPECT_EQ(vector<uint64_t>({ 1000 }), bitsOf(output));
+		EXPECT_EQ(1u, filter.finished);
+	}
+
+	TEST(StreamingTreeTupleAlgorithm, NeedsAllTupleSetsIfAStageDoes)
+	{
+		Emitter emitter(1);
+		EvenFilter keeping(true), dropping(false);
+		std::unique_ptr<ITreeTupleAlgorithm> a(
+				create::treeTupleAlgorithm(emitter, keeping));
+		std::unique_ptr<ITreeTupleAlgorithm> b(
+				create::treeTupleAlgorithm(emitter, dropping));
+		EXPECT_TRUE(a->needAllTupleSets());
+		EXPECT_FALSE(b->needAllTupleSets());
+	}
+
+} // namespace
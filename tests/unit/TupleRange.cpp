@@ -0,0 +1,148 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sharp/TupleRange.hpp>
+#include <sharp/BitTuple.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include <cstddef>
+
+namespace
+{
+	using sharp::TupleRange;
+	using sharp::BitTuple;
+	using sharp::ITuple;
+
+	using std::size_t;
+	using std::vector;
+
+	// tuples whose bits are their position
+	class Tuples
+	{
+	public:
+		Tuples(size_t size)
+		{
+			for(size_t i = 0; i < size; ++i)
+			{
+				tuples_.emplace_back(new BitTuple(i));
+				pointers_.push_back(tuples_.back().get());
+			}
+		}
+
+		TupleRange range() const
+		{
+			return TupleRange(pointers_.data(), pointers_.size());
+		}
+
+	private:
+		vector<std::unique_ptr<BitTuple> > tuples_;
+		vector<const ITuple *> pointers_;
+	};
+
+	size_t positionOf(const ITuple &tuple)
+	{
+		return static_cast<const BitTuple &>(tuple).bits();
+	}
+
+	TEST(TupleRange, TakesSubranges)
+	{
+		Tuples tuples(10);
+		TupleRange sub = tuples.range().subrange(3, 7);
+		ASSERT_EQ(4u, sub.size());
+		EXPECT_EQ(3u, positionOf(sub[0]));
+		EXPECT_EQ(6u, positionOf(sub[3]));
+		EXPECT_EQ(4, sub.end() - sub.begin());
+
+		EXPECT_TRUE(tuples.range().subrange(10, 10).empty());
+		EXPECT_THROW(tuples.range().subrange(4, 3), std::out_of_range);
+		EXPECT_THROW(tuples.range().subrange(0, 11), std::out_of_range);
+	}
+
+	TEST(TupleRange, SplitsIntoBalancedDisjointParts)
+	{
+		Tuples tuples(10);
+		vector<TupleRange> parts = tuples.range().split(4);
+		ASSERT_EQ(4u, parts.size());
+
+		vector<size_t> sizes;
+		size_t next = 0;
+		for(const TupleRange &part : parts)
+		{
+			sizes.push_back(part.size());
+			for(const ITuple *tuple : part)
+				EXPECT_EQ(next++, positionOf(*tuple));
+		}
+		EXPECT_EQ(vector<size_t>({ 3, 3, 2, 2 }), sizes);
+		EXPECT_EQ(10u, next);
+	}
+
+	TEST(TupleRange, SplitsIntoNoMorePartsThanTuples)
+	{
+		Tuples tuples(3);
+		vector<TupleRange> parts = tuples.range().split(8);
+		ASSERT_EQ(3u, parts.size());
+		for(const TupleRange &part : parts)
+			EXPECT_EQ(1u, part.size());
+
+		EXPECT_TRUE(TupleRange().split(4).empty());
+		EXPECT_THROW(tuples.range().split(0), std::invalid_argument);
+	}
+
+	TEST(TupleRange, KeepsGatheredStorageAlive)
+	{
+		Tuples tuples(5);
+		TupleRange sub;
+		{
+			std::shared_ptr<TupleRange::Storage> storage =
+				std::make_shared<TupleRange::Storage>(
+						tuples.range().begin(), tuples.range().end());
+			sub = TupleRange(
+					std::shared_ptr<const TupleRange::Storage>(storage))
+				.subrange(1, 4);
+		}
+		ASSERT_EQ(3u, sub.size());
+		EXPECT_EQ(1u, positionOf(sub[0]));
+		EXPECT_EQ(3u, positionOf(sub[2]));
+	}
+
+	TEST(TupleRange, VisitsEveryTupleOnceInParallel)
+	{
+		Tuples tuples(1000);
+		for(unsigned int threadCount : { 0u, 1u, 3u, 8u })
+		{
+			std::mutex lock;
+			vector<size_t> visited;
+			tuples.range().parallelForEach([&](const TupleRange &part)
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				for(const ITuple *tuple : part)
+					visited.push_back(positionOf(*tuple));
+			}, threadCount);
+
+			std::sort(visited.begin(), visited.end());
+			ASSERT_EQ(1000u, visited.size());
+			for(size_t i = 0; i < visited.size(); ++i)
+				ASSERT_EQ(i, visited[i]);
+		}
+	}
+
+	TEST(TupleRange, RethrowsExceptionsFromParallelParts)
+	{
+		Tuples tuples(100);
+		EXPECT_THROW(
+				tuples.range().parallelForEach([](const TupleRange &part)
+				{
+					if(positionOf(part[0]) != 0)
+						throw std::runtime_error("failed");
+				}, 4),
+				std::runtime_error);
+	}
+
+} // namespace
@@ -0,0 +1,142 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sharp/BitTuple.hpp>
+
+#include "TupleSet.hpp"
+
+#include <stdexcept>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+	using sharp::BitTuple;
+	using sharp::ITuple;
+	using sharp::ITupleSet;
+	using sharp::TupleSet;
+
+	using std::size_t;
+	using std::uint64_t;
+	using std::vector;
+
+	uint64_t bitsOf(const ITuple &tuple)
+	{
+		return static_cast<const BitTuple &>(tuple).bits();
+	}
+
+	void fill(TupleSet &set, size_t size)
+	{
+		for(size_t i = 0; i < size; ++i)
+			set.insert(new BitTuple(i * 7 + 3));
+	}
+
+	vector<uint64_t> enumerated(const ITupleSet &set)
+	{
+		vector<uint64_t> bits;
+		for(const ITuple &tuple : set)
+			bits.push_back(bitsOf(tuple));
+		return bits;
+	}
+
+	TEST(TupleSetIteration, ExposesContiguousStorage)
+	{
+		TupleSet set;
+		fill(set, 10);
+		const TupleSet &constSet = set;
+
+		ASSERT_TRUE(set.data() != nullptr);
+		ASSERT_TRUE(constSet.data() != nullptr);
+		for(size_t i = 0; i < set.size(); ++i)
+		{
+			EXPECT_EQ(set[i], set.data()[i]);
+			EXPECT_EQ(set[i], constSet.data()[i]);
+		}
+	}
+
+	TEST(TupleSetIteration, VisitsTuplesInEnumerationOrder)
+	{
+		TupleSet set;
+		fill(set, 100);
+
+		vector<uint64_t> visited;
+		set.forEach([&](ITuple &tuple) { visited.push_back(bitsOf(tuple)); });
+		EXPECT_EQ(enumerated(set), visited);
+
+		const ITupleSet &constSet = set;
+		visited.clear();
+		constSet.forEach([&](const ITuple &tuple)
+		{
+			visited.push_back(bitsOf(tuple));
+		});
+		EXPECT_EQ(enumerated(set), visited);
+	}
+
+	TEST(TupleSetIteration, VisitsNothingInAnEmptySet)
+	{
+		TupleSet set;
+		size_t visited = 0;
+		set.forEach([&](const ITuple &) { ++visited; });
+		EXPECT_EQ(0u, visited);
+	}
+
+	TEST(TupleSetIteration, VisitsChunksInPlace)
+	{
+		TupleSet set;
+		fill(set, 1100);
+		const ITupleSet &constSet = set;
+
+		vector<size_t> sizes;
+		vector<uint64_t> visited;
+		constSet.forEachChunk([&](const ITuple * const *tuples, size_t count)
+		{
+			// contiguous storage is handed out without copying
+			EXPECT_EQ(constSet.data() + visited.size(), tuples);
+			sizes.push_back(count);
+			for(size_t i = 0; i < count; ++i)
+				visited.push_back(bitsOf(*tuples[i]));
+		});
+		EXPECT_EQ(vector<size_t>({ 512, 512, 76 }), sizes);
+		EXPECT_EQ(enumerated(set), visited);
+	}
+
+	TEST(TupleSetIteration, VisitsChunksOfTheGivenSize)
+	{
+		TupleSet set;
+		fill(set, 9);
+
+		vector<size_t> sizes;
+		vector<uint64_t> visited;
+		set.forEachChunk([&](ITuple * const *tuples, size_t count)
+		{
+			sizes.push_back(count);
+			for(size_t i = 0; i < count; ++i)
+				visited.push_back(bitsOf(*tuples[i]));
+		}, 3);
+		EXPECT_EQ(vector<size_t>({ 3, 3, 3 }), sizes);
+		EXPECT_EQ(enumerated(set), visited);
+
+		TupleSet empty;
+		size_t chunks = 0;
+		empty.forEachChunk([&](ITuple * const *, size_t) { ++chunks; });
+		EXPECT_EQ(0u, chunks);
+	}
+
+	TEST(TupleSetIteration, RejectsAChunkSizeOfZero)
+	{
+		TupleSet set;
+		fill(set, 3);
+		const ITupleSet &constSet = set;
+		EXPECT_THROW(set.forEachChunk([](ITuple * const *, size_t) { }, 0),
+				std::invalid_argument);
+		EXPECT_THROW(
+				constSet.forEachChunk(
+					[](const ITuple * const *, size_t) { }, 0),
+				std::invalid_argument);
+	}
+
+} // namespace
@@ -0,0 +1,127 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sharp/BitTuple.hpp>
+
+#include "TupleSet.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+	using sharp::BitTuple;
+	using sharp::ITuple;
+	using sharp::ITupleSet;
+	using sharp::TupleSet;
+
+	using std::size_t;
+	using std::uint32_t;
+	using std::vector;
+
+	void fill(TupleSet &set, size_t size)
+	{
+		for(size_t i = 0; i < size; ++i)
+			set.insert(new BitTuple(i));
+	}
+
+	// the links of all tuples into the child at childPosition
+	vector<uint32_t> origins(const ITupleSet &set, size_t childPosition)
+	{
+		vector<uint32_t> origins;
+		for(size_t pos = 0; pos < set.size(); ++pos)
+			origins.push_back(set.origin(pos, childPosition));
+		return origins;
+	}
+
+	TEST(TupleSetOrigins, SetsLinksPerChild)
+	{
+		TupleSet set;
+		fill(set, 4);
+		EXPECT_FALSE(set.hasOrigins());
+		EXPECT_EQ(vector<uint32_t>(4, ITupleSet::NO_ORIGIN), origins(set, 0));
+
+		set.setOrigin(1, 0, 7);
+		set.setOrigin(2, 2, 9);
+		EXPECT_TRUE(set.hasOrigins());
+		EXPECT_EQ(vector<uint32_t>({
+					ITupleSet::NO_ORIGIN, 7,
+					ITupleSet::NO_ORIGIN, ITupleSet::NO_ORIGIN }),
+				origins(set, 0));
+		EXPECT_EQ(vector<uint32_t>(4, ITupleSet::NO_ORIGIN), origins(set, 1));
+		EXPECT_EQ(vector<uint32_t>({
+					ITupleSet::NO_ORIGIN, ITupleSet::NO_ORIGIN,
+					9, ITupleSet::NO_ORIGIN }),
+				origins(set, 2));
+
+		EXPECT_THROW(set.setOrigin(4, 0, 1), std::out_of_range);
+	}
+
+	TEST(TupleSetOrigins, KeepsLinksWithRetainedTuples)
+	{
+		TupleSet set;
+		fill(set, 5);
+		for(size_t pos = 0; pos < 5; ++pos)
+			set.setOrigin(pos, 0, uint32_t(10 + pos));
+		set.setOrigin(1, 1, 21);
+
+		set.retain({ true, false, true, false, true });
+		ASSERT_EQ(3u, set.size());
+		EXPECT_EQ(vector<uint32_t>({ 10, 12, 14 }), origins(set, 0));
+		EXPECT_EQ(vector<uint32_t>(3, ITupleSet::NO_ORIGIN), origins(set, 1));
+
+		EXPECT_THROW(set.retain({ true }), std::invalid_argument);
+	}
+
+	TEST(TupleSetOrigins, KeepsLinksWithErasedTuples)
+	{
+		TupleSet set;
+		fill(set, 4);
+		for(size_t pos = 0; pos < 4; ++pos)
+			set.setOrigin(pos, 0, uint32_t(10 + pos));
+
+		// erasing a position shifts the later tuples down
+		std::unique_ptr<ITuple> erased(set[1]);
+		set.erase(1);
+		EXPECT_EQ(vector<uint32_t>({ 10, 12, 13 }), origins(set, 0));
+
+		// erasing a tuple moves the last one into its place
+		erased.reset(set[0]);
+		EXPECT_EQ(1u, set.erase(*erased));
+		EXPECT_EQ(vector<uint32_t>({ 13, 12 }), origins(set, 0));
+	}
+
+	TEST(TupleSetOrigins, RemapsLinksAfterTheChildIsCompacted)
+	{
+		vector<bool> keep = { false, true, true, false, true };
+		EXPECT_EQ(vector<uint32_t>({
+					ITupleSet::NO_ORIGIN, 0, 1, ITupleSet::NO_ORIGIN, 2 }),
+				ITupleSet::retainedPositions(keep));
+
+		TupleSet set;
+		fill(set, 5);
+		for(size_t pos = 0; pos < 4; ++pos)
+			set.setOrigin(pos, 0, uint32_t(4 - pos));
+		set.setOrigin(0, 1, 3);
+
+		set.remapOrigins(0, ITupleSet::retainedPositions(keep));
+		EXPECT_EQ(vector<uint32_t>({
+					2, ITupleSet::NO_ORIGIN, 1, 0, ITupleSet::NO_ORIGIN }),
+				origins(set, 0));
+		// links into other children are left alone
+		EXPECT_EQ(3u, set.origin(0, 1));
+
+		// links past the compacted child are dropped
+		set.remapOrigins(1, { 0 });
+		EXPECT_EQ(ITupleSet::NO_ORIGIN, set.origin(0, 1));
+		// remapping a child without links does nothing
+		set.remapOrigins(5, { 0 });
+	}
+
+} // namespace
@@ -0,0 +1,154 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sharp/create.hpp>
+#include <sharp/BitTuple.hpp>
+
+#include "TupleSet.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+	using sharp::BitTuple;
+	using sharp::ITuple;
+	using sharp::ITupleSet;
+	using sharp::TupleSet;
+
+	using std::size_t;
+	using std::uint64_t;
+	using std::vector;
+
+	uint64_t bitsOf(const ITuple &tuple)
+	{
+		return static_cast<const BitTuple &>(tuple).bits();
+	}
+
+	TupleSet *set(const vector<uint64_t> &bits)
+	{
+		TupleSet *set = new TupleSet();
+		for(uint64_t b : bits)
+			set->insert(new BitTuple(b));
+		return set;
+	}
+
+	// 1 2 3 | (empty) | 4 5 | 6
+	std::unique_ptr<ITupleSet> tupleSetUnion()
+	{
+		return std::unique_ptr<ITupleSet>(sharp::create::tupleSetUnion({
+					set({ 1, 2, 3 }), set({ }), set({ 4, 5 }), set({ 6 }) }));
+	}
+
+	vector<uint64_t> enumerated(ITupleSet::iterator begin,
+			ITupleSet::iterator end)
+	{
+		vector<uint64_t> bits;
+		for(; begin != end; ++begin)
+			bits.push_back(bitsOf(*begin));
+		return bits;
+	}
+
+	vector<uint64_t> enumerated(ITupleSet::const_iterator begin,
+			ITupleSet::const_iterator end)
+	{
+		vector<uint64_t> bits;
+		for(; begin != end; ++begin)
+			bits.push_back(bitsOf(*begin));
+		return bits;
+	}
+
+	const vector<uint64_t> ALL = { 1, 2, 3, 4, 5, 6 };
+
+	TEST(TupleSetUnion, EnumeratesAllSetsInOrder)
+	{
+		std::unique_ptr<ITupleSet> tuples = tupleSetUnion();
+		const ITupleSet &constTuples = *tuples;
+
+		EXPECT_EQ(6u, tuples->size());
+		EXPECT_EQ(ALL, enumerated(tuples->begin(), tuples->end()));
+		EXPECT_EQ(ALL, enumerated(constTuples.begin(), constTuples.end()));
+		for(size_t i = 0; i < ALL.size(); ++i)
+			EXPECT_EQ(ALL[i], bitsOf(*(*tuples)[static_cast<int>(i)]));
+		EXPECT_THROW((*tuples)[6], std::out_of_range);
+	}
+
+	TEST(TupleSetUnion, EnumeratesNoSets)
+	{
+		std::unique_ptr<ITupleSet> tuples(sharp::create::tupleSetUnion({ }));
+		EXPECT_EQ(0u, tuples->size());
+		EXPECT_TRUE(tuples->begin() == tuples->end());
+	}
+
+	TEST(TupleSetUnion, FindsTuplesInEverySet)
+	{
+		std::unique_ptr<ITupleSet> tuples = tupleSetUnion();
+		const ITupleSet &constTuples = *tuples;
+
+		// tuple sets find the tuples they hold, not equal ones
+		for(size_t i = 0; i < ALL.size(); ++i)
+		{
+			const ITuple &tuple = *(*tuples)[static_cast<int>(i)];
+			EXPECT_TRUE(tuples->contains(tuple));
+
+			// continues with the remaining tuples after the one found
+			vector<uint64_t> rest(ALL.begin() + i, ALL.end());
+			EXPECT_EQ(rest, enumerated(tuples->find(tuple), tuples->end()));
+			EXPECT_EQ(rest, enumerated(
+						constTuples.find(tuple), constTuples.end()));
+		}
+
+		BitTuple missing(1);
+		EXPECT_FALSE(tuples->contains(missing));
+		EXPECT_TRUE(tuples->find(missing) == tuples->end());
+		EXPECT_TRUE(constTuples.find(missing) == constTuples.end());
+	}
+
+	TEST(TupleSetUnion, VisitsTuplesWithoutContiguousStorage)
+	{
+		std::unique_ptr<ITupleSet> tuples = tupleSetUnion();
+		const ITupleSet &constTuples = *tuples;
+		EXPECT_TRUE(constTuples.data() == nullptr);
+
+		vector<uint64_t> visited;
+		constTuples.forEach([&](const ITuple &tuple)
+		{
+			visited.push_back(bitsOf(tuple));
+		});
+		EXPECT_EQ(ALL, visited);
+
+		vector<size_t> sizes;
+		visited.clear();
+		constTuples.forEachChunk(
+				[&](const ITuple * const *chunk, size_t count)
+				{
+					sizes.push_back(count);
+					for(size_t i = 0; i < count; ++i)
+						visited.push_back(bitsOf(*chunk[i]));
+				}, 4);
+		EXPECT_EQ(vector<size_t>({ 4, 2 }), sizes);
+		EXPECT_EQ(ALL, visited);
+
+		visited.clear();
+		for(const ITuple *tuple : constTuples.range())
+			visited.push_back(bitsOf(*tuple));
+		EXPECT_EQ(ALL, visited);
+	}
+
+	TEST(TupleSetUnion, IsReadOnly)
+	{
+		std::unique_ptr<ITupleSet> tuples = tupleSetUnion();
+		std::unique_ptr<BitTuple> tuple(new BitTuple(7));
+		EXPECT_THROW(tuples->insert(tuple.get()), std::logic_error);
+		EXPECT_THROW(tuples->erase(*(*tuples)[0]), std::logic_error);
+		EXPECT_THROW(tuples->erase(0), std::logic_error);
+		EXPECT_EQ(ALL.size(), tuples->size());
+	}
+
+} // namespace
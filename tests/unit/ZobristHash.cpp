@@ -0,0 +1,121 @@
+#ifdef HAVE_CONFIG_H
+	#include <config.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <sharp/ZobristHash.hpp>
+#include <sharp/CachedHashTuple.hpp>
+
+#include <map>
+#include <cstddef>
+
+namespace
+{
+	using sharp::ZobristHash;
+	using sharp::CachedHashTuple;
+	using sharp::ITuple;
+
+	using std::size_t;
+
+	typedef std::map<htd::vertex_t, size_t> Assignment;
+
+	size_t hashOf(const Assignment &assignment)
+	{
+		ZobristHash hash;
+		for(const auto &entry : assignment)
+			hash.add(entry.first, entry.second);
+		return hash.get();
+	}
+
+	// assignment tuple that derives its hash from its child's
+	class AssignmentTuple : public CachedHashTuple
+	{
+	public:
+		AssignmentTuple(const Assignment &assignment)
+			: CachedHashTuple(hashOf(assignment)), assignment_(assignment)
+		{ }
+
+		AssignmentTuple(const AssignmentTuple &child,
+				htd::vertex_t introduced, size_t value)
+			: CachedHashTuple(), assignment_(child.assignment_)
+		{
+			ZobristHash hash(child.hash());
+			hash.add(introduced, value);
+			assignment_[introduced] = value;
+			setHash(hash.get());
+		}
+
+		virtual bool operator==(const ITuple &other) const override
+		{
+			return assignment_
+				== static_cast<const AssignmentTuple &>(other).assignment_;
+		}
+
+	private:
+		Assignment assignment_;
+	};
+
+	TEST(ZobristHash, IgnoresTheOrderOfAssignments)
+	{
+		ZobristHash a, b;
+		a.add(1, 0);
+		a.add(2, 1);
+		a.add(7, 3);
+		b.add(7, 3);
+		b.add(1, 0);
+		b.add(2, 1);
+		EXPECT_EQ(a.get(), b.get());
+		EXPECT_EQ(hashOf({ { 1, 0 }, { 2, 1 }, { 7, 3 } }), a.get());
+	}
+
+	TEST(ZobristHash, UpdatesIncrementally)
+	{
+		ZobristHash hash(hashOf({ { 1, 0 }, { 2, 1 } }));
+
+		// introduce
+		hash.add(3, 1);
+		EXPECT_EQ(hashOf({ { 1, 0 }, { 2, 1 }, { 3, 1 } }), hash.get());
+
+		// forget
+		hash.remove(1, 0);
+		EXPECT_EQ(hashOf({ { 2, 1 }, { 3, 1 } }), hash.get());
+
+		// change a value
+		hash.replace(2, 1, 5);
+		EXPECT_EQ(hashOf({ { 2, 5 }, { 3, 1 } }), hash.get());
+
+		hash.remove(2, 5);
+		hash.remove(3, 1);
+		EXPECT_EQ(0u, hash.get());
+		EXPECT_EQ(ZobristHash().get(), hash.get());
+	}
+
+	TEST(ZobristHash, DistinguishesVerticesAndValues)
+	{
+		EXPECT_NE(ZobristHash::key(1, 2), ZobristHash::key(2, 1));
+		EXPECT_NE(ZobristHash::key(1, 0), ZobristHash::key(1, 1));
+		EXPECT_NE(ZobristHash::key(0, 0), 0u);
+		EXPECT_EQ(ZobristHash::key(4, 9), ZobristHash::key(4, 9));
+	}
+
+	TEST(ZobristHash, ResetsToTheEmptyAssignment)
+	{
+		ZobristHash hash;
+		hash.add(1, 1);
+		hash.reset();
+		EXPECT_EQ(0u, hash.get());
+	}
+
+	TEST(CachedHashTuple, DerivesTheHashFromTheChild)
+	{
+		AssignmentTuple child({ { 1, 0 }, { 2, 1 } });
+		AssignmentTuple parent(child, 3, 1);
+		AssignmentTuple direct({ { 1, 0 }, { 2, 1 }, { 3, 1 } });
+
+		EXPECT_TRUE(parent == direct);
+		EXPECT_EQ(direct.hash(), parent.hash());
+		EXPECT_NE(child.hash(), parent.hash());
+	}
+
+} // namespace